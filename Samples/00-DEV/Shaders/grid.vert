@@ -5,16 +5,20 @@
 *   2024/04/26
 */
 
-layout (location=0) out vec2 outUV; 
+#extension GL_EXT_nonuniform_qualifier : require
+
+//Bindless Storage Buffers, viewed as arrays of matrices. 
+layout(set = 0, binding = 1) readonly buffer MatrixBuffer{
+    mat4 matrices[];
+} storageBuffers[]; 
 
-layout(push_constant) uniform PushConstants
-{
-    mat4 w;
-} pushConstants; 
+layout(push_constant) uniform DrawConstants{
+    uint bufferIndex;
+    uint viewProjection;
+    uint world;
+} draw; 
 
-layout(binding = 0) uniform UniformBuffer{
-    mat4 vp;
-} ubo; 
+layout (location=0) out vec2 outUV; 
 
 float gridSize = 100000.0; 
 float gridCellSize = 0.025; 
@@ -36,6 +40,6 @@ const int gridIndices[6] = int[6](
 
 void main(){
     vec3 vertexPos = gridRect[gridIndices[gl_VertexIndex]] * gridSize; 
-    gl_Position = ubo.vp * vec4(vertexPos, 1.0); 
+    gl_Position = storageBuffers[draw.bufferIndex].matrices[draw.viewProjection] * vec4(vertexPos, 1.0); 
     outUV = vertexPos.xz; 
 }
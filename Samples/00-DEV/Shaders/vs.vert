@@ -2,21 +2,25 @@
 /**
 *   Object Transformation Vertex Shader
 *   Draws a mesh based on input Position and RGB Colour
-*   Transformed by push_constant World matrix, and a uniform
-*   buffer ViewProjection matrix. 
+*   Transformed by a per-object World matrix, and a per-frame
+*   ViewProjection matrix, both read from a bindless storage buffer. 
 *   ------------------
 *   Ewan Burnett (EwanBurnettSK@Outlook.com)
 *   2024/04/26
 */
 
-layout(push_constant) uniform PushConstants
-{
-    mat4 w;
-} pushConstants; 
+#extension GL_EXT_nonuniform_qualifier : require
 
-layout(binding = 0) uniform UniformBuffer{
-    mat4 vp;
-} ubo; 
+//Bindless Storage Buffers, viewed as arrays of matrices. 
+layout(set = 0, binding = 1) readonly buffer MatrixBuffer{
+    mat4 matrices[];
+} storageBuffers[]; 
+
+layout(push_constant) uniform DrawConstants{
+    uint bufferIndex;
+    uint viewProjection;
+    uint world;
+} draw; 
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inColour;
@@ -24,7 +28,9 @@ layout(location = 1) in vec3 inColour;
 layout(location = 0) out vec3 fragColour; 
 
 void main() {
-    mat4 wvp = ubo.vp * pushConstants.w;
+    mat4 vp = storageBuffers[draw.bufferIndex].matrices[draw.viewProjection];
+    mat4 w = storageBuffers[draw.bufferIndex].matrices[draw.world + gl_InstanceIndex];
+    mat4 wvp = vp * w;
     gl_Position = wvp * vec4(inPosition, 1.0);
     fragColour = inColour;
 }
\ No newline at end of file
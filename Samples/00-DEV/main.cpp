@@ -3,94 +3,122 @@
 #include <VKR/Timer.h>
 #include <VKR/Maths.h>
 #include <VKR/File.h>
+#include <VKR/Logger.h>
+#include <VKR/Jobs.h>
 #include <VKR/Vulkan/VkContext.h>
 #include <VKR/Vulkan/VkHelpers.h>
 #include <VKR/Vulkan/VkSwapchain.h>
 #include <VKR/Vulkan/VkInit.h>
 #include <VKR/Vulkan/VkImGui.h>
 #include <VKR/Vulkan/VkPipelineBuilder.h>
+#include <VKR/Vulkan/VkCommandRecorder.h>
+#include <VKR/Vulkan/VkFrameContext.h>
+#include <VKR/Vulkan/VkRingBuffer.h>
+#include <VKR/Vulkan/VkUploadManager.h>
+#include <VKR/Vulkan/VkAsyncCompute.h>
+#include <VKR/Vulkan/VkBindlessHeap.h>
+#include <VKR/Vulkan/VkLayoutCache.h>
+#include <VKR/Vulkan/VkPipelineCacheManager.h>
+#include <VKR/Vulkan/VkPipelineCompiler.h>
+#include <VKR/Vulkan/VkPipelineRegistry.h>
+#include <VKR/Vulkan/VkShaderReflection.h>
+#include <VKR/Vulkan/VkShaderHotReload.h>
+#include <VKR/Vulkan/VkRenderGraph.h>
+#include <VKR/Vulkan/VkDeletionQueue.h>
+#include <VKR/Vulkan/VkFramePacer.h>
 
 #include <vector> 
 #include <Thread>
 
 #include <cstdio> 
+#include <cstdlib>
+#include <cstring>
 #include <easy/profiler.h>
 
 constexpr uint32_t WINDOW_WIDTH = 1280;
 constexpr uint32_t WINDOW_HEIGHT = 720;
 
+//Present defaults, which trade latency against throughput. Each may be overridden per deployment by the environment, see LoadPresentConfig(). 
+constexpr VkPresentModeKHR PRESENT_MODE = VK_PRESENT_MODE_MAILBOX_KHR;
+constexpr uint32_t SWAPCHAIN_IMAGES = 0;    //0 requests one more than the surface's minimum. 
 constexpr uint32_t FRAMES_IN_FLIGHT = 3;
+constexpr double MAX_FRAME_RATE = 0.0;      //0 is unlimited. 
 
 constexpr uint32_t OBJECT_COUNT = 100;
 
 constexpr VkSampleCountFlagBits MSAA_SAMPLES = VK_SAMPLE_COUNT_4_BIT;
 
-void InitVulkan(VKR::VkContext& context, VKR::VkSwapchain& swapchain, VKR::Window& window, uint32_t& queueFamilyIndex, VkQueue& queue);
+VKR::VkPresentConfig LoadPresentConfig(double* pMaxFrameRate);
+void InitVulkan(VKR::VkContext& context, VKR::VkSwapchain& swapchain, VKR::Window& window, const VKR::VkPresentConfig& presentConfig, const bool headless);
 void ShutdownVulkan(VKR::VkContext& context, VKR::VkSwapchain& swapchain);
 
 int main() {
 
-    VKR::Init();
+    //Headless runs render offscreen, without a display, e.g. on CI with a software driver such as lavapipe. 
+    //VKR_FRAME_COUNT exits after that many frames, and VKR_CAPTURE_PATH then writes the last one to a PNG. 
+    const char* headlessEnv = std::getenv("VKR_HEADLESS");
+    const bool headless = headlessEnv && strcmp(headlessEnv, "0") != 0;
+    const char* frameCountEnv = std::getenv("VKR_FRAME_COUNT");
+    const uint64_t frameCount = frameCountEnv ? std::strtoull(frameCountEnv, nullptr, 10) : 0;
+    const char* capturePath = std::getenv("VKR_CAPTURE_PATH");
+    if (capturePath && (!headless || frameCount == 0)) {
+        VKR::Log::Warning("VKR_CAPTURE_PATH requires VKR_HEADLESS and VKR_FRAME_COUNT, ignoring.\n");
+        capturePath = nullptr;
+    }
+
+    VKR::Init(headless);
     EASY_BLOCK("App Initialization");
 
     VKR::VkContext context;
     VKR::VkSwapchain swapchain;
-    VkQueue graphicsQueue;  //TODO: Queue Wrapper
-    uint32_t graphicsQueueIndex;
 
     VKR::Window window;
-    window.Create("Vulkan Renderer", WINDOW_WIDTH, WINDOW_HEIGHT);
+    window.Create("Vulkan Renderer", WINDOW_WIDTH, WINDOW_HEIGHT, true);
     window.Show();
 
-    InitVulkan(context, swapchain, window, graphicsQueueIndex, graphicsQueue);
-
-
-    VkSemaphore s_ImageAvailable[FRAMES_IN_FLIGHT];
-    VkSemaphore s_FrameFinished[FRAMES_IN_FLIGHT];
-    VkFence f_FrameReady[FRAMES_IN_FLIGHT];
-
-    for (int i = 0; i < FRAMES_IN_FLIGHT; i++) {
-        context.CreateSemaphore(&s_ImageAvailable[i]);
-        context.CreateSemaphore(&s_FrameFinished[i]);
-        context.CreateFence(&f_FrameReady[i]);
-    }
-
-    VkCommandPool commandPool;
-    context.CreateCommandPool(graphicsQueueIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, &commandPool);
-
-    VkDescriptorPool descriptorPool;
-    const std::vector<VkDescriptorPoolSize> descriptorPoolSizes = {
-        {
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            swapchain.GetImageCount() * 1
-        }
-    };
-    context.CreateDescriptorPool(swapchain.GetImageCount(), 0, descriptorPoolSizes.size(), descriptorPoolSizes.data(), &descriptorPool);
-
-    VkDescriptorSetLayout descriptorSetLayout;
-    const std::vector<VkDescriptorSetLayoutBinding> descriptorSetLayoutBindings = {
-        {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT}
+    double maxFrameRate = MAX_FRAME_RATE;
+    const VKR::VkPresentConfig presentConfig = LoadPresentConfig(&maxFrameRate);
+    InitVulkan(context, swapchain, window, presentConfig, headless);
+    const uint32_t framesInFlight = swapchain.GetFramesInFlight();
+
+    //Compute and Transfer Queues alias the Graphics Queue on devices without dedicated families. 
+    const VkQueue graphicsQueue = context.GetQueue(VKR::EQueueType::Graphics);
+    const uint32_t graphicsQueueIndex = context.GetQueueFamilyIndex(VKR::EQueueType::Graphics);
+    const VkQueue computeQueue = context.GetQueue(VKR::EQueueType::Compute);
+    const uint32_t computeQueueIndex = context.GetQueueFamilyIndex(VKR::EQueueType::Compute);
+    const VkQueue transferQueue = context.GetQueue(VKR::EQueueType::Transfer);
+    const uint32_t transferQueueIndex = context.GetQueueFamilyIndex(VKR::EQueueType::Transfer);
+
+    //Each frame in flight owns a Command Pool and swapchain Semaphores, which are recycled once the frame's timeline value is reached. 
+    VKR::VkFrameContext frameContext;
+    frameContext.Create(context, graphicsQueueIndex, framesInFlight);
+
+    //Static data is uploaded into device-local memory, on the dedicated Transfer Queue if there is one. 
+    VKR::VkUploadManager uploadManager;
+    uploadManager.Create(context, transferQueueIndex, transferQueue, graphicsQueueIndex);
+
+    //Compute work is submitted to the async Compute Queue, overlapping the frame's rasterization. 
+    VKR::VkAsyncCompute asyncCompute;
+    asyncCompute.Create(context, computeQueueIndex, computeQueue, graphicsQueueIndex, framesInFlight);
+
+    //Every resource lives in one global Descriptor Set, which is bound once per Command Buffer and indexed by handle in shaders. 
+    //Layouts are shared between every pipeline which describes them identically. 
+    VKR::VkLayoutCache layoutCache;
+
+    VKR::VkBindlessHeap bindlessHeap;
+    bindlessHeap.Create(context, 1024, 1024, 64, &layoutCache);
+
+    //Per-frame matrices are sub-allocated from a persistently mapped ring, and located by index through push constants. 
+    VKR::VkRingBuffer uniformRing;
+    uniformRing.Create(context, framesInFlight * (OBJECT_COUNT + 1) * 256, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, framesInFlight);
+    const uint32_t uniformRingHandle = bindlessHeap.RegisterStorageBuffer(context, uniformRing.GetBuffer());
+
+    //Mirrors the push constant block in vs.vert and grid.vert. 
+    struct DrawConstants {
+        uint32_t bufferIndex;       //Bindless Storage Buffer handle
+        uint32_t viewProjection;    //Matrix index of the View-Projection matrix
+        uint32_t world;             //Matrix index of the first World matrix, offset by gl_InstanceIndex
     };
-    context.CreateDescriptorSetLayout(descriptorSetLayoutBindings.size(), descriptorSetLayoutBindings.data(), &descriptorSetLayout);
-
-    VkDescriptorSet descriptorSet;
-    context.AllocateDescriptorSets(descriptorPool, 1, &descriptorSetLayout, &descriptorSet);
-
-    VkBuffer uniformBuffer;
-    VmaAllocation uniformBufferAlloc;
-    context.CreateBuffer(sizeof(VKR::Math::Matrix4x4<float>), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT, &uniformBufferAlloc, &uniformBuffer);
-
-    {
-        VkDescriptorBufferInfo bufferInfo = {
-            uniformBuffer,
-            0,
-            sizeof(VKR::Math::Matrix4x4<float>)
-        };
-
-        VkWriteDescriptorSet dsWrite = VKR::VkInit::MakeWriteDescriptorSet(descriptorSet, 0, 0, 1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, nullptr, &bufferInfo, nullptr);
-
-        vkUpdateDescriptorSets(context.GetDevice(), 1, &dsWrite, 0, nullptr);
-    }
 
     std::vector<float> vertices = {
         -1.0, -1.0, -1.0, 0.0, 0.0, 0.0,
@@ -125,171 +153,63 @@ int main() {
     };
     */
 
-    VkBuffer vertexBuffer;
-    VmaAllocation vertexBufferAlloc;
-    context.CreateBuffer(sizeof(float) * vertices.size(), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT, &vertexBufferAlloc, &vertexBuffer);
+    VKR::VkBufferResource vertexBuffer;
+    context.CreateBuffer(sizeof(float) * vertices.size(), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, 0, &vertexBuffer);
 
-    VkBuffer indexBuffer;
-    VmaAllocation indexBufferAlloc;
-    context.CreateBuffer(sizeof(uint32_t) * indices.size(), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT, &indexBufferAlloc, &indexBuffer);
+    VKR::VkBufferResource indexBuffer;
+    context.CreateBuffer(sizeof(uint32_t) * indices.size(), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, 0, &indexBuffer);
 
 
-    //Copy our Vertex and Index data into their buffers. 
+    //Upload our Vertex and Index data. The first frame waits on the batch's token, rather than the CPU. 
     {
-        void* pData = nullptr;
-        context.Map(vertexBufferAlloc, &pData);
-        memcpy(pData, vertices.data(), sizeof(float) * vertices.size());
-        context.Unmap(vertexBufferAlloc);
-
-        context.Map(indexBufferAlloc, &pData);
-        memcpy(pData, indices.data(), sizeof(uint32_t) * indices.size());
-        context.Unmap(indexBufferAlloc);
+        uploadManager.UploadBuffer(context, vertexBuffer.buffer, 0, vertices.data(), sizeof(float) * vertices.size(), VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+        uploadManager.UploadBuffer(context, indexBuffer.buffer, 0, indices.data(), sizeof(uint32_t) * indices.size(), VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT);
+        uploadManager.Submit(context);
     }
-    VkImage renderTargetImage;
-    VmaAllocation renderTargetImageAlloc;
-    VkImageView renderTargetView;
-    context.CreateImage(VK_IMAGE_TYPE_2D, { WINDOW_WIDTH, WINDOW_HEIGHT, 1 }, MSAA_SAMPLES, VK_FORMAT_B8G8R8A8_UNORM, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, 0, &renderTargetImageAlloc, &renderTargetImage);
-    context.CreateImageView(renderTargetImage, VK_FORMAT_B8G8R8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT, &renderTargetView);
-
-    VkImage depthImage;
-    VmaAllocation depthImageAlloc;
-    VkImageView depthView;
-
+    //The MSAA target and depth buffer are transients of the Render Graph, below. 
     const VkFormat depthFormat = VKR::VkHelpers::FindDepthFormat(context.GetPhysicalDevice());
-    context.CreateImage(VK_IMAGE_TYPE_2D, { WINDOW_WIDTH, WINDOW_HEIGHT, 1 }, MSAA_SAMPLES, depthFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, 0, &depthImageAlloc, &depthImage);
-    context.CreateImageView(depthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT, &depthView);
 
     //Pipeline Creation
-    VkPipelineCache pipelineCache;
-    VkPipelineCacheCreateInfo pipelineCacheCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };//TODO: VKINIT
-    if (VKR::IO::FileExists("PipelineCache.bin")) {
-        std::vector<char> pipelineCacheBlob;
-        VKR::IO::ReadFile("PipelineCache.bin", pipelineCacheBlob);
-        pipelineCacheCreateInfo.initialDataSize = pipelineCacheBlob.size();
-        pipelineCacheCreateInfo.pInitialData = pipelineCacheBlob.data();
-    }
+    //The cache is only loaded if it was written by this device and driver. 
+    VKR::VkPipelineCacheManager pipelineCacheManager;
+    pipelineCacheManager.Create(context);
+
+    //Graphics Pipelines compile on worker threads, and are drawn with once ready. 
+    VKR::VkPipelineCompiler pipelineCompiler;
+    pipelineCompiler.Create(context, pipelineCacheManager);
 
-    vkCreatePipelineCache(context.GetDevice(), &pipelineCacheCreateInfo, nullptr, &pipelineCache);
+    //Pipelines are requested by state, so identical permutations share a single Pipeline. 
+    VKR::VkPipelineRegistry pipelineRegistry;
+    pipelineRegistry.Create(context, pipelineCacheManager, &pipelineCompiler);
+
+    //Graphics shaders are recompiled when their sources change, and their Pipelines rebuilt between frames. 
+    VKR::VkShaderHotReload shaderHotReload;
+    shaderHotReload.Create(context, pipelineRegistry);
 
     VkPipeline computePipeline;
     VkPipelineLayout computePipelineLayout;
-    context.CreatePipelineLayout(0, nullptr, 0, nullptr, &computePipelineLayout);
-    VkComputePipelineCreateInfo computePipelineCreateInfo;
-
+    layoutCache.GetPipelineLayout(context, 0, nullptr, 0, nullptr, &computePipelineLayout);
 
-    const VkPushConstantRange pushConstants = {
-        VK_SHADER_STAGE_VERTEX_BIT,
-        0,
-        sizeof(VKR::Math::Matrix4x4<float>)
-    };
 
-    VkPipeline gridPipeline;
+    VKR::VkShaderHotReload::PipelineHandle gridPipeline;
 
-    VkPipeline graphicsPipeline;
+    VKR::VkShaderHotReload::PipelineHandle graphicsPipeline;
     VkPipelineLayout graphicsPipelineLayout;
-    context.CreatePipelineLayout(1, &descriptorSetLayout, 1, &pushConstants, &graphicsPipelineLayout);
 
-    VkRenderPass renderPass;
-    {
-        VkAttachmentDescription attachments[3];
-        attachments[0] = {
-            0,
-            VK_FORMAT_B8G8R8A8_UNORM,
-            MSAA_SAMPLES,
-            VK_ATTACHMENT_LOAD_OP_CLEAR,
-            VK_ATTACHMENT_STORE_OP_STORE,
-            VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-            VK_ATTACHMENT_STORE_OP_DONT_CARE,
-            VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-        };
-
-        attachments[1] = {
-            0,
-            VKR::VkHelpers::FindDepthFormat(context.GetPhysicalDevice()),
-            MSAA_SAMPLES,
-            VK_ATTACHMENT_LOAD_OP_CLEAR,
-            VK_ATTACHMENT_STORE_OP_STORE,
-            VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-            VK_ATTACHMENT_STORE_OP_DONT_CARE,
-            VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
-        };
-
-        attachments[2] = {
-            0,
-            VK_FORMAT_B8G8R8A8_UNORM,
-            VK_SAMPLE_COUNT_1_BIT,
-            VK_ATTACHMENT_LOAD_OP_CLEAR,
-            VK_ATTACHMENT_STORE_OP_STORE,
-            VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-            VK_ATTACHMENT_STORE_OP_DONT_CARE,
-            VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
-        };
-
-
-        VkSubpassDependency dependencies[1];
-        dependencies[0] = {
-            VK_SUBPASS_EXTERNAL,
-            0,
-            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-            0,
-            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-            0
-        };
-
-        VkAttachmentReference colorAttachmentRef = {
-            0,
-            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-        };
-
-        VkAttachmentReference depthAttachmentRef = {
-            1,
-            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
-        };
-
-
-        VkAttachmentReference colorAttachmentResolveRef = {
-            2,
-            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-        };
-
-
-        VkSubpassDescription subpass = {
-            0,
-            VK_PIPELINE_BIND_POINT_GRAPHICS,
-            0,
-            nullptr,
-            1,
-            &colorAttachmentRef,
-            &colorAttachmentResolveRef,
-            &depthAttachmentRef,
-            0,
-            nullptr
-        };
-
-        context.CreateRenderPass(3, attachments, 1, &subpass, 1, dependencies, &renderPass);
-    }
-
-    VkFramebuffer frameBuffers[8];  //Max Framebuffer count
-    for (int i = 0; i < swapchain.GetImageCount(); i++) {
-        VkImageView attachments[3] = { renderTargetView, depthView ,swapchain.GetImageViews()[i] };
-        context.CreateFrameBuffer({ WINDOW_WIDTH, WINDOW_HEIGHT, 1 }, renderPass, 3, attachments, &frameBuffers[i]);
-    }
+    //Passes use Dynamic Rendering, so Pipelines are built against attachment formats, and no Render Pass or Framebuffers are needed. 
+    const VkFormat colorFormat = VK_FORMAT_B8G8R8A8_UNORM;
 
     VkViewport viewport = {};
     viewport.x = 0;
     viewport.y = 0;
-    viewport.width = (float)WINDOW_WIDTH;
-    viewport.height = (float)WINDOW_HEIGHT;
+    viewport.width = (float)swapchain.GetExtent().width;
+    viewport.height = (float)swapchain.GetExtent().height;
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
 
     VkRect2D scissor = {};
     scissor.offset = { 0, 0 };
-    scissor.extent = { WINDOW_WIDTH, WINDOW_HEIGHT };
+    scissor.extent = swapchain.GetExtent();
 
 
     VkShaderModule computeShaderModule;
@@ -301,47 +221,46 @@ int main() {
 
     VKR::VkPipelineBuilder computeBuilder;
     computeBuilder.AddShaderStage(computeShaderModule, VK_SHADER_STAGE_COMPUTE_BIT, "main");
-    computePipelineCreateInfo = computeBuilder.BuildComputePipeline(computePipelineLayout);
-    context.CreateComputePipelines(1, &computePipelineCreateInfo, pipelineCache, &computePipeline);
+    computePipeline = pipelineRegistry.GetComputePipeline(context, computeBuilder, computePipelineLayout).Get();     //Needed by the first frame
 
 
 
-    VkShaderModule vertexShaderModule;
+    //The Vertex Input State and Push Constant ranges are reflected from the shaders, rather than written to match them. 
+    VKR::VkShaderReflection reflection;
+
+    VKR::VkShaderHotReload::ShaderHandle vertexShader;
+    shaderHotReload.LoadShader(context, "Shaders/vs.spirv", "Shaders/vs.vert", &vertexShader);
     {
         std::vector<char> vs_source;
         VKR::IO::ReadFile("Shaders/vs.spirv", vs_source);
-        context.CreateShaderModule(vs_source.data(), vs_source.size(), &vertexShaderModule);
+
+        VKR::VkShaderStageReflection stage;
+        VKR::VkShaderReflection::ReflectStageCached(vs_source.data(), vs_source.size(), "Shaders", &stage);
+        reflection.AddStage(stage);
     }
 
-    VkShaderModule fragmentShaderModule;
+    VKR::VkShaderHotReload::ShaderHandle fragmentShader;
+    shaderHotReload.LoadShader(context, "Shaders/fs.spirv", "Shaders/fs.frag", &fragmentShader);
     {
         std::vector<char> fs_source;
         VKR::IO::ReadFile("Shaders/fs.spirv", fs_source);
-        context.CreateShaderModule(fs_source.data(), fs_source.size(), &fragmentShaderModule);
+
+        VKR::VkShaderStageReflection stage;
+        VKR::VkShaderReflection::ReflectStageCached(fs_source.data(), fs_source.size(), "Shaders", &stage);
+        reflection.AddStage(stage);
     }
 
+    //The bindless heap's Set Layout is used in place of the reflected one, as it's sized and flagged for update-after-bind. 
+    {
+        const auto& pushConstantRanges = reflection.GetPushConstantRanges();
+        layoutCache.GetPipelineLayout(context, 1, &bindlessHeap.GetLayout(), static_cast<uint32_t>(pushConstantRanges.size()), pushConstantRanges.data(), &graphicsPipelineLayout);
+    }
 
     VKR::VkPipelineBuilder builder;
-    builder.AddShaderStage(vertexShaderModule, VK_SHADER_STAGE_VERTEX_BIT, "main");
-    builder.AddShaderStage(fragmentShaderModule, VK_SHADER_STAGE_FRAGMENT_BIT, "main");
-
-    VkVertexInputBindingDescription bindings[1] = {};
-    bindings[0].binding = 0;
-    bindings[0].stride = sizeof(float) * 6;
-    bindings[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-
-    VkVertexInputAttributeDescription attributes[2] = {};
-    attributes[0].location = 0;
-    attributes[0].binding = bindings[0].binding;
-    attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-    attributes[0].offset = 0;
-
-    attributes[1].location = 1;
-    attributes[1].binding = bindings[0].binding;
-    attributes[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-    attributes[1].offset = sizeof(float) * 3;
-
-    builder.SetVertexInputState(1, bindings, 2, attributes);
+    builder.AddShaderStage(shaderHotReload.GetShaderModule(vertexShader), VK_SHADER_STAGE_VERTEX_BIT, "main", shaderHotReload.GetShaderID(vertexShader));
+    builder.AddShaderStage(shaderHotReload.GetShaderModule(fragmentShader), VK_SHADER_STAGE_FRAGMENT_BIT, "main", shaderHotReload.GetShaderID(fragmentShader));
+
+    reflection.ApplyVertexInputState(builder);
     builder.SetInputAssemblyState(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, false);
 
     builder.SetTessellationState(0);
@@ -368,24 +287,17 @@ int main() {
         VK_DYNAMIC_STATE_SCISSOR
     };
     builder.SetDynamicState(dynamicStates.size(), dynamicStates.data());
+    builder.SetRenderingState(1, &colorFormat, depthFormat);
 
-    VkShaderModule gridVertexShaderModule;
-    {
-        std::vector<char> grid_vs_source;
-        VKR::IO::ReadFile("Shaders/vs_grid.spirv", grid_vs_source);
-        context.CreateShaderModule(grid_vs_source.data(), grid_vs_source.size(), &gridVertexShaderModule);
-    }
+    VKR::VkShaderHotReload::ShaderHandle gridVertexShader;
+    shaderHotReload.LoadShader(context, "Shaders/vs_grid.spirv", "Shaders/grid.vert", &gridVertexShader);
 
-    VkShaderModule gridFragmentShaderModule;
-    {
-        std::vector<char> grid_fs_source;
-        VKR::IO::ReadFile("Shaders/fs_grid.spirv", grid_fs_source);
-        context.CreateShaderModule(grid_fs_source.data(), grid_fs_source.size(), &gridFragmentShaderModule);
-    }
+    VKR::VkShaderHotReload::ShaderHandle gridFragmentShader;
+    shaderHotReload.LoadShader(context, "Shaders/fs_grid.spirv", "Shaders/grid.frag", &gridFragmentShader);
 
     VKR::VkPipelineBuilder gridBuilder;
-    gridBuilder.AddShaderStage(gridVertexShaderModule, VK_SHADER_STAGE_VERTEX_BIT, "main");
-    gridBuilder.AddShaderStage(gridFragmentShaderModule, VK_SHADER_STAGE_FRAGMENT_BIT, "main");
+    gridBuilder.AddShaderStage(shaderHotReload.GetShaderModule(gridVertexShader), VK_SHADER_STAGE_VERTEX_BIT, "main", shaderHotReload.GetShaderID(gridVertexShader));
+    gridBuilder.AddShaderStage(shaderHotReload.GetShaderModule(gridFragmentShader), VK_SHADER_STAGE_FRAGMENT_BIT, "main", shaderHotReload.GetShaderID(gridFragmentShader));
     gridBuilder.SetVertexInputState(0, nullptr, 0, nullptr);
     gridBuilder.SetInputAssemblyState(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, false);
     gridBuilder.SetTessellationState(0);
@@ -396,24 +308,64 @@ int main() {
 
     gridBuilder.SetBlendState(false, VK_LOGIC_OP_COPY, 1, &blendAttachment);
     gridBuilder.SetDynamicState(dynamicStates.size(), dynamicStates.data());
+    gridBuilder.SetRenderingState(1, &colorFormat, depthFormat);
 
-    VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo = builder.BuildGraphicsPipeline(graphicsPipelineLayout, renderPass, 0);
-
-
-    context.CreateGraphicsPipelines(1, &graphicsPipelineCreateInfo, pipelineCache, &graphicsPipeline);
-    graphicsPipelineCreateInfo = gridBuilder.BuildGraphicsPipeline(graphicsPipelineLayout, renderPass, 0);
-    context.CreateGraphicsPipelines(1, &graphicsPipelineCreateInfo, pipelineCache, &gridPipeline);
+    graphicsPipeline = shaderHotReload.AddGraphicsPipeline(context, builder, graphicsPipelineLayout, VK_NULL_HANDLE, 0);
+    gridPipeline = shaderHotReload.AddGraphicsPipeline(context, gridBuilder, graphicsPipelineLayout, VK_NULL_HANDLE, 0);
 
 
     VKR::VkImGui imGuiRenderer;
     imGuiRenderer.Init(context, window);
-    imGuiRenderer.Hook(context, graphicsQueueIndex, graphicsQueue, pipelineCache, swapchain.GetImageCount(), renderPass, MSAA_SAMPLES);
-
-    std::vector<VkCommandBuffer> commands(FRAMES_IN_FLIGHT);
+    imGuiRenderer.Hook(context, graphicsQueueIndex, graphicsQueue, pipelineCacheManager.GetPipelineCache(), swapchain.GetImageCount(), colorFormat, VK_SAMPLE_COUNT_1_BIT);     //Drawn after the MSAA resolve
+
+    //Draws are recorded into Secondary Command Buffers across the Job System's threads. 
+    VKR::VkCommandRecorder commandRecorder;
+    commandRecorder.Create(context, graphicsQueueIndex, framesInFlight);
+
+    //The frame is described as passes over the resources they access, so barriers and layout transitions are derived rather than written by hand. 
+    //The MSAA target and depth buffer only live within the geometry pass, and are never stored, so the graph owns them, and lazily allocates them where supported. 
+    VKR::VkRenderGraph renderGraph;
+    const auto backbuffer = renderGraph.ImportImage("Backbuffer", swapchain.GetExtent(), colorFormat, VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, swapchain.GetPresentLayout());
+    const auto msaaTarget = renderGraph.CreateImage("MSAA Target", swapchain.GetExtent(), colorFormat, MSAA_SAMPLES);
+    const auto depthBuffer = renderGraph.CreateImage("Depth Buffer", swapchain.GetExtent(), depthFormat, MSAA_SAMPLES);
+
+    //Geometry is drawn to the MSAA target, and resolved into the backbuffer. 
+    const auto geometryPass = renderGraph.AddPass("Geometry", [&](VkCommandBuffer cmd) {
+        commandRecorder.Execute(cmd);
+    }, VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT);
+    renderGraph.AddColorAttachment(geometryPass, msaaTarget, VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_DONT_CARE, swapchain.GetColourClearValue(), backbuffer);
+    renderGraph.SetDepthAttachment(geometryPass, depthBuffer, VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_DONT_CARE, swapchain.GetDepthStencilClearValue());
+
+    //ImGui is drawn over the resolved image, on the main thread. 
+    const auto imGuiPass = renderGraph.AddPass("ImGui", [&](VkCommandBuffer cmd) {
+        imGuiRenderer.Draw(&cmd);
+    });
+    renderGraph.AddColorAttachment(imGuiPass, backbuffer, VK_ATTACHMENT_LOAD_OP_LOAD, VK_ATTACHMENT_STORE_OP_STORE);
+
+    renderGraph.Compile(context);
+
+    //Resources replaced while frames are in flight are destroyed once the GPU is done with them, rather than idling the device. 
+    VKR::VkDeletionQueue deletionQueue;
+
+    //On resize, the swapchain is recreated from the old one, and anything sized to it follows. 
+    swapchain.AddRecreateCallback([&](const VKR::VkContext& ctx, const VKR::VkSwapchain& sc, VKR::VkDeletionQueue& queue, const uint64_t retireValue) {
+        viewport.width = (float)sc.GetExtent().width;
+        viewport.height = (float)sc.GetExtent().height;
+        scissor.extent = sc.GetExtent();
+
+        renderGraph.SetImageExtent(backbuffer, sc.GetExtent());
+        renderGraph.SetImageExtent(msaaTarget, sc.GetExtent());
+        renderGraph.SetImageExtent(depthBuffer, sc.GetExtent());
+        renderGraph.Compile(ctx, &queue, retireValue);
+    });
 
     VKR::Timer timer;
     timer.Start();
 
+    //Limits the frame rate before input is polled, so a capped frame samples its input as late as possible. 
+    VKR::VkFramePacer framePacer;
+    framePacer.SetMaxFrameRate(maxFrameRate);
+
     uint64_t frameIdx = 0;  //Keep track of the current frame. 
     double runtime = 0;
     uint64_t fps = 0;
@@ -421,10 +373,28 @@ int main() {
 
     VKR::Math::Matrix4x4<float> viewProjection = VKR::Math::Matrix4x4<>::Identity();
     std::vector<VKR::Math::Matrix4x4<float>> worldMatrices(OBJECT_COUNT);
+
+    //Object transforms are stored as Structure-of-Arrays, so their World matrices can be composed in batches. 
+    std::vector<float> positionX(OBJECT_COUNT), positionY(OBJECT_COUNT), positionZ(OBJECT_COUNT);
+    std::vector<float> rotationX(OBJECT_COUNT), rotationY(OBJECT_COUNT), rotationZ(OBJECT_COUNT, 0.0f);
+    std::vector<float> scale(OBJECT_COUNT, 1.0f);
+
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        positionX[i] = sinf(i) * OBJECT_COUNT / 10;
+        positionY[i] = (float)(i % 100);
+        positionZ[i] = cosf(i) * OBJECT_COUNT / 10;
+    }
+
+    const VKR::Math::TransformSoA transforms = {
+        positionX.data(), positionY.data(), positionZ.data(),
+        rotationX.data(), rotationY.data(), rotationZ.data(),
+        scale.data(), scale.data(), scale.data()
+    };
     EASY_END_BLOCK;
 
-    while (window.PollEvents()) {
+    while (window.PollEvents() && (frameCount == 0 || frameIdx < frameCount)) {
         EASY_BLOCK("Main Loop", profiler::colors::SkyBlue);
+        framePacer.BeginFrame();    //Input was just polled. 
         {
             EASY_BLOCK("Timing");
             timer.Tick();
@@ -432,20 +402,42 @@ int main() {
             fps = 1.0 / dtms;
             runtime = timer.Duration();
         }
-        imGuiRenderer.BeginFrame();
 
-        const uint64_t frame_in_flight = frameIdx % FRAMES_IN_FLIGHT;
+        //Nothing can be presented while minimized. 
+        if (window.IsMinimized()) {
+            window.WaitEvents();
+            continue;
+        }
+
+        //The old swapchain is retired once the last submitted frame completes. 
+        if (swapchain.NeedsRecreation()) {
+            swapchain.Recreate(context, deletionQueue, frameContext.GetFrameValue());
+        }
+
+        const uint64_t frame_in_flight = frameIdx % framesInFlight;
 
         uint32_t imageIdx;
         {
             EASY_BLOCK("Synchronization", profiler::colors::Red500);
-            vkWaitForFences(context.GetDevice(), 1, &f_FrameReady[frame_in_flight], VK_TRUE, UINT64_MAX);
-            vkResetFences(context.GetDevice(), 1, &f_FrameReady[frame_in_flight]);
+            frameContext.BeginFrame(context, frame_in_flight);
+            deletionQueue.Collect(context, frameContext.GetCompletedValue(context));
+            uniformRing.BeginFrame(frame_in_flight);     //The frame has completed, so its uniforms can be reclaimed. 
+            shaderHotReload.Update(context);            //Reloaded Pipelines are only swapped in between frames. 
             {
                 EASY_BLOCK("Image Acquisition", profiler::colors::Red500);
-                vkAcquireNextImageKHR(context.GetDevice(), swapchain.GetSwapchain(), UINT64_MAX, s_ImageAvailable[frame_in_flight], nullptr, &imageIdx);
+                VkResult result = swapchain.AcquireNextImage(context, frameContext.GetImageAvailableSemaphore(), &imageIdx);
+                if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+                    swapchain.Recreate(context, deletionQueue, frameContext.GetFrameValue());
+                    result = swapchain.AcquireNextImage(context, frameContext.GetImageAvailableSemaphore(), &imageIdx);
+                }
+
+                //Skip the frame if there's still no image. Nothing was submitted, so the frame can be begun again. 
+                if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+                    continue;
+                }
             }
         }
+        imGuiRenderer.BeginFrame();
         {
             EASY_BLOCK("Update", profiler::colors::Amber400);
             static VKR::Math::Vector3f eyePos;
@@ -472,35 +464,39 @@ int main() {
 
             //Compute View-Projection matrix for this frame. 
             VKR::Math::Matrix4x4<> v = VKR::Math::Matrix4x4<>::View(eyePos);  //TODO: Const Operators
-            VKR::Math::Matrix4x4<> p = VKR::Math::Matrix4x4<>::ProjectionFoVDegrees(90.0, (double)WINDOW_WIDTH / (double)WINDOW_HEIGHT, 0.001, 100000.0);
+            VKR::Math::Matrix4x4<> p = VKR::Math::Matrix4x4<>::ProjectionFoVDegrees(90.0, (double)swapchain.GetExtent().width / (double)swapchain.GetExtent().height, 0.001, 100000.0);
 
             viewProjection = v * p;
 
             //Compute World matrices for an arbitrary number of objects. 
-            for (int i = 0; i < OBJECT_COUNT; i++) {
-                VKR::Math::Matrix4x4<> s = VKR::Math::Matrix4x4<>::Scaling({ 1.0, 1.0, 1.0 });
-
-                static float rot = 0.0f;
-                rot += dtms;
+            static float rot = 0.0f;
+            rot += dtms * OBJECT_COUNT;
 
-                VKR::Math::Matrix4x4<> x = VKR::Math::Matrix4x4<>::XRotationFromDegrees(rot / 2.0 + i);
-                VKR::Math::Matrix4x4<> y = VKR::Math::Matrix4x4<>::YRotationFromDegrees(rot + i);
-                VKR::Math::Matrix4x4<> z = VKR::Math::Matrix4x4<>::ZRotationFromDegrees(0);
-
-                VKR::Math::Matrix4x4<> t = VKR::Math::Matrix4x4<>::Translation({ sinf(i) * OBJECT_COUNT / 10, (float)(i % 100), cosf(i) * OBJECT_COUNT / 10 }); //TODO: Template Argument Static Typecasting
-
-                VKR::Math::Matrix4x4<> r = (x * (y * z));
-                worldMatrices[i] = (s * r) * t;
+            for (int i = 0; i < OBJECT_COUNT; i++) {
+                rotationX[i] = VKR::Math::DegToRad(rot / 2.0f + i);
+                rotationY[i] = VKR::Math::DegToRad(rot + i);
             }
+
+            //Spread World matrix composition across the Job System's threads. 
+            VKR::Jobs::ParallelFor(OBJECT_COUNT, [&](uint32_t start, uint32_t end, uint32_t threadIndex) {
+                VKR::Math::BuildWorldMatrices(transforms, start, end - start, worldMatrices.data());
+            }, 64);
         }
 
         {
             EASY_BLOCK("Device Work", profiler::colors::Red500);
 
-            context.FreeCommandBuffers(commandPool, 1, &commands[frame_in_flight]);
-            context.AllocateCommandBuffers(commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1, &commands[frame_in_flight]);
+            {
+                EASY_BLOCK("Compute Pass", profiler::colors::Red500);
+                VkCommandBuffer computeCmd = VK_NULL_HANDLE;
+                asyncCompute.Begin(context, frame_in_flight, &computeCmd);
+                vkCmdBindPipeline(computeCmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
+                vkCmdDispatch(computeCmd, 600, 400, 1);
+                asyncCompute.Submit(context);
+            }
 
-            VkCommandBuffer& cmd = commands[frame_in_flight];
+            VkCommandBuffer cmd = VK_NULL_HANDLE;
+            frameContext.AllocateCommandBuffer(context, VK_COMMAND_BUFFER_LEVEL_PRIMARY, &cmd);
 
             const VkCommandBufferBeginInfo beginInfo = {
                 VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
@@ -509,76 +505,146 @@ int main() {
                 nullptr
             };
             vkBeginCommandBuffer(cmd, &beginInfo);
-            {
-                EASY_BLOCK("Compute Pass", profiler::colors::Red500);
-                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
-                vkCmdDispatch(cmd, 600, 400, 1);
-            }
+
+            //Take ownership of any uploads completed since the last frame. 
+            VkPipelineStageFlags uploadWaitStages = 0;
+            const uint64_t uploadToken = uploadManager.AcquireUploads(cmd, &uploadWaitStages);
+            uploadManager.Collect(context);
+
+            //Likewise for any compute results. The dispatch above releases nothing, so the frame doesn't wait on it. 
+            VkPipelineStageFlags computeWaitStages = 0;
+            const uint64_t computeToken = asyncCompute.AcquireResources(cmd, &computeWaitStages);
             {
                 EASY_BLOCK("Render Pass", profiler::colors::Red500);
-                vkCmdUpdateBuffer(cmd, uniformBuffer, 0, sizeof(VKR::Math::Matrix4x4<float>), &viewProjection);
-                VkClearValue clearValues[3] = { swapchain.GetColourClearValue(), swapchain.GetDepthStencilClearValue(), swapchain.GetColourClearValue() };
-                VkRenderPassBeginInfo rpb = {
-                    VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-                    nullptr,
-                    renderPass,
-                    frameBuffers[imageIdx],
-                    {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT},
-                    3,
-                    clearValues
+                //Write this frame's matrices into the ring. Shaders index the ring as an array of matrices, so allocations are matrix aligned, and World matrices are tightly packed. 
+                constexpr VkDeviceSize matrixSize = sizeof(VKR::Math::Matrix4x4<float>);
+
+                VKR::VkRingBuffer::Allocation viewProjectionAlloc = {};
+                uniformRing.Allocate(matrixSize, &viewProjectionAlloc, matrixSize);
+                memcpy(viewProjectionAlloc.pData, &viewProjection, matrixSize);
+
+                VKR::VkRingBuffer::Allocation worldAlloc = {};
+                uniformRing.Allocate(matrixSize * OBJECT_COUNT, &worldAlloc, matrixSize);
+                memcpy(worldAlloc.pData, worldMatrices.data(), matrixSize * OBJECT_COUNT);
+                uniformRing.EndFrame(context);
+
+                const DrawConstants drawConstants = {
+                    uniformRingHandle,
+                    static_cast<uint32_t>(viewProjectionAlloc.offset / matrixSize),
+                    static_cast<uint32_t>(worldAlloc.offset / matrixSize)
                 };
-                vkCmdBeginRenderPass(cmd, &rpb, VK_SUBPASS_CONTENTS_INLINE);
-                vkCmdSetViewport(cmd, 0, 1, &viewport);     //Dynamic State
-                vkCmdSetScissor(cmd, 0, 1, &scissor);
-                vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
-                VkDeviceSize offsets = 0;
-                vkCmdBindVertexBuffers(cmd, 0, 1, &vertexBuffer, &offsets);
-                vkCmdBindIndexBuffer(cmd, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, gridPipeline);
-                vkCmdDraw(cmd, 6, 1, 0, 0);
-                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
-                for (uint32_t i = 0; i < OBJECT_COUNT; i++) {
-                    vkCmdPushConstants(cmd, graphicsPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(VKR::Math::Matrix4x4<>), &worldMatrices[i]);
-                    vkCmdDrawIndexed(cmd, 36, 1, 0, 0, 0);
+
+                commandRecorder.Reset(context, frame_in_flight);
+                const VkCommandBufferInheritanceRenderingInfo inheritanceRenderingInfo = VKR::VkInit::MakeCommandBufferInheritanceRenderingInfo(1, &colorFormat, depthFormat, VK_FORMAT_UNDEFINED, MSAA_SAMPLES);
+                const VkCommandBufferInheritanceInfo inheritanceInfo = VKR::VkInit::MakeCommandBufferInheritanceInfo(VK_NULL_HANDLE, 0, VK_NULL_HANDLE, &inheritanceRenderingInfo);
+
+                //Secondary Command Buffers don't inherit state, so each one binds everything it needs.
+                auto bindState = [&](VkCommandBuffer secondary) {
+                    vkCmdSetViewport(secondary, 0, 1, &viewport);     //Dynamic State
+                    vkCmdSetScissor(secondary, 0, 1, &scissor);
+                    bindlessHeap.Bind(secondary, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipelineLayout);
+                    vkCmdPushConstants(secondary, graphicsPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(DrawConstants), &drawConstants);
+                    VkDeviceSize offsets = 0;
+                    vkCmdBindVertexBuffers(secondary, 0, 1, &vertexBuffer.buffer, &offsets);
+                    vkCmdBindIndexBuffer(secondary, indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+                };
+
+                //Geometry is skipped until its Pipeline has finished compiling, so the first frames don't wait on compilation. 
+                pipelineCompiler.Collect();
+                const VkPipeline gridPipelineHandle = shaderHotReload.GetPipeline(gridPipeline);
+                const VkPipeline graphicsPipelineHandle = shaderHotReload.GetPipeline(graphicsPipeline);
+
+                if (gridPipelineHandle != VK_NULL_HANDLE) {
+                    commandRecorder.Record(context, inheritanceInfo, 1, [&](VkCommandBuffer secondary, uint32_t start, uint32_t end) {
+                        bindState(secondary);
+                        vkCmdBindPipeline(secondary, VK_PIPELINE_BIND_POINT_GRAPHICS, gridPipelineHandle);
+                        vkCmdDraw(secondary, 6, 1, 0, 0);
+                    });
+                }
+
+                if (graphicsPipelineHandle != VK_NULL_HANDLE) {
+                    commandRecorder.Record(context, inheritanceInfo, OBJECT_COUNT, [&](VkCommandBuffer secondary, uint32_t start, uint32_t end) {
+                        bindState(secondary);
+                        vkCmdBindPipeline(secondary, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipelineHandle);
+                        //No descriptors are bound per draw; the first instance selects the object's World matrix. 
+                        for (uint32_t i = start; i < end; i++) {
+                            vkCmdDrawIndexed(secondary, 36, 1, 0, 0, i);
+                        }
+                    }, 32);
                 }
                 
                 ImGui::Begin("Debug");
                 ImGui::Text("Debug Message!");
+                ImGui::Text("CPU Wait (ms): %f", frameContext.GetCPUWaitTime());
+                ImGui::Text("Latency (ms): %.2f to Present, %.2f to GPU completion", framePacer.GetPresentLatency(), framePacer.GetCompletionLatency());
+                ImGui::Text("Swapchain: %d Images, %d Frames in Flight", swapchain.GetImageCount(), framesInFlight);
+                {
+                    //Changing the present mode recreates the swapchain at the start of the next frame. 
+                    const VkPresentModeKHR presentModes[] = { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR };
+                    const char* presentModeNames[] = { "Immediate", "Mailbox", "FIFO", "FIFO Relaxed" };
+                    int presentModeIdx = 0;
+                    for (int i = 0; i < 4; i++) {
+                        if (presentModes[i] == swapchain.GetPresentMode()) {
+                            presentModeIdx = i;
+                        }
+                    }
+                    if (ImGui::Combo("Present Mode", &presentModeIdx, presentModeNames, 4)) {
+                        swapchain.SetPresentMode(presentModes[presentModeIdx]);
+                    }
+
+                    float frameRateLimit = static_cast<float>(framePacer.GetMaxFrameRate());
+                    if (ImGui::SliderFloat("Frame Limit (0 = Off)", &frameRateLimit, 0.0f, 480.0f, "%.0f")) {
+                        framePacer.SetMaxFrameRate(frameRateLimit);
+                    }
+                    ImGui::Text("Limiter Wait (ms): %f", framePacer.GetLimiterWaitTime());
+                }
+                ImGui::Text("Pipelines: %d (%d compiling)", pipelineRegistry.GetPipelineCount(), pipelineCompiler.GetPendingCount());
+                ImGui::Text("Shader Reloads: %d", shaderHotReload.GetReloadCount());
+                ImGui::Text("Render Graph: %d Passes (%d culled), %d Barriers", renderGraph.GetPassCount(), renderGraph.GetCulledPassCount(), renderGraph.GetBarrierCount());
+                ImGui::Text("Transient Memory: %.2f MB (%.2f MB unaliased, %.2f MB lazily allocated)", renderGraph.GetTransientMemorySize() / (1024.0 * 1024.0), renderGraph.GetUnaliasedMemorySize() / (1024.0 * 1024.0), renderGraph.GetLazyMemorySize() / (1024.0 * 1024.0));
                 ImGui::End();
 
                 bool demo = true; 
                 ImGui::ShowDemoWindow(&demo);
 
                 imGuiRenderer.EndFrame();
-                imGuiRenderer.Draw(&cmd);
-
-                vkCmdEndRenderPass(cmd);
 
+                renderGraph.SetImportedImage(backbuffer, swapchain.GetImages()[imageIdx], swapchain.GetImageViews()[imageIdx]);
+                renderGraph.Execute(context, cmd);
             }
             vkEndCommandBuffer(cmd);
 
             {
                 EASY_BLOCK("Queue Submission", profiler::colors::Red500);
 
-                VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT };
-
-                const VkSubmitInfo submitInfo = {
-                    VK_STRUCTURE_TYPE_SUBMIT_INFO,
-                    nullptr,
-                    1,
-                    &s_ImageAvailable[frame_in_flight],
-                    waitStages,
-                    1,
-                    &commands[frame_in_flight],
-                    1,
-                    &s_FrameFinished[frame_in_flight]
-                };
+                //The frame context waits on the swapchain image itself. 
+                std::vector<VkSemaphore> waitSemaphores;
+                std::vector<VkPipelineStageFlags> waitStages;
+                std::vector<uint64_t> waitValues;
 
+                if (uploadToken > 0) {
+                    waitSemaphores.push_back(uploadManager.GetSemaphore());
+                    waitStages.push_back(uploadWaitStages);
+                    waitValues.push_back(uploadToken);
+                }
+                if (computeToken > 0) {
+                    waitSemaphores.push_back(asyncCompute.GetSemaphore());
+                    waitStages.push_back(computeWaitStages);
+                    waitValues.push_back(computeToken);
+                }
 
-                vkQueueSubmit(graphicsQueue, 1, &submitInfo, f_FrameReady[frame_in_flight]);
+                frameContext.Submit(graphicsQueue, 1, &cmd, static_cast<uint32_t>(waitSemaphores.size()), waitSemaphores.data(), waitValues.data(), waitStages.data());
             }
 
-            swapchain.Present(graphicsQueue, s_FrameFinished[frame_in_flight], &imageIdx);
+            swapchain.Present(graphicsQueue, frameContext.GetRenderFinishedSemaphore(), &imageIdx);
+            framePacer.EndFrame(context, frameContext);
+
+            if (capturePath && frameIdx + 1 == frameCount) {
+                std::vector<uint8_t> pixels;
+                if (swapchain.ReadbackImage(context, imageIdx, pixels) == VK_SUCCESS) {
+                    VKR::IO::WritePNG(capturePath, swapchain.GetExtent().width, swapchain.GetExtent().height, pixels.data());
+                }
+            }
             frameIdx++;
         }
     }
@@ -586,58 +652,38 @@ int main() {
     EASY_BLOCK("App Shutdown");
 
     printf("\n");   //Print a newline for correct logging
+    if (headless) {
+        VKR::Log::Message("Rendered %llu frames in %fs (%f FPS).\n", static_cast<unsigned long long>(frameIdx), runtime, runtime > 0.0 ? frameIdx / runtime : 0.0);
+    }
     window.Hide();
     window.Destroy();
 
     vkDeviceWaitIdle(context.GetDevice());
+    deletionQueue.Flush(context);
 
-    uint64_t cacheDataSize = 0;
-    vkGetPipelineCacheData(context.GetDevice(), pipelineCache, &cacheDataSize, nullptr);
-    std::vector<char> cacheData(cacheDataSize);
-    vkGetPipelineCacheData(context.GetDevice(), pipelineCache, &cacheDataSize, cacheData.data());
-
-    VKR::IO::WriteFile("PipelineCache.bin", cacheData.data(), cacheData.size());
-    vkDestroyPipelineCache(context.GetDevice(), pipelineCache, nullptr);
+    pipelineCompiler.Destroy(context);     //Merges the compiler's thread caches, so must precede Save(). 
+    pipelineCacheManager.Save(context);
+    pipelineCacheManager.Destroy(context);
 
     imGuiRenderer.Shutdown(context);
 
-    context.DestroyPipeline(gridPipeline);
-    context.DestroyShaderModule(gridFragmentShaderModule);
-    context.DestroyShaderModule(gridVertexShaderModule);
+    pipelineRegistry.Destroy(context);
+    shaderHotReload.Destroy(context);
 
-    context.DestroyPipeline(graphicsPipeline);
-    context.DestroyPipelineLayout(graphicsPipelineLayout);
-    context.DestroyShaderModule(fragmentShaderModule);
-    context.DestroyShaderModule(vertexShaderModule);
-
-    context.DestroyPipeline(computePipeline);
-    context.DestroyPipelineLayout(computePipelineLayout);
     context.DestroyShaderModule(computeShaderModule);
 
-    context.DestroyRenderPass(renderPass);
-
-    for (int i = 0; i < swapchain.GetImageCount(); i++) {
-        vkDestroyFramebuffer(context.GetDevice(), frameBuffers[i], nullptr);
-    }
+    renderGraph.Destroy(context);
+    context.DestroyBuffer(indexBuffer);
+    context.DestroyBuffer(vertexBuffer);
+    uniformRing.Destroy(context);
+    uploadManager.Destroy(context);
+    asyncCompute.Destroy(context);
 
-    context.DestroyImageView(renderTargetView);
-    context.DestroyImage(renderTargetImage, renderTargetImageAlloc);
-    context.DestroyImageView(depthView);
-    context.DestroyImage(depthImage, depthImageAlloc);
-    context.DestroyBuffer(indexBuffer, indexBufferAlloc);
-    context.DestroyBuffer(vertexBuffer, vertexBufferAlloc);
-    context.DestroyBuffer(uniformBuffer, uniformBufferAlloc);
+    bindlessHeap.Destroy(context);
+    layoutCache.Destroy(context);
 
-    context.DestroyDescriptorSetlayout(descriptorSetLayout);
-    context.DestroyDescriptorPool(descriptorPool);
-
-    context.DestroyCommandPool(commandPool);
-
-    for (int i = 0; i < FRAMES_IN_FLIGHT; i++) {
-        context.DestroyFence(f_FrameReady[i]);
-        context.DestroySemaphore(s_FrameFinished[i]);
-        context.DestroySemaphore(s_ImageAvailable[i]);
-    }
+    commandRecorder.Destroy(context);
+    frameContext.Destroy(context);
 
     ShutdownVulkan(context, swapchain);
 
@@ -650,7 +696,46 @@ int main() {
 
 //--------------------------
 
-void InitVulkan(VKR::VkContext& context, VKR::VkSwapchain& swapchain, VKR::Window& window, uint32_t& queueFamilyIndex, VkQueue& queue) {
+VKR::VkPresentConfig LoadPresentConfig(double* pMaxFrameRate) {
+    VKR::VkPresentConfig config = {
+        PRESENT_MODE,
+        SWAPCHAIN_IMAGES,
+        FRAMES_IN_FLIGHT
+    };
+
+    //VKR_PRESENT_MODE is one of IMMEDIATE, MAILBOX, FIFO or FIFO_RELAXED. 
+    if (const char* presentMode = std::getenv("VKR_PRESENT_MODE")) {
+        if (strcmp(presentMode, "IMMEDIATE") == 0) {
+            config.presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+        }
+        else if (strcmp(presentMode, "MAILBOX") == 0) {
+            config.presentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+        }
+        else if (strcmp(presentMode, "FIFO") == 0) {
+            config.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+        }
+        else if (strcmp(presentMode, "FIFO_RELAXED") == 0) {
+            config.presentMode = VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+        }
+        else {
+            VKR::Log::Warning("Unknown VKR_PRESENT_MODE \"%s\", ignoring.\n", presentMode);
+        }
+    }
+    if (const char* imageCount = std::getenv("VKR_SWAPCHAIN_IMAGES")) {
+        config.imageCount = static_cast<uint32_t>(std::strtoul(imageCount, nullptr, 10));
+    }
+    if (const char* framesInFlight = std::getenv("VKR_FRAMES_IN_FLIGHT")) {
+        config.framesInFlight = static_cast<uint32_t>(std::strtoul(framesInFlight, nullptr, 10));
+    }
+    if (const char* maxFrameRate = std::getenv("VKR_MAX_FPS")) {
+        *pMaxFrameRate = std::strtod(maxFrameRate, nullptr);
+    }
+
+    return config;
+}
+
+
+void InitVulkan(VKR::VkContext& context, VKR::VkSwapchain& swapchain, VKR::Window& window, const VKR::VkPresentConfig& presentConfig, const bool headless) {
 
     std::vector<const char*> instanceLayers = {
 #if VKR_DEBUG
@@ -664,7 +749,8 @@ void InitVulkan(VKR::VkContext& context, VKR::VkSwapchain& swapchain, VKR::Windo
         VK_EXT_DEBUG_REPORT_EXTENSION_NAME,
 #endif
     };
-    {
+    //Headless runs have no surface, so need none of its extensions. 
+    if (!headless) {
         uint32_t optExtCount = 0;
         auto ext = glfwGetRequiredInstanceExtensions(&optExtCount);
         for (int i = 0; i < optExtCount; i++) {
@@ -674,13 +760,16 @@ void InitVulkan(VKR::VkContext& context, VKR::VkSwapchain& swapchain, VKR::Windo
 
 
     std::vector<const char*> deviceExtensions = {
-        VK_KHR_SWAPCHAIN_EXTENSION_NAME,
         VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME,
         VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,
+        VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
 #if VKR_DEBUG
         VK_KHR_SHADER_NON_SEMANTIC_INFO_EXTENSION_NAME
 #endif
     };
+    if (!headless) {
+        deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    }
 
 
     VK_CHECK(context.CreateInstance(instanceLayers.size(), instanceLayers.data(), instanceExtensions.size(), instanceExtensions.data(), nullptr));
@@ -689,20 +778,45 @@ void InitVulkan(VKR::VkContext& context, VKR::VkSwapchain& swapchain, VKR::Windo
     VK_CHECK(context.CreateDebugReporter());
 #endif
 
-    VK_CHECK(context.SelectPhysicalDevice());
+    const VKR::VkPhysicalDeviceRequirements requirements = {
+        static_cast<uint32_t>(deviceExtensions.size()),
+        deviceExtensions.data(),
+        nullptr,
+        VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT,
+        VK_API_VERSION_1_2
+    };
+    VK_CHECK(context.SelectPhysicalDevice(&requirements));
+
+    //Optional, so the Pipeline Cache can report hits and misses at Vulkan 1.2. 
+    if (VKR::VkHelpers::ValidatePhysicalDeviceExtensionSupport(context.GetPhysicalDevice(), VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME, 0, nullptr)) {
+        deviceExtensions.push_back(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+    }
+
+    //Creates a Graphics Queue, plus async Compute and Transfer Queues where the device has dedicated families. 
+    const VKR::VkQueueFamilies queueFamilies = context.FindQueueFamilies();
 
-    queueFamilyIndex = VKR::VkHelpers::FindQueueFamilyIndex(context.GetPhysicalDevice(), VK_QUEUE_GRAPHICS_BIT);
-    float queuePriorities[] = { 1.0f };
-    const VkDeviceQueueCreateInfo qci = VKR::VkInit::MakeDeviceQueueCreateInfo(0, 1, queuePriorities);
+    //Descriptor Indexing is core in Vulkan 1.2, so only its features need enabling for the Bindless Heap. 
+    VkPhysicalDeviceSynchronization2Features synchronization2Features = VKR::VkInit::MakePhysicalDeviceSynchronization2Features();
+    VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures = VKR::VkInit::MakePhysicalDeviceDynamicRenderingFeatures(&synchronization2Features);
+    VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures = VKR::VkBindlessHeap::MakeRequiredFeatures(&dynamicRenderingFeatures);
+
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES,
+        &descriptorIndexingFeatures,
+        VK_TRUE
+    };
 
     VkPhysicalDeviceFeatures features = {};
-    context.CreateDevice(deviceExtensions.size(), deviceExtensions.data(), 1, &qci, &features);
+    context.CreateDevice(deviceExtensions.size(), deviceExtensions.data(), queueFamilies, &features, &timelineFeatures);
 
     context.CreateAllocator();
 
-    queue = context.GetDeviceQueue(queueFamilyIndex, 0);
-
-    swapchain.Create(context, &window, queueFamilyIndex);
+    if (headless) {
+        swapchain.CreateHeadless(context, { window.GetWidth(), window.GetHeight() }, context.GetQueue(VKR::EQueueType::Graphics), queueFamilies.graphics, &presentConfig);
+    }
+    else {
+        swapchain.Create(context, &window, queueFamilies.graphics, &presentConfig);
+    }
 }
 
 
@@ -9,6 +9,7 @@
 #include <VKR/Vulkan/VkHelpers.h>
 #include <VKR/Vulkan/VkPipelineBuilder.h>
 #include <VKR/Vulkan/VkInit.h>
+#include <VKR/Vulkan/VkPipelineCacheManager.h>
 #include <VKR/File.h>
 #include <VKR/Maths.h>
 #include <VKR/Logger.h>
@@ -16,7 +17,7 @@
 
 
 constexpr uint32_t FRAMES_IN_FLIGHT = 3;
-constexpr char* PIPELINE_CACHE_PATH = ".cache";
+constexpr const char* PIPELINE_CACHE_PATH = ".";     //Directory holding per-device Pipeline Cache files
 constexpr VkSampleCountFlagBits SAMPLE_COUNT = VK_SAMPLE_COUNT_4_BIT; 
 
 using namespace VKR;
@@ -26,9 +27,9 @@ Samples::HelloTriangleApp::HelloTriangleApp() : DemoApp()
     EASY_FUNCTION();
 
     m_MSAASamples = SAMPLE_COUNT;
-    m_CommandPool = VK_NULL_HANDLE;
     m_FrameInFlight = 0;
     m_ImageIndex = 0;
+    m_bSkipFrame = false;
     m_OcclusionQueryPool = VK_NULL_HANDLE;
     m_Pipeline = VK_NULL_HANDLE;
     m_PipelineLayout = VK_NULL_HANDLE;
@@ -98,18 +99,33 @@ void Samples::HelloTriangleApp::Init(const VKR::Window& window)
     #endif
         };
 
-        VK_CHECK(m_Context.SelectPhysicalDevice());
+        VkPhysicalDeviceFeatures features = {};
+        features.pipelineStatisticsQuery = true;
+
+        const VkPhysicalDeviceRequirements requirements = {
+            static_cast<uint32_t>(deviceExtensions.size()),
+            deviceExtensions.data(),
+            &features,
+            VK_QUEUE_GRAPHICS_BIT,
+            VK_API_VERSION_1_2
+        };
+        VK_CHECK(m_Context.SelectPhysicalDevice(&requirements));
 
         //Retrieve physical device properties
         vkGetPhysicalDeviceProperties(m_Context.GetPhysicalDevice(), &m_DeviceProperties); 
 
         m_QueueFamilyIndex = VkHelpers::FindQueueFamilyIndex(m_Context.GetPhysicalDevice(), VK_QUEUE_GRAPHICS_BIT);
         float queuePriorities[] = { 1.0f };
-        const VkDeviceQueueCreateInfo qci = VkInit::MakeDeviceQueueCreateInfo(0, 1, queuePriorities);
+        const VkDeviceQueueCreateInfo qci = VkInit::MakeDeviceQueueCreateInfo(m_QueueFamilyIndex, 1, queuePriorities);
 
-        VkPhysicalDeviceFeatures features = {};
-        features.pipelineStatisticsQuery = true;
-        m_Context.CreateDevice(deviceExtensions.size(), deviceExtensions.data(), 1, &qci, &features);
+
+        //Frames are paced with a Timeline Semaphore.
+        VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures = {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES,
+            nullptr,
+            VK_TRUE
+        };
+        m_Context.CreateDevice(deviceExtensions.size(), deviceExtensions.data(), 1, &qci, &features, &timelineFeatures);
     }
 
     m_Context.CreateAllocator();
@@ -118,23 +134,11 @@ void Samples::HelloTriangleApp::Init(const VKR::Window& window)
 
 
     Log::Message("Creating Vulkan Resources.\n");
-    //Create the Command Pool
-    m_Context.CreateCommandPool(m_QueueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, &m_CommandPool);
+    //Create a Command Pool and swapchain Semaphores for each frame in flight, and the frame timeline. 
+    m_FrameContext.Create(m_Context, m_QueueFamilyIndex, FRAMES_IN_FLIGHT);
 
     m_Commands.resize(FRAMES_IN_FLIGHT);
 
-    //Size our Synchronization objects appropriately to the number of frames we're processing in flight. 
-    m_fFrameReady.resize(FRAMES_IN_FLIGHT);
-    m_sImageAvailable.resize(FRAMES_IN_FLIGHT);
-    m_sRenderFinished.resize(FRAMES_IN_FLIGHT);
-
-    //Create our Synchronization objects through the VkContext.
-    for (uint32_t i = 0; i < FRAMES_IN_FLIGHT; i++) {
-        m_Context.CreateFence(&m_fFrameReady[i], true); //Signal the fence on creation
-        m_Context.CreateSemaphore(&m_sImageAvailable[i]);
-        m_Context.CreateSemaphore(&m_sRenderFinished[i]);
-    }
-
     //Initialize the ImGui renderer
     m_ImGuiRenderer.Init(m_Context, window);
     ImGuiIO& io = ImGui::GetIO();
@@ -144,20 +148,9 @@ void Samples::HelloTriangleApp::Init(const VKR::Window& window)
     io.Fonts->AddFontFromFileTTF("Data/Fonts/NotoSansJP-Regular.ttf", 18, NULL, io.Fonts->GetGlyphRangesJapanese());
 
     Log::Message("Creating Graphics Pipeline.\n");
-    //Load the Pipeline Cache if present
-    VkPipelineCache pipelineCache;
-    {
-        VkPipelineCacheCreateInfo pipelineCacheCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
-        if (VKR::IO::FileExists(PIPELINE_CACHE_PATH)) {
-            Log::Message("Loading Pipeline Cache.\n"); 
-            std::vector<char> pipelineCacheBlob;
-            VKR::IO::ReadFile(PIPELINE_CACHE_PATH, pipelineCacheBlob);
-            pipelineCacheCreateInfo.initialDataSize = pipelineCacheBlob.size();
-            pipelineCacheCreateInfo.pInitialData = pipelineCacheBlob.data();
-        }
-
-        vkCreatePipelineCache(m_Context.GetDevice(), &pipelineCacheCreateInfo, nullptr, &pipelineCache);
-    }
+    //Load the Pipeline Cache if present, and valid for this device
+    VKR::VkPipelineCacheManager pipelineCacheManager;
+    pipelineCacheManager.Create(m_Context, PIPELINE_CACHE_PATH);
 
     //Create the Graphics Pipeline
     {
@@ -205,23 +198,15 @@ void Samples::HelloTriangleApp::Init(const VKR::Window& window)
 
         VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo = builder.BuildGraphicsPipeline(m_PipelineLayout, m_RenderPass, 0);
 
-        m_Context.CreateGraphicsPipelines(1, &graphicsPipelineCreateInfo, pipelineCache, &m_Pipeline);
+        pipelineCacheManager.CreateGraphicsPipelines(m_Context, 1, &graphicsPipelineCreateInfo, &m_Pipeline);
 
         m_Context.DestroyShaderModule(vertexShaderModule);
         m_Context.DestroyShaderModule(fragmentShaderModule);
 
         //Write the Pipeline Cache to disk 
-        if(!VKR::IO::FileExists(PIPELINE_CACHE_PATH))
-        {
-            Log::Message("Saving Pipeline Cache.\n"); 
-            uint64_t cacheDataSize = 0;
-            vkGetPipelineCacheData(m_Context.GetDevice(), pipelineCache, &cacheDataSize, nullptr);
-            std::vector<char> cacheData(cacheDataSize);
-            vkGetPipelineCacheData(m_Context.GetDevice(), pipelineCache, &cacheDataSize, cacheData.data());
-
-            VKR::IO::WriteFile(PIPELINE_CACHE_PATH, cacheData.data(), cacheData.size());
-        }
-        vkDestroyPipelineCache(m_Context.GetDevice(), pipelineCache, nullptr);
+        Log::Message("Saving Pipeline Cache.\n"); 
+        pipelineCacheManager.Save(m_Context);
+        pipelineCacheManager.Destroy(m_Context);
     }
 
     Log::Message("Creating Query Pools.\n");
@@ -255,6 +240,10 @@ void Samples::HelloTriangleApp::Update()
 {
     EASY_FUNCTION();
 
+    if (m_bSkipFrame) {
+        return;
+    }
+
     //Begin a render pass
     {
         const VkClearValue clearValues[3] = {   //TODO: Wrap Render Targets in a struct, and include this. 
@@ -268,7 +257,7 @@ void Samples::HelloTriangleApp::Update()
             nullptr,
             m_RenderPass,
             m_FrameBuffers[m_ImageIndex],
-            {0, 0, 600, 400},   //TODO: Hook in Swapchain Extents
+            m_Scissor,
             3,
             clearValues
         };
@@ -296,14 +285,28 @@ void Samples::HelloTriangleApp::BeginFrame()
     EASY_FUNCTION();
     UpdateFrameCounter();
 
+    //Recreate the swapchain if the window was resized. Anything it replaces is retired once the last submitted frame completes. 
+    if (m_Swapchain.NeedsRecreation()) {
+        m_Swapchain.Recreate(m_Context, m_DeletionQueue, m_FrameContext.GetFrameValue());
+    }
+
     Synchronize();
 
-    //Acquire the next swapchain image index. 
-    vkAcquireNextImageKHR(m_Context.GetDevice(), m_Swapchain.GetSwapchain(), UINT64_MAX, m_sImageAvailable[m_FrameInFlight], VK_NULL_HANDLE, &m_ImageIndex);
+    //Acquire the next swapchain image index. If the swapchain went out of date since, recreate it and try again. 
+    VkResult result = m_Swapchain.AcquireNextImage(m_Context, m_FrameContext.GetImageAvailableSemaphore(), &m_ImageIndex);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+        m_Swapchain.Recreate(m_Context, m_DeletionQueue, m_FrameContext.GetFrameValue());
+        result = m_Swapchain.AcquireNextImage(m_Context, m_FrameContext.GetImageAvailableSemaphore(), &m_ImageIndex);
+    }
+
+    //Skip the frame if there's still no image. Nothing was submitted, so the frame can be begun again. 
+    m_bSkipFrame = (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR);
+    if (m_bSkipFrame) {
+        return;
+    }
 
-    //Allocate a new Command Buffer for this frame. 
-    m_Context.FreeCommandBuffers(m_CommandPool, 1, &m_Commands[m_FrameInFlight]);
-    m_Context.AllocateCommandBuffers(m_CommandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1, &m_Commands[m_FrameInFlight]);
+    //Retrieve a recycled Command Buffer for this frame. 
+    m_FrameContext.AllocateCommandBuffer(m_Context, VK_COMMAND_BUFFER_LEVEL_PRIMARY, &m_Commands[m_FrameInFlight]);
 
     //Begin recording into the new command buffer. 
     const VkCommandBufferBeginInfo beginInfo = {
@@ -324,6 +327,11 @@ void Samples::HelloTriangleApp::EndFrame()
 {
     EASY_FUNCTION();
 
+    //The frame counter isn't advanced, so the same frame is begun again. 
+    if (m_bSkipFrame) {
+        return;
+    }
+
     //Query the pipeline
     vkCmdEndQuery(m_Commands[m_FrameInFlight], m_OcclusionQueryPool, 0);
     vkCmdEndQuery(m_Commands[m_FrameInFlight], m_PipelineQueryPool, 0);
@@ -332,25 +340,8 @@ void Samples::HelloTriangleApp::EndFrame()
     vkEndCommandBuffer(m_Commands[m_FrameInFlight]);
 
 
-    //Submit the command buffer to the queue. 
-    {
-        VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT };
-
-        const VkSubmitInfo submitInfo = {
-            VK_STRUCTURE_TYPE_SUBMIT_INFO,
-            nullptr,
-            1,
-            &m_sImageAvailable[m_FrameInFlight],
-            waitStages,
-            1,
-            &m_Commands[m_FrameInFlight],
-            1,
-            &m_sRenderFinished[m_FrameInFlight]
-        };
-
-
-        vkQueueSubmit(m_Queue, 1, &submitInfo, m_fFrameReady[m_FrameInFlight]);
-    }
+    //Submit the command buffer to the queue. This signals the frame's timeline value on completion. 
+    m_FrameContext.Submit(m_Queue, 1, &m_Commands[m_FrameInFlight]);
 
     //Retrieve Pipeline Query Results
     {
@@ -380,7 +371,7 @@ void Samples::HelloTriangleApp::EndFrame()
     }
 
     //Present the image to the screen. 
-    m_Swapchain.Present(m_Queue, m_sRenderFinished[m_FrameInFlight], &m_ImageIndex);
+    m_Swapchain.Present(m_Queue, m_FrameContext.GetRenderFinishedSemaphore(), &m_ImageIndex);
 
     m_FrameCount++; //Update our internal frame counter. 
 }
@@ -391,6 +382,7 @@ void Samples::HelloTriangleApp::Shutdown()
 
     //Wait for all device work to be completed before attempting to destroy any objects. 
     vkDeviceWaitIdle(m_Context.GetDevice());
+    m_DeletionQueue.Flush(m_Context);
 
     m_Context.DestroyQueryPool(m_OcclusionQueryPool);
     m_Context.DestroyQueryPool(m_PipelineQueryPool);
@@ -411,13 +403,7 @@ void Samples::HelloTriangleApp::Shutdown()
         DestroyImageResource(m_RenderTargets[i]);
     }
 
-    for (uint32_t i = 0; i < FRAMES_IN_FLIGHT; i++) {
-        m_Context.DestroyFence(m_fFrameReady[i]);
-        m_Context.DestroySemaphore(m_sImageAvailable[i]);
-        m_Context.DestroySemaphore(m_sRenderFinished[i]);
-    }
-
-    m_Context.DestroyCommandPool(m_CommandPool);
+    m_FrameContext.Destroy(m_Context);
 
     //Destroy Vulkan Context and Swapchain
     m_Swapchain.Destroy(m_Context);
@@ -451,9 +437,11 @@ void Samples::HelloTriangleApp::UpdateFrameCounter()
 void Samples::HelloTriangleApp::Synchronize()
 {
     EASY_FUNCTION();
-    //Wait on a fence for the next frame to be available for processing.
-    vkWaitForFences(m_Context.GetDevice(), 1, &m_fFrameReady[m_FrameInFlight], VK_TRUE, UINT64_MAX);
-    vkResetFences(m_Context.GetDevice(), 1, &m_fFrameReady[m_FrameInFlight]);
+    //Wait for the next frame to be available for processing, and recycle its Command Buffers.
+    m_FrameContext.BeginFrame(m_Context, m_FrameInFlight);
+
+    //Destroy any retired resources the GPU has finished with.
+    m_DeletionQueue.Collect(m_Context, m_FrameContext.GetCompletedValue(m_Context));
 
 }
 
@@ -498,6 +486,7 @@ void Samples::HelloTriangleApp::DrawGUI()
             ImGui::Text("DeltaTime (ms): %f", m_DeltaTime);
             ImGui::Text("FPS: %d", m_FPS);
             ImGui::Text("Runtime (s): %f", m_RunTime);
+            ImGui::Text("CPU Wait (ms): %f", m_FrameContext.GetCPUWaitTime());
         }
         if (bShowHardwareInfo) {
             ImGui::Separator(); 
@@ -550,18 +539,20 @@ void Samples::HelloTriangleApp::DrawGUI()
     m_ImGuiRenderer.Draw(&m_Commands[m_FrameInFlight]);
 }
 
-void Samples::HelloTriangleApp::CreateColourRenderTarget(const VkExtent2D extents, const VkFormat format, const VkImageUsageFlagBits usage, const VkSampleCountFlagBits MSAASamples, ImageResource* pRenderTargetResource)
+void Samples::HelloTriangleApp::CreateColourRenderTarget(const VkExtent2D extents, const VkFormat format, const VkImageUsageFlags usage, const VkSampleCountFlagBits MSAASamples, ImageResource* pRenderTargetResource)
 {
     EASY_FUNCTION();
-    m_Context.CreateImage(VK_IMAGE_TYPE_2D, { extents.width, extents.height, 1 }, MSAASamples, format, VK_IMAGE_TILING_OPTIMAL, usage, VMA_MEMORY_USAGE_AUTO, 0, &pRenderTargetResource->allocation, &pRenderTargetResource->image);
+    const VmaMemoryUsage memoryUsage = (usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) ? VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED : VMA_MEMORY_USAGE_AUTO;
+    m_Context.CreateImage(VK_IMAGE_TYPE_2D, { extents.width, extents.height, 1 }, MSAASamples, format, VK_IMAGE_TILING_OPTIMAL, usage, memoryUsage, 0, &pRenderTargetResource->allocation, &pRenderTargetResource->image);
 
     m_Context.CreateImageView(pRenderTargetResource->image, format, VK_IMAGE_ASPECT_COLOR_BIT, &pRenderTargetResource->view);
 }
 
-void Samples::HelloTriangleApp::CreateDepthRenderTarget(const VkExtent2D extents, const VkFormat format, const VkImageUsageFlagBits usage, const VkSampleCountFlagBits MSAASamples, ImageResource* pRenderTargetResource)
+void Samples::HelloTriangleApp::CreateDepthRenderTarget(const VkExtent2D extents, const VkFormat format, const VkImageUsageFlags usage, const VkSampleCountFlagBits MSAASamples, ImageResource* pRenderTargetResource)
 {
     EASY_FUNCTION();
-    m_Context.CreateImage(VK_IMAGE_TYPE_2D, { extents.width, extents.height, 1 }, MSAASamples, format, VK_IMAGE_TILING_OPTIMAL, usage, VMA_MEMORY_USAGE_AUTO, 0, &pRenderTargetResource->allocation, &pRenderTargetResource->image);
+    const VmaMemoryUsage memoryUsage = (usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) ? VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED : VMA_MEMORY_USAGE_AUTO;
+    m_Context.CreateImage(VK_IMAGE_TYPE_2D, { extents.width, extents.height, 1 }, MSAASamples, format, VK_IMAGE_TILING_OPTIMAL, usage, memoryUsage, 0, &pRenderTargetResource->allocation, &pRenderTargetResource->image);
 
     m_Context.CreateImageView(pRenderTargetResource->image, format, VK_IMAGE_ASPECT_DEPTH_BIT, &pRenderTargetResource->view);
 }
@@ -577,31 +568,10 @@ void Samples::HelloTriangleApp::CreateSwapchain(const Window& window, VkSampleCo
 {
     EASY_FUNCTION();
     Log::Message("Creating Swapchain.\n");
-    //TODO: Release old resources if present. 
-
-    const VkExtent2D extents = {
-        window.GetWidth(),
-        window.GetHeight()
-    };
 
     m_Swapchain.Create(m_Context, &window, m_QueueFamilyIndex);
-    //Create the Render Pass, and its resources
+    //Create the Render Pass. Its formats don't depend on the swapchain's size, so it outlives recreation. 
     {
-        m_Viewport.x = 0;
-        m_Viewport.y = 0; // -static_cast<float>(extents.height);
-        m_Viewport.width = (float)extents.width;
-        m_Viewport.height = (float)extents.height;
-        m_Viewport.minDepth = 0.0f;
-        m_Viewport.maxDepth = 1.0f;
-
-        m_Scissor.offset = { 0, 0 };
-        m_Scissor.extent = extents;
-
-        m_RenderTargets.resize(3);
-        CreateColourRenderTarget(extents, VK_FORMAT_B8G8R8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, samples, &m_RenderTargets[0]);  //Colour Attachment
-        CreateDepthRenderTarget(extents, VkHelpers::FindDepthFormat(m_Context.GetPhysicalDevice()), VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, samples, &m_RenderTargets[1]);   //Depth Attachment
-        CreateColourRenderTarget(extents, VK_FORMAT_B8G8R8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_SAMPLE_COUNT_1_BIT, &m_RenderTargets[2]);   //Resolve Attachment
-
         //Describe our Image Attachments.
         std::vector<VkAttachmentDescription> attachmentDescs(3);
         {
@@ -610,7 +580,7 @@ void Samples::HelloTriangleApp::CreateSwapchain(const Window& window, VkSampleCo
                 VK_FORMAT_B8G8R8A8_UNORM,
                 samples,
                 VK_ATTACHMENT_LOAD_OP_CLEAR,
-                VK_ATTACHMENT_STORE_OP_STORE,
+                VK_ATTACHMENT_STORE_OP_DONT_CARE,
                 VK_ATTACHMENT_LOAD_OP_DONT_CARE,
                 VK_ATTACHMENT_STORE_OP_DONT_CARE,
                 VK_IMAGE_LAYOUT_UNDEFINED,
@@ -622,7 +592,7 @@ void Samples::HelloTriangleApp::CreateSwapchain(const Window& window, VkSampleCo
                 VkHelpers::FindDepthFormat(m_Context.GetPhysicalDevice()),
                 samples,
                 VK_ATTACHMENT_LOAD_OP_CLEAR,
-                VK_ATTACHMENT_STORE_OP_STORE,
+                VK_ATTACHMENT_STORE_OP_DONT_CARE,
                 VK_ATTACHMENT_LOAD_OP_DONT_CARE,
                 VK_ATTACHMENT_STORE_OP_DONT_CARE,
                 VK_IMAGE_LAYOUT_UNDEFINED,
@@ -693,6 +663,38 @@ void Samples::HelloTriangleApp::CreateSwapchain(const Window& window, VkSampleCo
         m_Context.CreateRenderPass(attachmentDescs.size(), attachmentDescs.data(), 1, &subpassDesc, 1, &subpassDependency, &m_RenderPass);
     }
 
+    CreateRenderTargets(m_Swapchain.GetExtent());
+
+    //Rebuild the render targets when the swapchain is resized. The old ones may still be in use by frames in flight. 
+    m_Swapchain.AddRecreateCallback([this](const VkContext& context, const VkSwapchain& swapchain, VkDeletionQueue& deletionQueue, const uint64_t retireValue) {
+        RetireRenderTargets(deletionQueue, retireValue);
+        CreateRenderTargets(swapchain.GetExtent());
+    });
+
+    //Hook in ImGui
+    m_ImGuiRenderer.Hook(m_Context, m_QueueFamilyIndex, m_Queue, VK_NULL_HANDLE, m_Swapchain.GetImageCount(), m_RenderPass, samples);
+}
+
+void Samples::HelloTriangleApp::CreateRenderTargets(const VkExtent2D extents)
+{
+    EASY_FUNCTION();
+
+    m_Viewport.x = 0;
+    m_Viewport.y = 0; // -static_cast<float>(extents.height);
+    m_Viewport.width = (float)extents.width;
+    m_Viewport.height = (float)extents.height;
+    m_Viewport.minDepth = 0.0f;
+    m_Viewport.maxDepth = 1.0f;
+
+    m_Scissor.offset = { 0, 0 };
+    m_Scissor.extent = extents;
+
+    m_RenderTargets.resize(3);
+    //The MSAA Colour and Depth Attachments are resolved or discarded within the Render Pass, so are never backed by memory on tile-based GPUs. 
+    CreateColourRenderTarget(extents, VK_FORMAT_B8G8R8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT, m_MSAASamples, &m_RenderTargets[0]);  //Colour Attachment
+    CreateDepthRenderTarget(extents, VkHelpers::FindDepthFormat(m_Context.GetPhysicalDevice()), VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT, m_MSAASamples, &m_RenderTargets[1]);   //Depth Attachment
+    CreateColourRenderTarget(extents, VK_FORMAT_B8G8R8A8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_SAMPLE_COUNT_1_BIT, &m_RenderTargets[2]);   //Resolve Attachment
+
     //Create the Framebuffers
     {
         //Retrieve image view references for our colour attachments
@@ -702,8 +704,22 @@ void Samples::HelloTriangleApp::CreateSwapchain(const Window& window, VkSampleCo
             m_Context.CreateFrameBuffer({ extents.width, extents.height, 1 }, m_RenderPass, 3, attachments, &m_FrameBuffers[i]);
         }
     }
-
-    //Hook in ImGui
-    m_ImGuiRenderer.Hook(m_Context, m_QueueFamilyIndex, m_Queue, VK_NULL_HANDLE, m_Swapchain.GetImageCount(), m_RenderPass, samples);
 }
 
+void Samples::HelloTriangleApp::RetireRenderTargets(VkDeletionQueue& deletionQueue, const uint64_t retireValue)
+{
+    EASY_FUNCTION();
+
+    deletionQueue.Push(retireValue, [renderTargets = m_RenderTargets, frameBuffers = m_FrameBuffers](const VkContext& context) mutable {
+        for (auto& frameBuffer : frameBuffers) {
+            context.DestroyFrameBuffer(frameBuffer);
+        }
+        for (auto& renderTarget : renderTargets) {
+            context.DestroyImageView(renderTarget.view);
+            context.DestroyImage(renderTarget.image, renderTarget.allocation);
+        }
+    });
+
+    m_RenderTargets.clear();
+    m_FrameBuffers.clear();
+}
@@ -4,6 +4,8 @@
 #include <VKR/Timer.h>
 #include <VKR/Vulkan/VkContext.h>
 #include <VKR/Vulkan/VkSwapchain.h>
+#include <VKR/Vulkan/VkFrameContext.h>
+#include <VKR/Vulkan/VkDeletionQueue.h>
 #include <VKR/Vulkan/VkImGui.h>
 
 namespace Samples
@@ -62,13 +64,18 @@ namespace Samples
 
         void DrawGUI();
 
-        void CreateColourRenderTarget(const VkExtent2D extents, const VkFormat format, const VkImageUsageFlagBits usage, const VkSampleCountFlagBits MSAASamples, ImageResource* pRenderTargetResource);
-        void CreateDepthRenderTarget(const VkExtent2D extents, const VkFormat format, const VkImageUsageFlagBits usage, const VkSampleCountFlagBits MSAASamples, ImageResource* pRenderTargetResource);
+        //Render Targets with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT are lazily allocated, where the device supports it. 
+        void CreateColourRenderTarget(const VkExtent2D extents, const VkFormat format, const VkImageUsageFlags usage, const VkSampleCountFlagBits MSAASamples, ImageResource* pRenderTargetResource);
+        void CreateDepthRenderTarget(const VkExtent2D extents, const VkFormat format, const VkImageUsageFlags usage, const VkSampleCountFlagBits MSAASamples, ImageResource* pRenderTargetResource);
 
         void DestroyImageResource(ImageResource& resource);
 
         void CreateSwapchain(const VKR::Window& window, VkSampleCountFlagBits samples);
 
+        //Creates the Render Targets and Framebuffers at the swapchain's size, and retires them when it's recreated. 
+        void CreateRenderTargets(const VkExtent2D extents);
+        void RetireRenderTargets(VKR::VkDeletionQueue& deletionQueue, const uint64_t retireValue);
+
     private:
         VKR::Timer m_Timer;
 
@@ -80,12 +87,10 @@ namespace Samples
 
         uint64_t m_FrameInFlight;
         uint32_t m_ImageIndex;
+        bool m_bSkipFrame;      //Set when no swapchain image could be acquired, so nothing is recorded or submitted this frame. 
 
-        std::vector<VkFence> m_fFrameReady;
-        std::vector<VkSemaphore> m_sImageAvailable;
-        std::vector<VkSemaphore> m_sRenderFinished;
-
-        VkCommandPool m_CommandPool;
+        VKR::VkFrameContext m_FrameContext;
+        VKR::VkDeletionQueue m_DeletionQueue;
         std::vector<VkCommandBuffer> m_Commands;
 
         VkRenderPass m_RenderPass;
@@ -17,7 +17,7 @@ int main() {
 
     //Create a Window. 
     VKR::Window window;
-    window.Create("VKR Sample 01 - Hello Triangle", WINDOW_WIDTH, WINDOW_HEIGHT);
+    window.Create("VKR Sample 01 - Hello Triangle", WINDOW_WIDTH, WINDOW_HEIGHT, true);
     //Set the window icon.
     {
         GLFWimage icon;
@@ -30,6 +30,12 @@ int main() {
 
     //Run the Render Loop
     while (window.PollEvents()) {
+        //Nothing can be presented while minimized. 
+        if (window.IsMinimized()) {
+            window.WaitEvents();
+            continue;
+        }
+
         demoApp.BeginFrame();
 
         demoApp.Update();
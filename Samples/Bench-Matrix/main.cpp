@@ -0,0 +1,122 @@
+/**
+*   @file main.cpp
+*   @brief Microbenchmark for the Matrix4x4<float> kernels.
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/18
+*/
+#include <VKR/Maths.h>
+#include <VKR/Random.h>
+#include <VKR/Timer.h>
+#include <vector>
+#include <cstdio>
+
+//Built twice, with and without VKR_NO_SIMD, so the scalar and SIMD paths can be compared on the same machine.
+#if VKR_SIMD_AVX
+constexpr const char* SIMD_PATH = "AVX";
+#elif VKR_SIMD_SSE
+constexpr const char* SIMD_PATH = "SSE";
+#elif VKR_SIMD_NEON
+constexpr const char* SIMD_PATH = "NEON";
+#else
+constexpr const char* SIMD_PATH = "Scalar";
+#endif
+
+constexpr size_t MATRIX_COUNT = 4096;       //Small enough to stay in cache, so the kernels are measured rather than memory.
+constexpr uint32_t ITERATIONS = 2000;
+
+using Matrix = VKR::Math::Matrix4x4<float>;
+
+//Times 'func' over every iteration, and prints the mean time per element.
+template<typename Func>
+static void Run(const char* name, const size_t elementCount, Func&& func)
+{
+    func();     //Warm up caches and branch predictors.
+
+    VKR::Timer timer;
+    timer.Reset();
+    timer.Start();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        func();
+    }
+    timer.Tick();
+
+    const double nsPerElement = (timer.Duration() * 1e9) / (static_cast<double>(ITERATIONS) * elementCount);
+    printf("%-24s %10.3f ns\n", name, nsPerElement);
+}
+
+//Prevents results being optimized away.
+static float Checksum(const std::vector<Matrix>& matrices)
+{
+    float sum = 0.0f;
+    for (const auto& matrix : matrices) {
+        for (uint32_t i = 0; i < 16; i++) {
+            sum += matrix.arr[i];
+        }
+    }
+    return sum;
+}
+
+int main() {
+    VKR::RNG rng(1234);
+
+    std::vector<Matrix> lhs(MATRIX_COUNT), rhs(MATRIX_COUNT), out(MATRIX_COUNT);
+    for (size_t i = 0; i < MATRIX_COUNT; i++) {
+        for (uint32_t j = 0; j < 16; j++) {
+            lhs[i].arr[j] = rng.Get<float>(-1.0f, 1.0f);
+            rhs[i].arr[j] = rng.Get<float>(-1.0f, 1.0f);
+        }
+    }
+
+    std::vector<float> positionX(MATRIX_COUNT), positionY(MATRIX_COUNT), positionZ(MATRIX_COUNT);
+    std::vector<float> rotationX(MATRIX_COUNT), rotationY(MATRIX_COUNT), rotationZ(MATRIX_COUNT);
+    std::vector<float> scale(MATRIX_COUNT);
+    for (size_t i = 0; i < MATRIX_COUNT; i++) {
+        positionX[i] = rng.Get<float>(-100.0f, 100.0f);
+        positionY[i] = rng.Get<float>(-100.0f, 100.0f);
+        positionZ[i] = rng.Get<float>(-100.0f, 100.0f);
+        rotationX[i] = rng.Get<float>(-3.14f, 3.14f);
+        rotationY[i] = rng.Get<float>(-3.14f, 3.14f);
+        rotationZ[i] = rng.Get<float>(-3.14f, 3.14f);
+        scale[i] = rng.Get<float>(0.5f, 2.0f);
+    }
+
+    const VKR::Math::TransformSoA transforms = {
+        positionX.data(), positionY.data(), positionZ.data(),
+        rotationX.data(), rotationY.data(), rotationZ.data(),
+        scale.data(), scale.data(), scale.data()
+    };
+
+    printf("Matrix4x4<float> kernels (%s), %zu matrices x %u iterations, per matrix:\n", SIMD_PATH, MATRIX_COUNT, ITERATIONS);
+
+    float checksum = 0.0f;
+
+    Run("Multiply", MATRIX_COUNT, [&]() {
+        for (size_t i = 0; i < MATRIX_COUNT; i++) {
+            out[i] = lhs[i] * rhs[i];
+        }
+    });
+    checksum += Checksum(out);
+
+    Run("Transpose", MATRIX_COUNT, [&]() {
+        for (size_t i = 0; i < MATRIX_COUNT; i++) {
+            out[i] = Matrix::Transpose(lhs[i]);
+        }
+    });
+    checksum += Checksum(out);
+
+    Run("Inverse", MATRIX_COUNT, [&]() {
+        bool inverseExists = false;
+        for (size_t i = 0; i < MATRIX_COUNT; i++) {
+            out[i] = Matrix::Inverse(lhs[i], inverseExists);
+        }
+    });
+    checksum += Checksum(out);
+
+    Run("BuildWorldMatrices", MATRIX_COUNT, [&]() {
+        VKR::Math::BuildWorldMatrices(transforms, 0, MATRIX_COUNT, out.data());
+    });
+    checksum += Checksum(out);
+
+    printf("Checksum: %f\n", checksum);
+    return 0;
+}
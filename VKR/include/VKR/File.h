@@ -7,6 +7,7 @@
 *   @date 2024/02/23
 */
 #include <cstdio> 
+#include <cstdint>
 #include "Types.h"
 #include <vector> 
 
@@ -37,6 +38,16 @@ namespace VKR {
         */
         Status WriteFile(const char* filePath, const void* pData, const size_t size);
 
+        /**
+         * @brief Writes an image to a PNG file. 
+         * @param filePath Path to the file to write into. 
+         * @param width The image's width in pixels. 
+         * @param height The image's height in pixels. 
+         * @param pPixels Tightly packed 8-bit RGBA pixels. 
+         * @return SUCCESS on successful write, FAILED otherwise. 
+        */
+        Status WritePNG(const char* filePath, const uint32_t width, const uint32_t height, const void* pPixels);
+
 
         Status CreateDirectory(const char* dirPath);
         Status RemoveDirectory(const char* dirPath);
@@ -0,0 +1,201 @@
+#ifndef __VKRENDERER_JOBS_H
+#define __VKRENDERER_JOBS_H
+/**
+*   @file Jobs.h
+*   @brief Multithreaded Job System
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/05
+*/
+#include "Types.h"
+#include <TaskScheduler.h>
+#include <functional>
+#include <list>
+#include <cstdint>
+
+namespace VKR {
+
+    /**
+     * @brief Scheduling priority of a Job. Higher priority Jobs are always started first.
+    */
+    enum class EJobPriority {
+        High = 0,       //Frame-critical work, e.g. recording. The default.
+        Medium,
+        Low,            //Background work which may take several frames, e.g. Pipeline compilation.
+    };
+
+    /**
+     * @brief Base class for work which can be scheduled by the Job System.
+     * @note Jobs must outlive their execution, and must not be destroyed while any dependent Job is pending.
+    */
+    class IJob {
+    public:
+        virtual ~IJob() = default;
+
+        /**
+         * @brief Prevents this Job from starting until 'dependency' has completed.
+         * @param dependency The Job to wait on.
+         * @note Jobs with dependencies are started automatically when their dependencies complete, and should not be passed to Jobs::Run().
+        */
+        void DependsOn(const IJob& dependency);
+
+        /**
+         * @brief Removes all dependencies from this Job.
+        */
+        void ClearDependencies();
+
+        /**
+         * @brief Returns true once this Job has finished executing.
+        */
+        bool IsComplete() const;
+
+    protected:
+        friend class Jobs;
+        virtual void Submit(enki::TaskScheduler& scheduler) = 0;
+        virtual enki::ICompletable* GetCompletable() = 0;
+        virtual const enki::ICompletable* GetCompletable() const = 0;
+
+    private:
+        std::list<enki::Dependency> m_Dependencies;
+    };
+
+
+    /**
+     * @brief A Job which executes a function over the range [0, count), split across worker threads.
+    */
+    class Job : public IJob {
+    public:
+        /**
+         * @brief Function invoked for each partition of the range.
+         * @param start First index of the partition.
+         * @param end One past the last index of the partition.
+         * @param threadIndex Index of the executing thread, in [0, Jobs::NumThreads()).
+        */
+        using Function = std::function<void(uint32_t start, uint32_t end, uint32_t threadIndex)>;
+
+        /**
+         * @brief Creates a Job which executes once, on any thread.
+        */
+        Job(const std::function<void(uint32_t threadIndex)>& func);
+
+        /**
+         * @brief Creates a Job which executes over a range of elements.
+         * @param count The number of elements in the range.
+         * @param func The function to invoke for each partition.
+         * @param minRange The smallest partition to split the range into.
+        */
+        Job(const uint32_t count, const Function& func, const uint32_t minRange = 1);
+
+        /**
+         * @brief Sets the Job's priority. Must be called before the Job is run.
+        */
+        void SetPriority(const EJobPriority priority);
+
+    protected:
+        void Submit(enki::TaskScheduler& scheduler) override;
+        enki::ICompletable* GetCompletable() override;
+        const enki::ICompletable* GetCompletable() const override;
+
+    private:
+        class Task : public enki::ITaskSet {
+        public:
+            void ExecuteRange(enki::TaskSetPartition range, uint32_t threadnum) override;
+            Function m_Function;
+        };
+
+        Task m_Task;
+    };
+
+
+    /**
+     * @brief A Job which always executes on a specific thread.
+     * @note Jobs pinned to thread 0 (the main thread) only execute within Jobs::RunPinnedJobs() or Jobs::Wait().
+    */
+    class PinnedJob : public IJob {
+    public:
+        PinnedJob(const uint32_t threadIndex, const std::function<void()>& func);
+
+    protected:
+        void Submit(enki::TaskScheduler& scheduler) override;
+        enki::ICompletable* GetCompletable() override;
+        const enki::ICompletable* GetCompletable() const override;
+
+    private:
+        class Task : public enki::IPinnedTask {
+        public:
+            Task(const uint32_t threadIndex);
+            void Execute() override;
+            std::function<void()> m_Function;
+        };
+
+        Task m_Task;
+    };
+
+
+    /**
+     * @brief Job System, built upon the enkiTS task scheduler.
+     * @note Initialized by VKR::Init(), and shut down by VKR::Shutdown().
+    */
+    class Jobs {
+    public:
+        /**
+         * @brief Starts the Job System worker threads.
+         * @param numThreads Total number of threads, including the calling thread. 0 uses every hardware thread.
+         * @return
+        */
+        static Status Init(const uint32_t numThreads = 0);
+
+        /**
+         * @brief Waits for all outstanding Jobs, then stops the worker threads.
+        */
+        static void Shutdown();
+
+        /**
+         * @brief Returns the total number of threads which execute Jobs, including the main thread.
+        */
+        static uint32_t NumThreads();
+
+        /**
+         * @brief Returns the index of the calling thread, in [0, NumThreads()).
+        */
+        static uint32_t ThreadIndex();
+
+        /**
+         * @brief Schedules a Job for execution.
+         * @param job The Job to schedule. Must not have any dependencies.
+        */
+        static void Run(IJob& job);
+
+        /**
+         * @brief Blocks until a Job has completed. The calling thread executes other Jobs while waiting.
+         * @param lowestToRun The lowest priority of other Jobs the calling thread may pick up while waiting.
+        */
+        static void Wait(const IJob& job, const EJobPriority lowestToRun = EJobPriority::Low);
+
+        /**
+         * @brief Blocks until all scheduled Jobs have completed.
+        */
+        static void WaitAll();
+
+        /**
+         * @brief Executes any Jobs pinned to the calling thread.
+        */
+        static void RunPinnedJobs();
+
+        /**
+         * @brief Executes a function over the range [0, count) across all threads, and waits for it to complete.
+         * @remark The calling thread won't pick up Low priority Jobs while waiting, so a long background Job can't stall it.
+         * @param count The number of elements in the range.
+         * @param func The function to invoke for each partition.
+         * @param minRange The smallest partition to split the range into.
+        */
+        static void ParallelFor(const uint32_t count, const Job::Function& func, const uint32_t minRange = 1);
+
+    private:
+        static void OnThreadStart(uint32_t threadIndex);
+
+        static enki::TaskScheduler s_Scheduler;
+        static bool s_bIsInitialized;
+    };
+}
+
+#endif
@@ -13,6 +13,7 @@
 #include "Maths/Vector3.h"
 #include "Maths/Vector4.h"
 #include "Maths/Matrix.h"
+#include "Maths/Transform.h"
 
 namespace VKR {
     namespace Math {
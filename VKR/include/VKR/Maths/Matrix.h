@@ -8,6 +8,9 @@
 */
 #include "Vector3.h"
 #include "Vector4.h"
+#include "SIMD.h"
+#include <cstdint>
+#include <type_traits>
 #include <easy/profiler.h>
 
 namespace VKR {
@@ -28,30 +31,22 @@ namespace VKR {
                 T arr[16];
             };
 
-            friend Matrix4x4 operator *(Matrix4x4& lhs, const Matrix4x4& rhs) {
-                EASY_FUNCTION(profiler::colors::Yellow800);
-                Matrix4x4 mat = {};
-                Matrix4x4 b = Matrix4x4::Transpose(rhs);
-
-                mat.arr[0] = lhs.vec[0].Dot(b.vec[0]);
-                mat.arr[1] = lhs.vec[0].Dot(b.vec[1]);
-                mat.arr[2] = lhs.vec[0].Dot(b.vec[2]);
-                mat.arr[3] = lhs.vec[0].Dot(b.vec[3]);
-
-                mat.arr[4] = lhs.vec[1].Dot(b.vec[0]);
-                mat.arr[5] = lhs.vec[1].Dot(b.vec[1]);
-                mat.arr[6] = lhs.vec[1].Dot(b.vec[2]);
-                mat.arr[7] = lhs.vec[1].Dot(b.vec[3]);
+            friend Matrix4x4 operator *(const Matrix4x4& lhs, const Matrix4x4& rhs) {
+                Matrix4x4 mat;
 
-                mat.arr[8] = lhs.vec[2].Dot(b.vec[0]);
-                mat.arr[9] = lhs.vec[2].Dot(b.vec[1]);
-                mat.arr[10] = lhs.vec[2].Dot(b.vec[2]);
-                mat.arr[11] = lhs.vec[2].Dot(b.vec[3]);
+#if VKR_SIMD_ENABLED
+                if constexpr (std::is_same<T, float>::value) {
+                    SIMD::Multiply4x4(lhs.arr, rhs.arr, mat.arr);
+                    return mat;
+                }
+#endif
 
-                mat.arr[12] = lhs.vec[3].Dot(b.vec[0]);
-                mat.arr[13] = lhs.vec[3].Dot(b.vec[1]);
-                mat.arr[14] = lhs.vec[3].Dot(b.vec[2]);
-                mat.arr[15] = lhs.vec[3].Dot(b.vec[3]);
+                //Row i of lhs dotted with column j of rhs.
+                for (uint8_t i = 0; i < 4; i++) {
+                    for (uint8_t j = 0; j < 4; j++) {
+                        mat.arr[(i * 4) + j] = (lhs.arr[(i * 4) + 0] * rhs.arr[j]) + (lhs.arr[(i * 4) + 1] * rhs.arr[4 + j]) + (lhs.arr[(i * 4) + 2] * rhs.arr[8 + j]) + (lhs.arr[(i * 4) + 3] * rhs.arr[12 + j]);
+                    }
+                }
 
                 return mat;
             }
@@ -228,6 +223,13 @@ namespace VKR {
                 //EASY_FUNCTION(profiler::colors::Yellow800);
                 Matrix4x4 mat = matrix;
 
+#if VKR_SIMD_ENABLED
+                if constexpr (std::is_same<T, float>::value) {
+                    SIMD::Transpose4x4(matrix.arr, mat.arr);
+                    return mat;
+                }
+#endif
+
                 //Preserve 0, 5, 10, 15
                 mat.arr[1] = matrix.arr[4];
                 mat.arr[2] = matrix.arr[8];
@@ -249,6 +251,14 @@ namespace VKR {
             inline static constexpr Matrix4x4 Inverse(const Matrix4x4& matrix, bool& inverseExists) {
                 //EASY_FUNCTION(profiler::colors::Yellow800);
 
+#if VKR_SIMD_ENABLED
+                if constexpr (std::is_same<T, float>::value) {
+                    Matrix4x4 result;
+                    inverseExists = SIMD::Inverse4x4(matrix.arr, result.arr);
+                    return inverseExists ? result : Matrix4x4::Identity();
+                }
+#endif
+
                 Matrix4x4 inv = {};
                 T det;
                 int i;
@@ -0,0 +1,319 @@
+#ifndef __MATH_SIMD_H
+#define __MATH_SIMD_H
+/**
+*   @file SIMD.h
+*   @brief SIMD Kernels for Single-Precision Maths
+*   @author Ewan Burnett (EwanBurnettSK@outlook.com)
+*   @date 2024/05/04
+*   @remark The instruction set is selected at compile time. Define VKR_NO_SIMD to force the scalar fallback.
+*/
+
+//Select the widest instruction set the compiler has been told it can target.
+#if defined(VKR_NO_SIMD)
+#define VKR_SIMD_ENABLED 0
+#elif defined(__AVX__)
+#define VKR_SIMD_AVX 1
+#define VKR_SIMD_SSE 1
+#define VKR_SIMD_ENABLED 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VKR_SIMD_SSE 1
+#define VKR_SIMD_ENABLED 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define VKR_SIMD_NEON 1
+#define VKR_SIMD_ENABLED 1
+#else
+#define VKR_SIMD_ENABLED 0
+#endif
+
+#if defined(VKR_SIMD_AVX)
+#include <immintrin.h>
+#elif defined(VKR_SIMD_SSE)
+#include <emmintrin.h>
+#elif defined(VKR_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#if VKR_SIMD_ENABLED
+namespace VKR {
+    namespace Math {
+        namespace SIMD {
+#if defined(VKR_SIMD_SSE)
+            typedef __m128 Float4;
+
+            inline Float4 Load(const float* p) { return _mm_loadu_ps(p); }
+            inline void Store(float* p, const Float4 v) { _mm_storeu_ps(p, v); }
+            inline Float4 Set(const float x, const float y, const float z, const float w) { return _mm_setr_ps(x, y, z, w); }
+            inline Float4 Add(const Float4 a, const Float4 b) { return _mm_add_ps(a, b); }
+            inline Float4 Sub(const Float4 a, const Float4 b) { return _mm_sub_ps(a, b); }
+            inline Float4 Mul(const Float4 a, const Float4 b) { return _mm_mul_ps(a, b); }
+            inline Float4 Div(const Float4 a, const Float4 b) { return _mm_div_ps(a, b); }
+            inline Float4 Set1(const float x) { return _mm_set1_ps(x); }
+            inline Float4 Min(const Float4 a, const Float4 b) { return _mm_min_ps(a, b); }
+            inline Float4 Max(const Float4 a, const Float4 b) { return _mm_max_ps(a, b); }
+            inline Float4 Round(const Float4 v) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(v)); }   //Rounds to nearest, assuming the default MXCSR rounding mode. 
+            inline float First(const Float4 v) { return _mm_cvtss_f32(v); }
+
+            /**
+             * @brief Selects lanes (X, Y) from a, and (Z, W) from b. Equivalent to _mm_shuffle_ps.
+            */
+            template<int X, int Y, int Z, int W>
+            inline Float4 Shuffle(const Float4 a, const Float4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X)); }
+
+            inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+
+#elif defined(VKR_SIMD_NEON)
+            typedef float32x4_t Float4;
+
+            inline Float4 Load(const float* p) { return vld1q_f32(p); }
+            inline void Store(float* p, const Float4 v) { vst1q_f32(p, v); }
+            inline Float4 Set(const float x, const float y, const float z, const float w) { const float v[4] = { x, y, z, w }; return vld1q_f32(v); }
+            inline Float4 Add(const Float4 a, const Float4 b) { return vaddq_f32(a, b); }
+            inline Float4 Sub(const Float4 a, const Float4 b) { return vsubq_f32(a, b); }
+            inline Float4 Mul(const Float4 a, const Float4 b) { return vmulq_f32(a, b); }
+            inline Float4 Div(const Float4 a, const Float4 b) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+                return vdivq_f32(a, b);
+#else
+                float x[4], y[4];
+                vst1q_f32(x, a);
+                vst1q_f32(y, b);
+                return Set(x[0] / y[0], x[1] / y[1], x[2] / y[2], x[3] / y[3]);
+#endif
+            }
+            inline Float4 Set1(const float x) { return vdupq_n_f32(x); }
+            inline Float4 Min(const Float4 a, const Float4 b) { return vminq_f32(a, b); }
+            inline Float4 Max(const Float4 a, const Float4 b) { return vmaxq_f32(a, b); }
+            inline Float4 Round(const Float4 v) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+                return vrndnq_f32(v);
+#else
+                //Bias away from zero, then truncate.
+                const Float4 bias = vbslq_f32(vcgeq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(0.5f), vdupq_n_f32(-0.5f));
+                return vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(v, bias)));
+#endif
+            }
+            inline float First(const Float4 v) { return vgetq_lane_f32(v, 0); }
+
+            inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) {
+                const float32x4x2_t t0 = vzipq_f32(r0, r2);
+                const float32x4x2_t t1 = vzipq_f32(r1, r3);
+                const float32x4x2_t lo = vzipq_f32(t0.val[0], t1.val[0]);
+                const float32x4x2_t hi = vzipq_f32(t0.val[1], t1.val[1]);
+                r0 = lo.val[0];
+                r1 = lo.val[1];
+                r2 = hi.val[0];
+                r3 = hi.val[1];
+            }
+
+            /**
+             * @brief Selects lanes (X, Y) from a, and (Z, W) from b. Equivalent to _mm_shuffle_ps.
+            */
+            template<int X, int Y, int Z, int W>
+            inline Float4 Shuffle(const Float4 a, const Float4 b) {
+                Float4 r = vdupq_n_f32(vgetq_lane_f32(a, X));
+                r = vsetq_lane_f32(vgetq_lane_f32(a, Y), r, 1);
+                r = vsetq_lane_f32(vgetq_lane_f32(b, Z), r, 2);
+                r = vsetq_lane_f32(vgetq_lane_f32(b, W), r, 3);
+                return r;
+            }
+#endif
+
+            /**
+             * @brief Broadcasts lane I of v into every lane.
+            */
+            template<int I>
+            inline Float4 Splat(const Float4 v) {
+#if defined(VKR_SIMD_NEON)
+                return vdupq_n_f32(vgetq_lane_f32(v, I));
+#else
+                return Shuffle<I, I, I, I>(v, v);
+#endif
+            }
+
+            /**
+             * @brief Computes the Sine and Cosine of each lane.
+             * @param radians Input angles, in Radians.
+             * @param sin Receives the Sine of each lane.
+             * @param cos Receives the Cosine of each lane.
+             * @remark Range reduction is performed in single precision, so accuracy degrades for very large angles.
+            */
+            inline void SinCos(const Float4 radians, Float4& sin, Float4& cos) {
+                const Float4 pi = Set1(3.14159265358979f);
+                const Float4 halfPi = Set1(1.57079632679490f);
+                const Float4 invTwoPi = Set1(0.159154943091895f);
+                const Float4 twoPi = Set1(6.28318530717959f);
+
+                //2*pi split into an exactly representable high part, and a low part (Cody-Waite reduction).
+                const Float4 twoPiHi = Set1(6.28125f);
+                const Float4 twoPiLo = Set1(1.93530717958647e-3f);
+
+                //Evaluates sin(x) for x in [-pi, pi], by reflecting x into [-pi/2, pi/2].
+                auto sinReduced = [&](Float4 x) {
+                    x = Max(Min(x, Sub(pi, x)), Sub(Sub(Set1(0.0f), pi), x));
+                    const Float4 x2 = Mul(x, x);
+
+                    //Taylor series to x^11
+                    Float4 p = Set1(-2.50521083854417e-8f);
+                    p = Add(Mul(p, x2), Set1(2.75573192239859e-6f));
+                    p = Add(Mul(p, x2), Set1(-1.98412698412698e-4f));
+                    p = Add(Mul(p, x2), Set1(8.33333333333333e-3f));
+                    p = Add(Mul(p, x2), Set1(-1.66666666666667e-1f));
+                    p = Add(Mul(p, x2), Set1(1.0f));
+                    return Mul(p, x);
+                };
+
+                //Wrap into [-pi, pi]
+                const Float4 k = Round(Mul(radians, invTwoPi));
+                const Float4 s = Sub(Sub(radians, Mul(k, twoPiHi)), Mul(k, twoPiLo));
+                Float4 c = Add(s, halfPi);
+                c = Sub(c, Mul(Round(Mul(c, invTwoPi)), twoPi));
+
+                sin = sinReduced(s);
+                cos = sinReduced(c);
+            }
+
+            /**
+             * @brief Computes out = a * b for two row-major 4x4 matrices.
+             * @remark Each output row is accumulated as ((a0 * b0 + a1 * b1) + a2 * b2) + a3 * b3, which matches the evaluation order of the scalar path.
+            */
+            inline void Multiply4x4(const float* a, const float* b, float* out) {
+#if defined(VKR_SIMD_AVX)
+                //Duplicate each row of b into both 128-bit lanes, and process two rows of a per iteration.
+                const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 0));
+                const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+                const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+                const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+
+                for (int i = 0; i < 16; i += 8) {
+                    const __m256 rows = _mm256_loadu_ps(a + i);
+                    __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+                    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+                    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+                    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+                    _mm256_storeu_ps(out + i, r);
+                }
+#else
+                const Float4 b0 = Load(b + 0);
+                const Float4 b1 = Load(b + 4);
+                const Float4 b2 = Load(b + 8);
+                const Float4 b3 = Load(b + 12);
+
+                for (int i = 0; i < 16; i += 4) {
+                    const Float4 row = Load(a + i);
+                    Float4 r = Mul(Splat<0>(row), b0);
+                    r = Add(r, Mul(Splat<1>(row), b1));
+                    r = Add(r, Mul(Splat<2>(row), b2));
+                    r = Add(r, Mul(Splat<3>(row), b3));
+                    Store(out + i, r);
+                }
+#endif
+            }
+
+            /**
+             * @brief Transposes a row-major 4x4 matrix. in and out may alias.
+            */
+            inline void Transpose4x4(const float* in, float* out) {
+#if defined(VKR_SIMD_NEON)
+                //De-interleaving loads yield the columns directly.
+                const float32x4x4_t m = vld4q_f32(in);
+                vst1q_f32(out + 0, m.val[0]);
+                vst1q_f32(out + 4, m.val[1]);
+                vst1q_f32(out + 8, m.val[2]);
+                vst1q_f32(out + 12, m.val[3]);
+#else
+                __m128 r0 = _mm_loadu_ps(in + 0);
+                __m128 r1 = _mm_loadu_ps(in + 4);
+                __m128 r2 = _mm_loadu_ps(in + 8);
+                __m128 r3 = _mm_loadu_ps(in + 12);
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_storeu_ps(out + 0, r0);
+                _mm_storeu_ps(out + 4, r1);
+                _mm_storeu_ps(out + 8, r2);
+                _mm_storeu_ps(out + 12, r3);
+#endif
+            }
+
+            //2x2 Matrix helpers for Inverse4x4(). Each Float4 holds a row-major 2x2 matrix.
+
+            //A * B
+            inline Float4 Mat2Mul(const Float4 a, const Float4 b) {
+                return Add(Mul(a, Shuffle<0, 3, 0, 3>(b, b)), Mul(Shuffle<1, 0, 3, 2>(a, a), Shuffle<2, 1, 2, 1>(b, b)));
+            }
+
+            //adj(A) * B
+            inline Float4 Mat2AdjMul(const Float4 a, const Float4 b) {
+                return Sub(Mul(Shuffle<3, 3, 0, 0>(a, a), b), Mul(Shuffle<1, 1, 2, 2>(a, a), Shuffle<2, 3, 0, 1>(b, b)));
+            }
+
+            //A * adj(B)
+            inline Float4 Mat2MulAdj(const Float4 a, const Float4 b) {
+                return Sub(Mul(a, Shuffle<3, 0, 3, 0>(b, b)), Mul(Shuffle<1, 0, 3, 2>(a, a), Shuffle<2, 1, 2, 1>(b, b)));
+            }
+
+            /**
+             * @brief Inverts a 4x4 matrix using 2x2 block decomposition.
+             * @param in The matrix to invert.
+             * @param out Receives the inverse. Left untouched if the matrix is singular.
+             * @return false if the matrix has a determinant of 0.
+            */
+            inline bool Inverse4x4(const float* in, float* out) {
+                const Float4 r0 = Load(in + 0);
+                const Float4 r1 = Load(in + 4);
+                const Float4 r2 = Load(in + 8);
+                const Float4 r3 = Load(in + 12);
+
+                //Split into 2x2 sub-matrices | A B |
+                //                            | C D |
+                const Float4 A = Shuffle<0, 1, 0, 1>(r0, r1);
+                const Float4 B = Shuffle<2, 3, 2, 3>(r0, r1);
+                const Float4 C = Shuffle<0, 1, 0, 1>(r2, r3);
+                const Float4 D = Shuffle<2, 3, 2, 3>(r2, r3);
+
+                //Sub-matrix Determinants as (|A|, |B|, |C|, |D|)
+                const Float4 detSub = Sub(
+                    Mul(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+                    Mul(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3))
+                );
+                const Float4 detA = Splat<0>(detSub);
+                const Float4 detB = Splat<1>(detSub);
+                const Float4 detC = Splat<2>(detSub);
+                const Float4 detD = Splat<3>(detSub);
+
+                const Float4 D_C = Mat2AdjMul(D, C);
+                const Float4 A_B = Mat2AdjMul(A, B);
+
+                Float4 X = Sub(Mul(detD, A), Mat2Mul(B, D_C));
+                Float4 W = Sub(Mul(detA, D), Mat2Mul(C, A_B));
+                Float4 Y = Sub(Mul(detB, C), Mat2MulAdj(D, A_B));
+                Float4 Z = Sub(Mul(detC, B), Mat2MulAdj(A, D_C));
+
+                //|M| = |A||D| + |B||C| - tr((A#B)(D#C))
+                Float4 tr = Mul(A_B, Shuffle<0, 2, 1, 3>(D_C, D_C));
+                tr = Add(tr, Shuffle<2, 3, 0, 1>(tr, tr));
+                tr = Add(tr, Shuffle<1, 0, 3, 2>(tr, tr));
+                const Float4 detM = Sub(Add(Mul(detA, detD), Mul(detB, detC)), tr);
+
+                if (First(detM) == 0.0f) {
+                    return false;
+                }
+
+                const Float4 rDetM = Div(Set(1.0f, -1.0f, -1.0f, 1.0f), detM);
+                X = Mul(X, rDetM);
+                Y = Mul(Y, rDetM);
+                Z = Mul(Z, rDetM);
+                W = Mul(W, rDetM);
+
+                //Apply the adjugate swizzle while re-assembling the rows.
+                Store(out + 0, Shuffle<3, 1, 3, 1>(X, Y));
+                Store(out + 4, Shuffle<2, 0, 2, 0>(X, Y));
+                Store(out + 8, Shuffle<3, 1, 3, 1>(Z, W));
+                Store(out + 12, Shuffle<2, 0, 2, 0>(Z, W));
+
+                return true;
+            }
+        }
+    }
+}
+#endif
+
+#endif
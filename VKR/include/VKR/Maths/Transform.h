@@ -0,0 +1,146 @@
+#ifndef __MATH_TRANSFORM_H
+#define __MATH_TRANSFORM_H
+/**
+*   @file Transform.h
+*   @brief Batched World Matrix Composition
+*   @author Ewan Burnett (EwanBurnettSK@outlook.com)
+*   @date 2024/05/04
+*/
+#include "Matrix.h"
+#include "SIMD.h"
+#include <cmath>
+#include <cstddef>
+
+namespace VKR {
+    namespace Math {
+
+        /**
+         * @brief A Structure-of-Arrays view over a set of object transforms.
+         * @note Each array must hold at least as many elements as the range passed to BuildWorldMatrices().
+        */
+        struct TransformSoA {
+            const float* pPositionX;
+            const float* pPositionY;
+            const float* pPositionZ;
+
+            const float* pRotationX;    //Euler angles, in Radians.
+            const float* pRotationY;
+            const float* pRotationZ;
+
+            const float* pScaleX;
+            const float* pScaleY;
+            const float* pScaleZ;
+        };
+
+        /**
+         * @brief Composes World matrices for a range of transforms.
+         * @param transforms The source positions, rotations and scales.
+         * @param first Index of the first transform to compose.
+         * @param count Number of transforms to compose.
+         * @param pWorldMatrices Output array. Elements [first, first + count) are written.
+         * @remark Equivalent to Scaling(s) * (XRotation(r.x) * (YRotation(r.y) * ZRotation(r.z))) * Translation(t),
+         * but builds each matrix directly rather than through generic 4x4 multiplies.
+        */
+        inline void BuildWorldMatrices(const TransformSoA& transforms, const size_t first, const size_t count, Matrix4x4<float>* pWorldMatrices) {
+            size_t i = first;
+            const size_t end = first + count;
+
+#if VKR_SIMD_ENABLED
+            //Compose 4 transforms per iteration, then transpose the results into AoS matrices.
+            for (; i + 4 <= end; i += 4) {
+                SIMD::Float4 sa, ca, sb, cb, sc, cc;
+                SIMD::SinCos(SIMD::Load(transforms.pRotationX + i), sa, ca);
+                SIMD::SinCos(SIMD::Load(transforms.pRotationY + i), sb, cb);
+                SIMD::SinCos(SIMD::Load(transforms.pRotationZ + i), sc, cc);
+
+                const SIMD::Float4 sx = SIMD::Load(transforms.pScaleX + i);
+                const SIMD::Float4 sy = SIMD::Load(transforms.pScaleY + i);
+                const SIMD::Float4 sz = SIMD::Load(transforms.pScaleZ + i);
+
+                const SIMD::Float4 sbcc = SIMD::Mul(sb, cc);
+                const SIMD::Float4 sbsc = SIMD::Mul(sb, sc);
+                const SIMD::Float4 zero = SIMD::Set1(0.0f);
+
+                SIMD::Float4 r0[4] = {
+                    SIMD::Mul(sx, SIMD::Mul(cb, cc)),
+                    SIMD::Mul(sx, SIMD::Mul(cb, sc)),
+                    SIMD::Mul(sx, SIMD::Sub(zero, sb)),
+                    zero
+                };
+
+                SIMD::Float4 r1[4] = {
+                    SIMD::Mul(sy, SIMD::Sub(SIMD::Mul(sa, sbcc), SIMD::Mul(ca, sc))),
+                    SIMD::Mul(sy, SIMD::Add(SIMD::Mul(ca, cc), SIMD::Mul(sa, sbsc))),
+                    SIMD::Mul(sy, SIMD::Mul(sa, cb)),
+                    zero
+                };
+
+                SIMD::Float4 r2[4] = {
+                    SIMD::Mul(sz, SIMD::Add(SIMD::Mul(sa, sc), SIMD::Mul(ca, sbcc))),
+                    SIMD::Mul(sz, SIMD::Sub(SIMD::Mul(ca, sbsc), SIMD::Mul(sa, cc))),
+                    SIMD::Mul(sz, SIMD::Mul(ca, cb)),
+                    zero
+                };
+
+                SIMD::Float4 r3[4] = {
+                    SIMD::Load(transforms.pPositionX + i),
+                    SIMD::Load(transforms.pPositionY + i),
+                    SIMD::Load(transforms.pPositionZ + i),
+                    SIMD::Set1(1.0f)
+                };
+
+                SIMD::Transpose(r0[0], r0[1], r0[2], r0[3]);
+                SIMD::Transpose(r1[0], r1[1], r1[2], r1[3]);
+                SIMD::Transpose(r2[0], r2[1], r2[2], r2[3]);
+                SIMD::Transpose(r3[0], r3[1], r3[2], r3[3]);
+
+                for (uint8_t j = 0; j < 4; j++) {
+                    float* pOut = pWorldMatrices[i + j].arr;
+                    SIMD::Store(pOut + 0, r0[j]);
+                    SIMD::Store(pOut + 4, r1[j]);
+                    SIMD::Store(pOut + 8, r2[j]);
+                    SIMD::Store(pOut + 12, r3[j]);
+                }
+            }
+#endif
+
+            //Compose any remaining transforms one at a time.
+            for (; i < end; i++) {
+                const float sa = std::sin(transforms.pRotationX[i]);
+                const float ca = std::cos(transforms.pRotationX[i]);
+                const float sb = std::sin(transforms.pRotationY[i]);
+                const float cb = std::cos(transforms.pRotationY[i]);
+                const float sc = std::sin(transforms.pRotationZ[i]);
+                const float cc = std::cos(transforms.pRotationZ[i]);
+
+                const float sx = transforms.pScaleX[i];
+                const float sy = transforms.pScaleY[i];
+                const float sz = transforms.pScaleZ[i];
+
+                float* pOut = pWorldMatrices[i].arr;
+
+                pOut[0] = sx * (cb * cc);
+                pOut[1] = sx * (cb * sc);
+                pOut[2] = sx * -sb;
+                pOut[3] = 0.0f;
+
+                pOut[4] = sy * ((sa * (sb * cc)) - (ca * sc));
+                pOut[5] = sy * ((ca * cc) + (sa * (sb * sc)));
+                pOut[6] = sy * (sa * cb);
+                pOut[7] = 0.0f;
+
+                pOut[8] = sz * ((sa * sc) + (ca * (sb * cc)));
+                pOut[9] = sz * ((ca * (sb * sc)) - (sa * cc));
+                pOut[10] = sz * (ca * cb);
+                pOut[11] = 0.0f;
+
+                pOut[12] = transforms.pPositionX[i];
+                pOut[13] = transforms.pPositionY[i];
+                pOut[14] = transforms.pPositionZ[i];
+                pOut[15] = 1.0f;
+            }
+        }
+    }
+}
+
+#endif
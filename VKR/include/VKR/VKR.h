@@ -17,6 +17,7 @@
 #define EASY_FUNCTION(...)
 #define EASY_BLOCK(...)
 #define EASY_END_BLOCK
+#define EASY_THREAD(...)
 #define EASY_THREAD_SCOPE(...)
 #define EASY_PROFILER_ENABLE
 #define EASY_MAIN_THREAD
@@ -34,9 +35,10 @@
 namespace VKR {
     /**
      * @brief Initializes VKR. 
+     * @param headless If true, GLFW uses its null platform, so windows can be created without a display, e.g. on CI. They have no Vulkan surface. 
      * @return 
     */
-    Status Init();
+    Status Init(const bool headless = false);
 
     /**
      * @brief Shuts down VKR. 
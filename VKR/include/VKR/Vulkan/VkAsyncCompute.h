@@ -0,0 +1,92 @@
+#ifndef __VKRENDERER_VKASYNCCOMPUTE_H
+#define __VKRENDERER_VKASYNCCOMPUTE_H
+/**
+*   @file VkAsyncCompute.h
+*   @brief Asynchronous Compute Queue Submission
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/09
+*/
+#include "VkCommon.h"
+#include <vector>
+
+namespace VKR {
+    class VkContext;
+
+    /**
+     * @brief Records and submits per-frame compute work on a separate Queue, so it overlaps rasterization rather than serializing in front of it.
+     * @remark Each submission signals a Timeline Semaphore. Graphics work which consumes compute results waits on the returned token,
+     * and Buffers written by compute are released to the graphics Queue Family with ReleaseBuffer(), then acquired with AcquireResources().
+    */
+    class VkAsyncCompute {
+    public:
+        VkAsyncCompute();
+
+        /**
+         * @brief Creates the per-frame Command Pools and Timeline Semaphore.
+         * @param queueFamilyIndex The Queue Family compute work is submitted to.
+         * @param queue The Queue compute work is submitted to.
+         * @param dstQueueFamilyIndex The Queue Family which consumes compute results. If it differs from queueFamilyIndex, ownership is transferred.
+        */
+        VkResult Create(const VkContext& context, const uint32_t queueFamilyIndex, const VkQueue queue, const uint32_t dstQueueFamilyIndex, const uint32_t framesInFlight);
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Begins recording a frame's compute work.
+         * @remark Blocks until the frame's previous compute submission has completed, then recycles its Command Pool.
+        */
+        VkResult Begin(const VkContext& context, const uint32_t frameIndex, VkCommandBuffer* pCommandBuffer);
+
+        /**
+         * @brief Records a release of a Buffer written by compute shaders, and queues the matching acquire for AcquireResources().
+         * @param dstStageMask The stages the consuming Queue reads the buffer in.
+         * @param dstAccessMask How the consuming Queue reads the buffer.
+        */
+        void ReleaseBuffer(const VkBuffer buffer, const VkDeviceSize offset, const VkDeviceSize size, const VkPipelineStageFlags dstStageMask, const VkAccessFlags dstAccessMask);
+
+        /**
+         * @brief Ends and submits the frame's Command Buffer.
+         * @param pToken Optionally receives the submission's token: the value GetSemaphore() reaches once it completes.
+         * @param numWaitSemaphores Semaphores the submission waits on, e.g. to avoid overwriting data graphics is still reading. Values are ignored for binary semaphores.
+        */
+        VkResult Submit(const VkContext& context, uint64_t* pToken = nullptr, const uint32_t numWaitSemaphores = 0, const VkSemaphore* pWaitSemaphores = nullptr, const uint64_t* pWaitValues = nullptr, const VkPipelineStageFlags* pWaitStageMasks = nullptr);
+
+        /**
+         * @brief Records ownership acquisition for all submitted releases into a command buffer on the consuming Queue Family.
+         * @param pWaitStageMask Receives the stages the consuming submission must wait at.
+         * @return The token the submission containing 'cmd' must wait on, or 0 if no results were released since the last call.
+        */
+        uint64_t AcquireResources(VkCommandBuffer cmd, VkPipelineStageFlags* pWaitStageMask);
+
+        VkResult Wait(const VkContext& context, const uint64_t token, const uint64_t timeout = UINT64_MAX) const;
+
+        const VkSemaphore& GetSemaphore() const;
+        const uint32_t GetQueueFamilyIndex() const;
+
+    private:
+        struct Frame {
+            VkCommandPool pool;
+            VkCommandBuffer cmd;
+            uint64_t token;
+        };
+
+    private:
+        uint32_t m_QueueFamilyIndex;
+        uint32_t m_DstQueueFamilyIndex;
+        VkQueue m_Queue;
+
+        std::vector<Frame> m_Frames;
+        uint32_t m_FrameIndex;
+
+        VkSemaphore m_Semaphore;
+        uint64_t m_NextToken;
+
+        //Acquire halves of queue family ownership transfers, and the stages they are consumed in.
+        std::vector<VkBufferMemoryBarrier> m_PendingBarriers;
+        std::vector<VkBufferMemoryBarrier> m_SubmittedBarriers;
+        VkPipelineStageFlags m_PendingStageMask;
+        VkPipelineStageFlags m_SubmittedStageMask;
+        uint64_t m_SubmittedToken;
+    };
+}
+
+#endif
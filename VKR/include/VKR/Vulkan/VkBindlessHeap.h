@@ -0,0 +1,104 @@
+#ifndef __VKRENDERER_VKBINDLESSHEAP_H
+#define __VKRENDERER_VKBINDLESSHEAP_H
+/**
+*   @file VkBindlessHeap.h
+*   @brief Global Bindless Descriptor Set
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/11
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <mutex>
+
+namespace VKR {
+    class VkContext;
+    class VkLayoutCache;
+
+    enum class EBindlessType {
+        SampledImage = 0,
+        StorageBuffer,
+        Sampler,
+        COUNT
+    };
+
+    /**
+     * @brief A single, global, update-after-bind Descriptor Set holding large partially bound arrays of Sampled Images, Storage Buffers and Samplers.
+     * @remark Resources are registered once and referred to by integer handles, which shaders use to index the arrays directly:
+     *
+     *  layout(set = 0, binding = 0) uniform texture2D textures[];
+     *  layout(set = 0, binding = 1) readonly buffer Buffers { ... } buffers[];
+     *  layout(set = 0, binding = 2) uniform sampler samplers[];
+     *
+     * The set is bound once per command buffer, and handles are passed through push constants or buffers, so draws never bind descriptors.
+     * Requires the descriptor indexing features in MakeRequiredFeatures() to be enabled through VkContext::CreateDevice().
+    */
+    class VkBindlessHeap {
+    public:
+        static constexpr uint32_t INVALID_HANDLE = UINT32_MAX;
+
+        VkBindlessHeap();
+
+        /**
+         * @brief Returns the descriptor indexing features the heap requires, for chaining into VkContext::CreateDevice().
+        */
+        static VkPhysicalDeviceDescriptorIndexingFeatures MakeRequiredFeatures(void* pNext = nullptr);
+
+        /**
+         * @brief Creates the global set. Capacities are clamped to the device's update-after-bind limits.
+         * @param pLayoutCache Optional cache to retrieve the Set Layout from, in which case the cache owns it.
+        */
+        VkResult Create(const VkContext& context, const uint32_t maxSampledImages, const uint32_t maxStorageBuffers, const uint32_t maxSamplers, VkLayoutCache* pLayoutCache = nullptr);
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Writes a resource into the heap. Thread safe.
+         * @return The resource's handle, or INVALID_HANDLE if the heap is full.
+        */
+        uint32_t RegisterSampledImage(const VkContext& context, const VkImageView view, const VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        uint32_t RegisterStorageBuffer(const VkContext& context, const VkBuffer buffer, const VkDeviceSize offset = 0, const VkDeviceSize range = VK_WHOLE_SIZE);
+        uint32_t RegisterSampler(const VkContext& context, const VkSampler sampler);
+
+        /**
+         * @brief Releases a handle once the GPU has finished with it.
+         * @param retireValue The frame timeline value (see VkFrameContext::GetFrameValue()) after which the handle is no longer in use.
+        */
+        void Release(const EBindlessType type, const uint32_t handle, const uint64_t retireValue);
+
+        /**
+         * @brief Recycles released handles whose retire value has been reached.
+         * @param completedValue The frame timeline's completed value (see VkFrameContext::GetCompletedValue()).
+        */
+        void Collect(const uint64_t completedValue);
+
+        /**
+         * @brief Binds the global set. Call once per command buffer, with any pipeline layout created from GetLayout() at 'set'.
+        */
+        void Bind(VkCommandBuffer cmd, const VkPipelineBindPoint bindPoint, const VkPipelineLayout pipelineLayout, const uint32_t set = 0) const;
+
+        const VkDescriptorSetLayout& GetLayout() const;
+        const VkDescriptorSet& GetSet() const;
+        const uint32_t GetCapacity(const EBindlessType type) const;
+
+    private:
+        struct HandleList {
+            uint32_t capacity;
+            uint32_t next;                  //Handles below 'next' have been handed out at least once.
+            std::vector<uint32_t> free;
+            std::vector<std::pair<uint64_t, uint32_t>> retired;     //(retire value, handle)
+        };
+
+        uint32_t AcquireHandle(const EBindlessType type);
+
+    private:
+        VkDescriptorPool m_Pool;
+        VkDescriptorSetLayout m_Layout;
+        VkDescriptorSet m_Set;
+        bool m_OwnsLayout;
+
+        HandleList m_Handles[static_cast<uint32_t>(EBindlessType::COUNT)];
+
+        std::mutex m_Mutex;
+    };
+}
+
+#endif
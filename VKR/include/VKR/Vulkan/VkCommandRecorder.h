@@ -0,0 +1,74 @@
+#ifndef __VKRENDERER_VKCOMMANDRECORDER_H
+#define __VKRENDERER_VKCOMMANDRECORDER_H
+/**
+*   @file VkCommandRecorder.h
+*   @brief Multithreaded Secondary Command Buffer Recording
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/06
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <functional>
+#include <mutex>
+
+namespace VKR {
+    class VkContext;
+
+    /**
+     * @brief Records ranges of work into Secondary Command Buffers across the Job System's threads.
+     * @remark Each thread owns one Command Pool per frame in flight, so recording never contends on a pool.
+    */
+    class VkCommandRecorder {
+    public:
+        /**
+         * @brief Records the partition [start, end) into a Secondary Command Buffer.
+         * @note Secondary Command Buffers do not inherit bound state, so each partition must bind its own pipeline, descriptors and dynamic state.
+        */
+        using RecordFunction = std::function<void(VkCommandBuffer cmd, uint32_t start, uint32_t end)>;
+
+        VkCommandRecorder();
+
+        VkResult Create(const VkContext& context, const uint32_t queueFamilyIndex, const uint32_t framesInFlight);
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Resets every thread's Command Pool for a frame, recycling its Command Buffers.
+         * @param frameIndex The frame in flight to reset. The GPU must have finished executing this frame.
+        */
+        VkResult Reset(const VkContext& context, const uint32_t frameIndex);
+
+        /**
+         * @brief Records [0, count) into Secondary Command Buffers in parallel.
+         * @param inheritanceInfo The Render Pass, Subpass and Framebuffer the commands will execute within. For Dynamic Rendering, a null Render Pass with a chained VkCommandBufferInheritanceRenderingInfo.
+         * @param count The number of elements to record.
+         * @param func The function which records each partition.
+         * @param minRange The smallest number of elements to record into a single Command Buffer. Ranges no larger than this are recorded on the calling thread.
+        */
+        VkResult Record(const VkContext& context, const VkCommandBufferInheritanceInfo& inheritanceInfo, const uint32_t count, const RecordFunction& func, const uint32_t minRange = 1);
+
+        /**
+         * @brief Executes everything recorded since the last call, in submission order.
+         * @param cmd The Primary Command Buffer. Must be within a Render Pass begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, or Dynamic Rendering begun with VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT.
+        */
+        void Execute(VkCommandBuffer cmd);
+
+    private:
+        struct ThreadPool {
+            VkCommandPool pool;
+            std::vector<VkCommandBuffer> buffers;
+            uint32_t numUsed;
+        };
+
+        VkResult AcquireCommandBuffer(const VkContext& context, ThreadPool& threadPool, VkCommandBuffer* pCommandBuffer);
+
+    private:
+        uint32_t m_NumThreads;
+        uint32_t m_FrameIndex;
+        std::vector<ThreadPool> m_ThreadPools;  //Indexed by [frameIndex * m_NumThreads + threadIndex]
+
+        std::mutex m_RecordedMutex;
+        std::vector<VkCommandBuffer> m_Recorded;
+    };
+}
+
+#endif
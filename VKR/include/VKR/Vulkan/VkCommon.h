@@ -13,6 +13,57 @@
 #include <vk_mem_alloc.h>
 
 namespace VKR {
+    /**
+     * @brief A Buffer and its backing memory.
+     * @note pMappedData is only valid for buffers created with VMA_ALLOCATION_CREATE_MAPPED_BIT, and remains valid for the buffer's lifetime.
+    */
+    struct VkBufferResource {
+        VkBuffer buffer;
+        VmaAllocation allocation;
+        VkDeviceSize size;
+        void* pMappedData;
+    };
+
+    /**
+     * @brief Requirements a Physical Device must meet to be considered for selection.
+    */
+    struct VkPhysicalDeviceRequirements {
+        uint32_t numExtensions;
+        const char* const* ppExtensions;
+        const VkPhysicalDeviceFeatures* pFeatures;  //Each enabled feature must be supported. May be nullptr.
+        VkQueueFlags queueFlags;                    //Flags which a single Queue Family must support.
+        uint32_t minAPIVersion;                     //0 accepts any version.
+    };
+
+    /**
+     * @brief A Physical Device, and how well it suits a set of VkPhysicalDeviceRequirements.
+    */
+    struct VkPhysicalDeviceCandidate {
+        VkPhysicalDevice device;
+        uint32_t index;     //Index in vkEnumeratePhysicalDevices() order.
+        VkPhysicalDeviceProperties properties;
+        VkDeviceSize deviceLocalMemory;
+        uint64_t score;     //Higher is better. 0 if the device is unsuitable.
+    };
+
+    enum class EQueueType {
+        Graphics = 0,
+        Compute,
+        Transfer,
+        COUNT
+    };
+
+    /**
+     * @brief The Queue Families used for each EQueueType.
+     * @note Compute and Transfer use dedicated families where the device has them, so their work can overlap graphics.
+     * Otherwise they share a family (and Queue) with Graphics.
+    */
+    struct VkQueueFamilies {
+        uint32_t graphics;
+        uint32_t compute;
+        uint32_t transfer;
+    };
+
     const VkResult VK_CHECK_IMPL(const VkResult result, const char* file, const uint64_t line, const char* function);
 }
 
@@ -8,6 +8,8 @@
 */
 
 #include "VkCommon.h"
+#include <vector>
+#include <string>
 
 namespace VKR {
     class VkContext {
@@ -26,19 +28,52 @@ namespace VKR {
 #endif
 
         const VkInstance& GetInstance() const;
+        /**
+         * @brief Creates the Vulkan Instance. If pApplicationInfo is nullptr, Vulkan 1.2 is requested.
+        */
         VkResult CreateInstance(const uint32_t numLayers, const char* const* ppLayers, const uint32_t numExtensions, const char* const* ppExtensions, const VkApplicationInfo* pApplicationInfo = nullptr);
+        const uint32_t GetAPIVersion() const;
         void DestroyInstance();
 
 
         //Physical Device
         const VkPhysicalDevice& GetPhysicalDevice() const;
-        VkResult SelectPhysicalDevice();
+
+        /**
+         * @brief Scores every Physical Device against 'requirements', and returns them from best to worst.
+         * @param pRequirements The requirements to score against. If nullptr, only a Graphics Queue is required.
+        */
+        VkResult EnumeratePhysicalDevices(const VkPhysicalDeviceRequirements* pRequirements, std::vector<VkPhysicalDeviceCandidate>& candidates) const;
+
+        /**
+         * @brief Selects the highest scoring Physical Device which meets 'requirements', and logs the ranked list.
+         * @remark The VKR_PHYSICAL_DEVICE environment variable overrides the selection, by index (in enumeration order) or by case-insensitive name substring.
+         * @return VK_ERROR_INITIALIZATION_FAILED if no device meets the requirements.
+        */
+        VkResult SelectPhysicalDevice(const VkPhysicalDeviceRequirements* pRequirements = nullptr);
 
         //Logical Device
         const VkDevice& GetDevice() const;
-        VkResult CreateDevice(const uint32_t numExtensions, const char* const* ppExtensions, const uint32_t numQueues, const VkDeviceQueueCreateInfo* pQueueCreateInfos, const VkPhysicalDeviceFeatures* pFeatures = nullptr);
+        VkResult CreateDevice(const uint32_t numExtensions, const char* const* ppExtensions, const uint32_t numQueues, const VkDeviceQueueCreateInfo* pQueueCreateInfos, const VkPhysicalDeviceFeatures* pFeatures = nullptr, const void* pNext = nullptr);
+
+        /**
+         * @brief Finds the Graphics, async Compute and Transfer Queue Families of the selected Physical Device.
+        */
+        VkQueueFamilies FindQueueFamilies() const;
+
+        /**
+         * @brief Creates the Logical Device with one Queue per distinct family in 'queueFamilies'. Queues are retrieved with GetQueue().
+        */
+        VkResult CreateDevice(const uint32_t numExtensions, const char* const* ppExtensions, const VkQueueFamilies& queueFamilies, const VkPhysicalDeviceFeatures* pFeatures = nullptr, const void* pNext = nullptr);
+        VkQueue GetQueue(const EQueueType type) const;
+        const uint32_t GetQueueFamilyIndex(const EQueueType type) const;
         void DestroyDevice();
 
+        /**
+         * @brief Returns true if 'extension' was enabled when the Logical Device was created.
+        */
+        const bool IsDeviceExtensionEnabled(const char* extension) const;
+
         //VMA
         VkResult CreateAllocator();
         void DestroyAllocator();
@@ -46,6 +81,12 @@ namespace VKR {
         VkResult Map(const VmaAllocation& allocation, void** ppData) const;
         void Unmap(const VmaAllocation& allocation) const;
 
+        //Host writes to non-coherent memory must be flushed before the device reads them, and device writes invalidated before the host reads them.
+        VkResult Flush(const VmaAllocation& allocation, const VkDeviceSize offset = 0, const VkDeviceSize size = VK_WHOLE_SIZE) const;
+        VkResult Flush(const VkBufferResource& buffer, const VkDeviceSize offset = 0, const VkDeviceSize size = VK_WHOLE_SIZE) const;
+        VkResult Invalidate(const VmaAllocation& allocation, const VkDeviceSize offset = 0, const VkDeviceSize size = VK_WHOLE_SIZE) const;
+        VkResult Invalidate(const VkBufferResource& buffer, const VkDeviceSize offset = 0, const VkDeviceSize size = VK_WHOLE_SIZE) const;
+
         //Device Level Functions
         VkQueue GetDeviceQueue(const uint32_t queueFamilyIndex, const uint32_t queueIndex) const;
 
@@ -55,12 +96,41 @@ namespace VKR {
         VkResult CreateFence(VkFence* pFence, bool startSignaled = true) const;
         void DestroyFence(VkFence& fence) const;
 
+        //Timeline Semaphores require the timelineSemaphore feature to be enabled on the device.
+        VkResult CreateTimelineSemaphore(const uint64_t initialValue, VkSemaphore* pSemaphore) const;
+        VkResult WaitSemaphore(const VkSemaphore semaphore, const uint64_t value, const uint64_t timeout = UINT64_MAX) const;
+        VkResult GetSemaphoreCounterValue(const VkSemaphore semaphore, uint64_t* pValue) const;
+
         VkResult CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, const VmaMemoryUsage memoryUsage, const uint32_t memoryFlags, VmaAllocation* pAllocation, VkBuffer* pBuffer) const;
         void DestroyBuffer(VkBuffer& buffer, VmaAllocation& allocation) const;
 
+        /**
+         * @brief Creates a Buffer. Include VMA_ALLOCATION_CREATE_MAPPED_BIT in memoryFlags to keep the buffer persistently mapped, through pBuffer->pMappedData.
+        */
+        VkResult CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, const VmaMemoryUsage memoryUsage, const uint32_t memoryFlags, VkBufferResource* pBuffer) const;
+        void DestroyBuffer(VkBufferResource& buffer) const;
+
+        /**
+         * @brief Creates an Image and its backing memory.
+         * @remark Attachments whose contents never leave a render pass should use VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT with VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED,
+         * so tile-based GPUs never commit their memory. On devices without lazily allocated memory, these fall back to regular device-local memory.
+        */
         VkResult CreateImage(const VkImageType type, const VkExtent3D extents, const VkSampleCountFlagBits sampleCount, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, const VmaMemoryUsage memoryUsage, const uint32_t memoryFlags, VmaAllocation* pAllocation, VkImage* pImage) const;
         void DestroyImage(VkImage& image, VmaAllocation& allocation) const;
 
+        /**
+         * @brief Creates an Image without backing memory, so it may be bound into memory shared with other resources through BindImageMemory().
+        */
+        VkResult CreateImage(const VkImageType type, const VkExtent3D extents, const VkSampleCountFlagBits sampleCount, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkImage* pImage) const;
+        void DestroyImage(VkImage& image) const;
+
+        /**
+         * @brief Allocates memory satisfying 'requirements', which resources are then bound into at offsets.
+        */
+        VkResult AllocateMemory(const VkMemoryRequirements& requirements, const VkMemoryPropertyFlags requiredFlags, VmaAllocation* pAllocation) const;
+        void FreeMemory(VmaAllocation& allocation) const;
+        VkResult BindImageMemory(const VmaAllocation allocation, const VkDeviceSize offset, const VkImage image) const;
+
         VkResult CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, VkImageView* pImageView) const;
         void DestroyImageView(VkImageView& imageView) const;
 
@@ -72,17 +142,19 @@ namespace VKR {
 
         VkResult CreateCommandPool(const uint32_t queueFamilyIndex, const uint32_t flags, VkCommandPool* pCommandPool) const;
         void DestroyCommandPool(VkCommandPool& commandPool) const;
+        VkResult ResetCommandPool(const VkCommandPool commandPool, const uint32_t flags = 0) const;
 
         VkResult AllocateCommandBuffers(const VkCommandPool commandPool, VkCommandBufferLevel level, const uint32_t count, VkCommandBuffer* pCommandBuffers) const;
-        void FreeCommandBuffers(const VkCommandPool commandPool, const uint32_t count, VkCommandBuffer* pCommandBuffers);
+        void FreeCommandBuffers(const VkCommandPool commandPool, const uint32_t count, VkCommandBuffer* pCommandBuffers) const;
 
         VkResult CreateDescriptorPool(const uint32_t maxSets, const uint32_t flags, const uint32_t numPoolSizes, const VkDescriptorPoolSize* pPoolSizes, VkDescriptorPool* pDescriptorPool) const;
         void DestroyDescriptorPool(VkDescriptorPool& descriptorPool) const;
+        VkResult ResetDescriptorPool(const VkDescriptorPool descriptorPool) const;
 
-        VkResult CreateDescriptorSetLayout(const uint32_t numBindings, const VkDescriptorSetLayoutBinding* pBindings, VkDescriptorSetLayout* pLayout);
-        void DestroyDescriptorSetlayout(VkDescriptorSetLayout& layout);
+        VkResult CreateDescriptorSetLayout(const uint32_t numBindings, const VkDescriptorSetLayoutBinding* pBindings, VkDescriptorSetLayout* pLayout, const VkDescriptorSetLayoutCreateFlags flags = 0, const void* pNext = nullptr) const;
+        void DestroyDescriptorSetlayout(VkDescriptorSetLayout& layout) const;
         
-        VkResult AllocateDescriptorSets(const VkDescriptorPool descriptorPool, const uint32_t numSets, const VkDescriptorSetLayout* pLayouts, VkDescriptorSet* pSets);
+        VkResult AllocateDescriptorSets(const VkDescriptorPool descriptorPool, const uint32_t numSets, const VkDescriptorSetLayout* pLayouts, VkDescriptorSet* pSets) const;
 
         VkResult CreatePipelineLayout(const uint32_t numDescriptors, const VkDescriptorSetLayout * pDescriptors, const uint32_t numPushConstants, const VkPushConstantRange* pPushConstants, VkPipelineLayout* pPipelineLayout) const;
         void DestroyPipelineLayout(VkPipelineLayout& pipelineLayout) const;
@@ -97,6 +169,21 @@ namespace VKR {
         VkResult CreateFrameBuffer(const VkExtent3D extents, const VkRenderPass renderPass, const uint32_t numAttachments, const VkImageView* pAttachments, VkFramebuffer* pFrameBuffer) const;
         void DestroyFrameBuffer(VkFramebuffer& frameBuffer) const;
 
+        /**
+         * @brief Returns true if the device was created with VK_KHR_dynamic_rendering (or an instance and device of at least Vulkan 1.3), so passes may begin with CmdBeginRendering() rather than a Render Pass.
+         * @remark The dynamicRendering feature must also have been enabled, e.g. by chaining VkInit::MakePhysicalDeviceDynamicRenderingFeatures() into CreateDevice().
+        */
+        const bool SupportsDynamicRendering() const;
+        void CmdBeginRendering(const VkCommandBuffer commandBuffer, const VkRenderingInfo* pRenderingInfo) const;
+        void CmdEndRendering(const VkCommandBuffer commandBuffer) const;
+
+        /**
+         * @brief Returns true if the device was created with VK_KHR_synchronization2 (or an instance and device of at least Vulkan 1.3), so barriers may be recorded with CmdPipelineBarrier2().
+         * @remark The synchronization2 feature must also have been enabled, e.g. by chaining VkInit::MakePhysicalDeviceSynchronization2Features() into CreateDevice().
+        */
+        const bool SupportsSynchronization2() const;
+        void CmdPipelineBarrier2(const VkCommandBuffer commandBuffer, const VkDependencyInfo* pDependencyInfo) const;
+
         VkResult CreateQueryPool(const VkQueryType type, const uint32_t count, const VkQueryPipelineStatisticFlags pipelineStatistics, VkQueryPool* pPool);
         void DestroyQueryPool(VkQueryPool& pool);
 
@@ -115,8 +202,19 @@ namespace VKR {
 
     private:
         VkInstance m_Instance;
+        uint32_t m_APIVersion;
         VkPhysicalDevice m_PhysicalDevice;
         VkDevice m_Device;
+        VkQueueFamilies m_QueueFamilies;
+        VkQueue m_Queues[static_cast<uint32_t>(EQueueType::COUNT)];
+
+        //Device functions which aren't exported by the loader at Vulkan 1.2, so are loaded once the device is created.
+        PFN_vkCmdBeginRendering m_pfnCmdBeginRendering;
+        PFN_vkCmdEndRendering m_pfnCmdEndRendering;
+        PFN_vkCmdPipelineBarrier2 m_pfnCmdPipelineBarrier2;
+        std::vector<std::string> m_DeviceExtensions;
+        bool m_DynamicRendering;        //Enabled at device creation, through Vulkan 1.3 or the KHR extension, with its feature.
+        bool m_Synchronization2;
 #ifdef VKR_DEBUG
         VkDebugUtilsMessengerEXT m_DebugLogger;
         VkDebugReportCallbackEXT m_DebugReporter;
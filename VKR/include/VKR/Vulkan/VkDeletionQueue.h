@@ -0,0 +1,54 @@
+#ifndef __VKRENDERER_VKDELETIONQUEUE_H
+#define __VKRENDERER_VKDELETIONQUEUE_H
+/**
+*   @file VkDeletionQueue.h
+*   @brief Deferred Destruction of GPU Resources
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/17
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <functional>
+
+namespace VKR {
+    class VkContext;
+
+    /**
+     * @brief Defers destroying resources until the GPU has finished with them, rather than waiting for the device to idle.
+     * @remark Each deletion is tagged with a timeline value, e.g. VkFrameContext::GetFrameValue() of the last frame to use the resource,
+     * and runs once Collect() is passed a completed value at least as large.
+    */
+    class VkDeletionQueue {
+    public:
+        using DeleteFunc = std::function<void(const VkContext& context)>;
+
+        VkDeletionQueue();
+
+        /**
+         * @brief Queues 'func' to run once the timeline reaches 'value'.
+        */
+        void Push(const uint64_t value, DeleteFunc&& func);
+
+        /**
+         * @brief Runs every deletion whose value has been reached, in the order they were pushed.
+        */
+        void Collect(const VkContext& context, const uint64_t completedValue);
+
+        /**
+         * @brief Runs every pending deletion. The device must be idle.
+        */
+        void Flush(const VkContext& context);
+
+        const uint32_t GetPendingCount() const;
+
+    private:
+        struct Deletion {
+            uint64_t value;
+            DeleteFunc func;
+        };
+
+        std::vector<Deletion> m_Pending;
+    };
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef __VKRENDERER_VKDESCRIPTORALLOCATOR_H
+#define __VKRENDERER_VKDESCRIPTORALLOCATOR_H
+/**
+*   @file VkDescriptorAllocator.h
+*   @brief Growable Descriptor Set Allocator
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/10
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <mutex>
+
+namespace VKR {
+    class VkContext;
+
+    /**
+     * @brief Allocates Descriptor Sets from a growing list of Descriptor Pools, so pools never need hand-tuned sizes.
+     * @remark When a pool is exhausted, allocation is retried from a fresh pool, each larger than the last.
+     * Sets are never freed individually; pools are reset wholesale. With more than one frame in flight, each frame owns its own pools,
+     * which are reset by BeginFrame() for transient sets. Persistent sets should come from an allocator which is never reset.
+    */
+    class VkDescriptorAllocator {
+    public:
+        /**
+         * @brief The number of descriptors of 'type' each pool holds, per set it can allocate.
+        */
+        struct PoolSizeRatio {
+            VkDescriptorType type;
+            float ratio;
+        };
+
+        VkDescriptorAllocator();
+
+        /**
+         * @brief Creates the allocator. Pools are created lazily, on first use.
+         * @param setsPerPool The number of sets the first pool can allocate. Subsequent pools grow by half, up to a limit.
+         * @param numRatios The number of descriptor types, and their ratios, in each pool.
+         * @param framesInFlight The number of frames with independent pools. 1 for an allocator which is only reset manually.
+        */
+        VkResult Create(const VkContext& context, const uint32_t setsPerPool, const uint32_t numRatios, const PoolSizeRatio* pRatios, const uint32_t framesInFlight = 1);
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Resets a frame's pools, freeing every set allocated from them, and makes it the current frame.
+         * @remark The frame's previous submission must have completed.
+        */
+        VkResult BeginFrame(const VkContext& context, const uint32_t frameIndex);
+
+        /**
+         * @brief Resets every pool, freeing all sets. The device must not be using any of them.
+        */
+        VkResult Reset(const VkContext& context);
+
+        /**
+         * @brief Allocates a Descriptor Set from the current frame's pools. Thread safe.
+         * @param pNext Optional extension chain for VkDescriptorSetAllocateInfo.
+        */
+        VkResult Allocate(const VkContext& context, const VkDescriptorSetLayout layout, VkDescriptorSet* pSet, const void* pNext = nullptr);
+
+        const uint32_t GetPoolCount() const;
+
+    private:
+        struct Frame {
+            std::vector<VkDescriptorPool> readyPools;   //Pools which may have space remaining.
+            std::vector<VkDescriptorPool> fullPools;    //Pools which have failed an allocation since their last reset.
+        };
+
+        VkResult AcquirePool(const VkContext& context, Frame& frame, VkDescriptorPool* pPool);
+
+    private:
+        std::vector<PoolSizeRatio> m_Ratios;
+        uint32_t m_SetsPerPool;
+        uint32_t m_NumPools;
+
+        std::vector<Frame> m_Frames;
+        uint32_t m_FrameIndex;
+
+        std::mutex m_Mutex;
+    };
+}
+
+#endif
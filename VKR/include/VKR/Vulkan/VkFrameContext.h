@@ -0,0 +1,103 @@
+#ifndef __VKRENDERER_VKFRAMECONTEXT_H
+#define __VKRENDERER_VKFRAMECONTEXT_H
+/**
+*   @file VkFrameContext.h
+*   @brief Per-Frame Command Pool and Synchronization Management
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/06
+*/
+#include "VkCommon.h"
+#include <vector>
+
+namespace VKR {
+    class VkContext;
+
+    /**
+     * @brief Owns a Command Pool and swapchain Semaphores for each frame in flight, and paces frames against a single GPU timeline.
+     * @remark Each frame's final submission signals a Timeline Semaphore with the frame's number, so the timeline's value is the number of frames the GPU has completed.
+     * Anything recycled per-frame can compare the value it was last used at against GetCompletedValue(), rather than creating its own fences.
+     * Each frame's pool is reset wholesale with vkResetCommandPool() once the frame completes, and its Command Buffers are handed out again from a free list.
+    */
+    class VkFrameContext {
+    public:
+        VkFrameContext();
+
+        VkResult Create(const VkContext& context, const uint32_t queueFamilyIndex, const uint32_t framesInFlight);
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Waits for a frame's previous submission to complete, then recycles its Command Buffers.
+         * @param frameIndex The frame in flight to begin, in [0, GetFramesInFlight()).
+        */
+        VkResult BeginFrame(const VkContext& context, const uint32_t frameIndex);
+
+        /**
+         * @brief Retrieves a Command Buffer for the current frame. It is valid until the frame is next begun.
+         * @param level The Command Buffer level.
+         * @param pCommandBuffer Receives the Command Buffer, in the initial state.
+        */
+        VkResult AllocateCommandBuffer(const VkContext& context, const VkCommandBufferLevel level, VkCommandBuffer* pCommandBuffer);
+
+        /**
+         * @brief Submits the current frame's Command Buffers to 'queue'.
+         * @remark Waits on the frame's image available Semaphore, and signals its render finished Semaphore and the timeline.
+         * @param numWaitSemaphores Additional Semaphores to wait on, e.g. upload or async compute tokens. Values are ignored for binary semaphores.
+        */
+        VkResult Submit(const VkQueue queue, const uint32_t numCommandBuffers, const VkCommandBuffer* pCommandBuffers, const uint32_t numWaitSemaphores = 0, const VkSemaphore* pWaitSemaphores = nullptr, const uint64_t* pWaitValues = nullptr, const VkPipelineStageFlags* pWaitStageMasks = nullptr);
+
+        /**
+         * @brief Waits until the timeline reaches 'value'.
+        */
+        VkResult Wait(const VkContext& context, const uint64_t value, const uint64_t timeout = UINT64_MAX) const;
+
+        /**
+         * @brief Returns the number of frames the GPU has completed.
+        */
+        uint64_t GetCompletedValue(const VkContext& context) const;
+        bool IsComplete(const VkContext& context, const uint64_t value) const;
+
+        /**
+         * @brief Returns the timeline value the current frame signals on completion.
+        */
+        const uint64_t GetFrameValue() const;
+        const VkSemaphore& GetTimelineSemaphore() const;
+
+        //Binary Semaphores for the swapchain, which cannot use Timeline Semaphores.
+        const VkSemaphore& GetImageAvailableSemaphore() const;
+        const VkSemaphore& GetRenderFinishedSemaphore() const;
+
+        /**
+         * @brief Returns the time BeginFrame() spent blocked on the GPU, in milliseconds.
+        */
+        const double GetCPUWaitTime() const;
+
+        const uint32_t GetFrameIndex() const;
+        const uint32_t GetFramesInFlight() const;
+
+    private:
+        struct CommandBufferList {
+            std::vector<VkCommandBuffer> buffers;
+            uint32_t numUsed;
+        };
+
+        struct Frame {
+            VkCommandPool commandPool;
+            VkSemaphore imageAvailable;
+            VkSemaphore renderFinished;
+            uint64_t value;     //The timeline value this frame's last submission signals.
+            CommandBufferList primary;
+            CommandBufferList secondary;
+        };
+
+    private:
+        uint32_t m_FrameIndex;
+        std::vector<Frame> m_Frames;
+
+        VkSemaphore m_Timeline;
+        uint64_t m_FrameValue;
+
+        double m_CPUWaitTime;
+    };
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef __VKRENDERER_VKFRAMEPACER_H
+#define __VKRENDERER_VKFRAMEPACER_H
+/**
+*   @file VkFramePacer.h
+*   @brief CPU Frame Limiting and Latency Measurement
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/18
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <chrono>
+
+namespace VKR {
+    class VkContext;
+    class VkFrameContext;
+
+    /**
+     * @brief Limits the frame rate on the CPU, and measures each frame's latency from input to presentation.
+     * @remark BeginFrame() marks when a frame samples its input, and EndFrame() when it's presented. EndFrame() then sleeps until the next
+     * frame is due, so the following frame samples its input as late as possible, rather than queueing behind the GPU.
+     * A frame's completion is observed through VkFrameContext's timeline on later EndFrame() calls, so GetCompletionLatency() is an upper bound,
+     * accurate to within a frame.
+    */
+    class VkFramePacer {
+    public:
+        VkFramePacer();
+
+        /**
+         * @param maxFrameRate Frames per second to limit to, or 0 for unlimited.
+        */
+        void SetMaxFrameRate(const double maxFrameRate);
+        const double GetMaxFrameRate() const;
+
+        /**
+         * @brief Marks the point the current frame samples its input. Call immediately after polling events.
+        */
+        void BeginFrame();
+
+        /**
+         * @brief Marks the current frame as presented, resolves the latency of any frames the GPU has completed, then waits until the next frame is due.
+         * @remark Call after VkSwapchain::Present(), so the frame's timeline value has been submitted.
+        */
+        void EndFrame(const VkContext& context, const VkFrameContext& frameContext);
+
+        /**
+         * @brief Returns the latest presented frame's time from input to Present(), in milliseconds.
+        */
+        const double GetPresentLatency() const;
+
+        /**
+         * @brief Returns the latest completed frame's time from input to the GPU finishing it, in milliseconds.
+        */
+        const double GetCompletionLatency() const;
+
+        /**
+         * @brief Returns the time EndFrame() last spent limiting the frame rate, in milliseconds.
+        */
+        const double GetLimiterWaitTime() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct PendingFrame {
+            uint64_t value;             //The timeline value the frame signals on completion.
+            Clock::time_point inputTime;
+        };
+
+    private:
+        void Limit();
+
+    private:
+        double m_MaxFrameRate;
+        Clock::time_point m_NextFrameTime;
+        Clock::time_point m_InputTime;
+
+        std::vector<PendingFrame> m_PendingFrames;
+
+        double m_PresentLatency;
+        double m_CompletionLatency;
+        double m_LimiterWaitTime;
+    };
+}
+
+#endif
@@ -14,6 +14,12 @@ namespace VKR {
     namespace VkHelpers {
         uint32_t FindQueueFamilyIndex(VkPhysicalDevice device, VkQueueFlags flags);
 
+        /**
+         * @brief Finds a Queue Family supporting 'flags', but none of 'excludeFlags'. e.g. a Transfer-only family.
+         * @return The Queue Family Index, or UINT32_MAX if no such family exists.
+        */
+        uint32_t FindDedicatedQueueFamilyIndex(VkPhysicalDevice device, VkQueueFlags flags, VkQueueFlags excludeFlags);
+
         uint32_t FindMemoryTypeIndex(VkPhysicalDevice device, uint32_t flags, VkMemoryPropertyFlags properties);
 
         VkFormat FindSupportedFormat(VkPhysicalDevice device, const uint32_t numFormats, const VkFormat* pFormats, VkImageTiling tiling, VkFormatFeatureFlags flags);
@@ -28,6 +34,14 @@ namespace VKR {
         bool ValidatePhysicalDeviceExtensionSupport(const VkPhysicalDevice& device, const char* const extension, const uint32_t extensionPropertyCount, VkExtensionProperties* pExtensionProperties);
         bool ValidatePhysicalDeviceExtensionSupportArray(const VkPhysicalDevice& device, const uint32_t numExtensions, const char* const* pExtensions);
 
+        /**
+         * @brief Scores a Physical Device against 'requirements'. Device type dominates, followed by device-local memory and dedicated Queue Families.
+         * @return The device's score, or 0 if it does not meet the requirements.
+        */
+        uint64_t ScorePhysicalDevice(const VkPhysicalDevice& device, const VkPhysicalDeviceRequirements& requirements);
+
+        bool ValidatePhysicalDeviceFeatureSupport(const VkPhysicalDevice& device, const VkPhysicalDeviceFeatures& features);
+
         bool ValidatePhysicalDevicePresentationSupport(const VkPhysicalDevice& device, const uint32_t presentQueueFamilyIndex, VkSurfaceKHR surface);
 
      
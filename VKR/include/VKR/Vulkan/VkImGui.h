@@ -27,6 +27,11 @@ namespace VKR {
 
         void Hook(const VkContext& context, const uint32_t queueFamilyIndex, const VkQueue queue, const VkPipelineCache pipelineCache, const uint32_t imageCount, const VkRenderPass renderPass, const VkSampleCountFlagBits samples); 
 
+        /**
+         * @brief Hooks ImGui for Dynamic Rendering, drawing into a single colour attachment of 'colorFormat'.
+        */
+        void Hook(const VkContext& context, const uint32_t queueFamilyIndex, const VkQueue queue, const VkPipelineCache pipelineCache, const uint32_t imageCount, const VkFormat colorFormat, const VkSampleCountFlagBits samples); 
+
         void Draw(VkCommandBuffer* pCmd); 
     private:
         ImGuiContext* m_Context;
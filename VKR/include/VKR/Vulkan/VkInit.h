@@ -22,6 +22,23 @@ namespace VKR {
         VkBufferCreateInfo MakeBufferCreateInfo(const uint64_t size, const VkBufferUsageFlags usage, const VkSharingMode sharingMode = VK_SHARING_MODE_EXCLUSIVE, const uint32_t queueFamilyIndexCount = 0, const uint32_t* pQueueFamilyIndices = nullptr, const uint32_t flags = 0);
         VkImageCreateInfo MakeImageCreateInfo(const VkExtent3D extents, const VkImageType type, const VkFormat format, const VkSampleCountFlagBits sampleCount, const VkImageTiling tiling, const VkImageUsageFlags usage, const VkSharingMode = VK_SHARING_MODE_EXCLUSIVE, const uint32_t queueFamilyIndexCount = 0, const uint32_t* pQueueFamilyIndices = nullptr, const uint32_t flags = 0);
 
+        VkCommandBufferInheritanceInfo MakeCommandBufferInheritanceInfo(const VkRenderPass renderPass, const uint32_t subpass, const VkFramebuffer frameBuffer = VK_NULL_HANDLE, const void* pNext = nullptr);
+
+        //Dynamic Rendering. Secondary Command Buffers recorded within vkCmdBeginRendering() chain a VkCommandBufferInheritanceRenderingInfo to their VkCommandBufferInheritanceInfo, with a null Render Pass.
+        VkPhysicalDeviceDynamicRenderingFeatures MakePhysicalDeviceDynamicRenderingFeatures(void* pNext = nullptr);
+        VkCommandBufferInheritanceRenderingInfo MakeCommandBufferInheritanceRenderingInfo(const uint32_t numColorFormats, const VkFormat* pColorFormats, const VkFormat depthFormat, const VkFormat stencilFormat, const VkSampleCountFlagBits samples, const VkRenderingFlags flags = 0);
+        VkRenderingAttachmentInfo MakeRenderingAttachmentInfo(const VkImageView imageView, const VkImageLayout imageLayout, const VkAttachmentLoadOp loadOp, const VkAttachmentStoreOp storeOp, const VkClearValue clearValue = {}, const VkResolveModeFlagBits resolveMode = VK_RESOLVE_MODE_NONE, const VkImageView resolveImageView = VK_NULL_HANDLE, const VkImageLayout resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED);
+        VkRenderingInfo MakeRenderingInfo(const VkRect2D renderArea, const uint32_t numColorAttachments, const VkRenderingAttachmentInfo* pColorAttachments, const VkRenderingAttachmentInfo* pDepthAttachment = nullptr, const VkRenderingAttachmentInfo* pStencilAttachment = nullptr, const VkRenderingFlags flags = 0);
+
+        //Without a Render Pass, attachment layouts are transitioned explicitly.
+        VkImageMemoryBarrier MakeImageMemoryBarrier(const VkImage image, const VkImageAspectFlags aspectFlags, const VkImageLayout oldLayout, const VkImageLayout newLayout, const VkAccessFlags srcAccessMask, const VkAccessFlags dstAccessMask);
+
+        //Synchronization2
+        VkPhysicalDeviceSynchronization2Features MakePhysicalDeviceSynchronization2Features(void* pNext = nullptr);
+        VkImageMemoryBarrier2 MakeImageMemoryBarrier2(const VkImage image, const VkImageAspectFlags aspectFlags, const VkImageLayout oldLayout, const VkImageLayout newLayout, const VkPipelineStageFlags2 srcStageMask, const VkAccessFlags2 srcAccessMask, const VkPipelineStageFlags2 dstStageMask, const VkAccessFlags2 dstAccessMask);
+        VkBufferMemoryBarrier2 MakeBufferMemoryBarrier2(const VkBuffer buffer, const VkPipelineStageFlags2 srcStageMask, const VkAccessFlags2 srcAccessMask, const VkPipelineStageFlags2 dstStageMask, const VkAccessFlags2 dstAccessMask);
+        VkDependencyInfo MakeDependencyInfo(const uint32_t numImageBarriers, const VkImageMemoryBarrier2* pImageBarriers, const uint32_t numBufferBarriers = 0, const VkBufferMemoryBarrier2* pBufferBarriers = nullptr);
+
         VkDescriptorPoolSize MakeDescriptorPoolSize(const VkDescriptorType type, const uint32_t count);
 
         VkWriteDescriptorSet MakeWriteDescriptorSet(const VkDescriptorSet descriptorSet, const uint32_t binding, const uint32_t arrayElement, const uint32_t count, const VkDescriptorType type, const VkDescriptorImageInfo* pImageInfo, const VkDescriptorBufferInfo* pBufferInfo, const VkBufferView* pTexelBufferView);
@@ -35,6 +52,7 @@ namespace VKR {
         VkPipelineDepthStencilStateCreateInfo MakePipelineDepthStencilStateCreateInfo(); 
         VkPipelineColorBlendStateCreateInfo MakePipelineColorBlendStateCreateInfo(); 
         VkPipelineDynamicStateCreateInfo MakePipelineDynamicStateCreateInfo(); 
+        VkPipelineRenderingCreateInfo MakePipelineRenderingCreateInfo();
     }
 
 }
@@ -0,0 +1,76 @@
+#ifndef __VKRENDERER_VKLAYOUTCACHE_H
+#define __VKRENDERER_VKLAYOUTCACHE_H
+/**
+*   @file VkLayoutCache.h
+*   @brief Deduplicating Descriptor Set Layout and Pipeline Layout Cache
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/12
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+namespace VKR {
+    class VkContext;
+
+    /**
+     * @brief Hands out shared Descriptor Set Layouts and Pipeline Layouts, keyed by their contents.
+     * @remark Requesting a layout which is structurally identical to an existing one returns the existing handle, rather than creating a new object.
+     * Binding order is irrelevant, as bindings are sorted before hashing. Since identical Set Layouts share a handle, Pipeline Layouts built from them
+     * are also shared, so pipelines with matching layouts are compatible, and bound sets survive pipeline switches.
+     * The cache owns every layout it returns; they remain valid until Destroy(), and must not be destroyed individually.
+    */
+    class VkLayoutCache {
+    public:
+        VkLayoutCache();
+
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Retrieves a Descriptor Set Layout matching the bindings, creating it if it doesn't exist. Thread safe.
+         * @param pBindingFlags Optional per-binding flags, parallel to pBindings. Chained through VkDescriptorSetLayoutBindingFlagsCreateInfo.
+        */
+        VkResult GetDescriptorSetLayout(const VkContext& context, const uint32_t numBindings, const VkDescriptorSetLayoutBinding* pBindings, VkDescriptorSetLayout* pLayout, const VkDescriptorSetLayoutCreateFlags flags = 0, const VkDescriptorBindingFlags* pBindingFlags = nullptr);
+
+        /**
+         * @brief Retrieves a Pipeline Layout matching the Set Layouts and Push Constant ranges, creating it if it doesn't exist. Thread safe.
+        */
+        VkResult GetPipelineLayout(const VkContext& context, const uint32_t numSetLayouts, const VkDescriptorSetLayout* pSetLayouts, const uint32_t numPushConstants, const VkPushConstantRange* pPushConstants, VkPipelineLayout* pPipelineLayout);
+
+        const uint32_t GetDescriptorSetLayoutCount() const;
+        const uint32_t GetPipelineLayoutCount() const;
+        const uint64_t GetHitCount() const;
+
+    private:
+        struct DescriptorSetLayoutKey {
+            VkDescriptorSetLayoutCreateFlags flags;
+            std::vector<VkDescriptorSetLayoutBinding> bindings;     //Sorted by binding index
+            std::vector<VkDescriptorBindingFlags> bindingFlags;     //Parallel to bindings, or empty
+            std::vector<VkSampler> immutableSamplers;               //Each binding's immutable samplers, in binding order
+
+            bool operator==(const DescriptorSetLayoutKey& other) const;
+        };
+
+        struct PipelineLayoutKey {
+            std::vector<VkDescriptorSetLayout> setLayouts;
+            std::vector<VkPushConstantRange> pushConstants;         //Sorted by offset
+
+            bool operator==(const PipelineLayoutKey& other) const;
+        };
+
+        struct KeyHash {
+            size_t operator()(const DescriptorSetLayoutKey& key) const;
+            size_t operator()(const PipelineLayoutKey& key) const;
+        };
+
+    private:
+        std::unordered_map<DescriptorSetLayoutKey, VkDescriptorSetLayout, KeyHash> m_DescriptorSetLayouts;
+        std::unordered_map<PipelineLayoutKey, VkPipelineLayout, KeyHash> m_PipelineLayouts;
+        uint64_t m_Hits;
+
+        std::mutex m_Mutex;
+    };
+}
+
+#endif
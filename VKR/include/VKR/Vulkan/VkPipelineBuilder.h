@@ -13,9 +13,61 @@
 namespace VKR {
     class VkContext;
 
+    /**
+     * @brief A compact, hashable encoding of a Pipeline's complete state.
+     * @remark Keys compare equal exactly when their Pipelines would be identical. The encoding can be written to disk with GetData() and
+     * reconstructed from it, but handles (shader modules, layouts, render passes) are encoded by value, so are only meaningful within one run,
+     * unless shader stages are given a stable identifier through VkPipelineBuilder::AddShaderStage().
+    */
+    class VkPipelineKey {
+    public:
+        VkPipelineKey() = default;
+        VkPipelineKey(const void* pData, const size_t size);
+
+        bool operator==(const VkPipelineKey& other) const;
+        bool operator!=(const VkPipelineKey& other) const;
+
+        const uint64_t GetHash() const;
+        const std::vector<uint8_t>& GetData() const;
+
+        /**
+         * @brief Appends the raw bytes of a value. Only for trivially copyable types without padding.
+        */
+        template<typename T>
+        void Write(const T& value);
+        void Write(const char* str);
+
+        struct Hasher {
+            size_t operator()(const VkPipelineKey& key) const { return static_cast<size_t>(key.GetHash()); }
+        };
+
+    private:
+        std::vector<uint8_t> m_Data;
+        uint64_t m_Hash = 0xcbf29ce484222325ull;   //FNV-1a offset basis
+    };
+
+    template<typename T>
+    inline void VkPipelineKey::Write(const T& value)
+    {
+        const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(&value);
+        m_Data.insert(m_Data.end(), pBytes, pBytes + sizeof(T));
+
+        //FNV-1a, updated incrementally.
+        for (size_t i = 0; i < sizeof(T); i++) {
+            m_Hash = (m_Hash ^ pBytes[i]) * 0x100000001b3ull;
+        }
+    }
+
+    /**
+     * @brief Describes a Pipeline's state, and builds its create info.
+     * @remark The builder copies every array passed to it, so it may be copied, and outlive the caller's data. 
+     * Shader Modules and entry point strings are not copied, and must remain valid until the Pipeline is created.
+    */
     class VkPipelineBuilder {
     public:
         VkPipelineBuilder();
+        VkPipelineBuilder(const VkPipelineBuilder& other);
+        VkPipelineBuilder& operator=(const VkPipelineBuilder& other);
 
         /**
          * @brief 
@@ -33,13 +85,35 @@ namespace VKR {
         */
         const VkComputePipelineCreateInfo BuildComputePipeline(const VkPipelineLayout layout) const;
 
+        /**
+         * @brief Encodes the state BuildGraphicsPipeline() would produce as a key.
+        */
+        VkPipelineKey BuildGraphicsPipelineKey(const VkPipelineLayout layout, const VkRenderPass renderPass, const uint32_t subpassIdx) const;
+
+        /**
+         * @brief Encodes the state BuildComputePipeline() would produce as a key.
+        */
+        VkPipelineKey BuildComputePipelineKey(const VkPipelineLayout layout) const;
+
         /**
          * @brief 
          * @param shaderModule 
          * @param stage 
          * @param entryPoint 
+         * @param shaderID Optional stable identifier for the shader, e.g. a hash of its SPIR-V, used in place of the module handle in Pipeline keys.
+        */
+        void AddShaderStage(const VkShaderModule shaderModule, const VkShaderStageFlagBits stage, const char* entryPoint, const uint64_t shaderID = 0);
+
+        /**
+         * @brief Swaps every stage using 'oldModule' over to 'newModule', e.g. when a shader is reloaded.
+         * @return true if any stage was replaced.
+        */
+        bool ReplaceShaderModule(const VkShaderModule oldModule, const VkShaderModule newModule, const uint64_t shaderID = 0);
+
+        /**
+         * @brief Returns true if any stage uses 'shaderModule'.
         */
-        void AddShaderStage(const VkShaderModule shaderModule, const VkShaderStageFlagBits stage, const char* entryPoint);
+        bool UsesShaderModule(const VkShaderModule shaderModule) const;
 
         /**
          * @brief 
@@ -120,9 +194,27 @@ namespace VKR {
         */
         void SetDynamicState(const uint32_t numDynamicStates, const VkDynamicState* pDynamicStates);
 
+        /**
+         * @brief Sets the attachment formats used when the Pipeline is built without a Render Pass, for Dynamic Rendering.
+         * @param numColorFormats 
+         * @param pColorFormats 
+         * @param depthFormat VK_FORMAT_UNDEFINED if there is no Depth attachment.
+         * @param stencilFormat VK_FORMAT_UNDEFINED if there is no Stencil attachment.
+         * @param viewMask 
+         * @remark Requires VK_KHR_dynamic_rendering, or Vulkan 1.3, with the dynamicRendering feature enabled.
+        */
+        void SetRenderingState(const uint32_t numColorFormats, const VkFormat* pColorFormats, const VkFormat depthFormat, const VkFormat stencilFormat = VK_FORMAT_UNDEFINED, const uint32_t viewMask = 0);
+
+
+    private:
+        /**
+         * @brief Points the state create infos at this builder's own copies of their arrays.
+        */
+        void UpdatePointers();
 
     private:
         std::vector<VkPipelineShaderStageCreateInfo> m_ShaderStages;
+        std::vector<uint64_t> m_ShaderIDs;     //Parallel to m_ShaderStages
         VkPipelineVertexInputStateCreateInfo m_VertexInputState;
         VkPipelineInputAssemblyStateCreateInfo m_InputAssemblyState;
         VkPipelineTessellationStateCreateInfo m_TessellationState; 
@@ -132,6 +224,16 @@ namespace VKR {
         VkPipelineDepthStencilStateCreateInfo m_DepthStencilState;
         VkPipelineColorBlendStateCreateInfo m_BlendState;
         VkPipelineDynamicStateCreateInfo m_DynamicState;
+        VkPipelineRenderingCreateInfo m_RenderingState;
+
+        std::vector<VkVertexInputBindingDescription> m_VertexBindings;
+        std::vector<VkVertexInputAttributeDescription> m_VertexAttributes;
+        std::vector<VkViewport> m_Viewports;
+        std::vector<VkRect2D> m_Scissors;
+        std::vector<VkSampleMask> m_SampleMask;
+        std::vector<VkPipelineColorBlendAttachmentState> m_BlendAttachments;
+        std::vector<VkDynamicState> m_DynamicStates;
+        std::vector<VkFormat> m_ColorFormats;
     };
 }
 
@@ -0,0 +1,91 @@
+#ifndef __VKRENDERER_VKPIPELINECACHEMANAGER_H
+#define __VKRENDERER_VKPIPELINECACHEMANAGER_H
+/**
+*   @file VkPipelineCacheManager.h
+*   @brief Persistent, Validated Pipeline Cache
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/12
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <string>
+#include <mutex>
+
+namespace VKR {
+    class VkContext;
+
+    /**
+     * @brief Owns the application's Pipeline Cache, and persists it between runs.
+     * @remark Cache files are keyed per device, and a file's VkPipelineCacheHeaderVersionOne is validated against the device before
+     * it is handed to the driver, so a cache from another GPU or driver is discarded rather than loaded.
+     * Worker threads creating pipelines concurrently should each use their own cache from CreateWorkerCache(), which are merged back
+     * into the main cache with vkMergePipelineCaches().
+     * Saves are written to a temporary file which then replaces the cache file, so an interrupted save never leaves a corrupt cache.
+    */
+    class VkPipelineCacheManager {
+    public:
+        /**
+         * @brief Pipeline creation timings. Hits and misses are only classified where pipeline creation feedback is available (Vulkan 1.3, or VK_EXT_pipeline_creation_feedback).
+        */
+        struct Statistics {
+            uint32_t hits;
+            uint32_t misses;
+            uint32_t unclassified;
+            double hitTime;             //Total ms spent creating pipelines which hit the cache.
+            double missTime;            //Total ms spent creating pipelines which missed the cache.
+            double unclassifiedTime;
+            size_t loadedSize;          //Bytes of cache data loaded from disk. 0 on a cold start.
+        };
+
+        VkPipelineCacheManager();
+
+        /**
+         * @brief Creates the main cache, seeded from this device's cache file in 'directory' if it is valid.
+        */
+        VkResult Create(const VkContext& context, const char* directory = ".");
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Writes the main cache to disk, merging any outstanding worker caches first.
+        */
+        VkResult Save(const VkContext& context);
+
+        /**
+         * @brief Creates a cache for a worker thread, seeded with the main cache's contents. It is owned by the manager until merged.
+        */
+        VkResult CreateWorkerCache(const VkContext& context, VkPipelineCache* pCache);
+
+        /**
+         * @brief Merges every worker cache into the main cache, and destroys them.
+         * @remark Worker caches must no longer be in use.
+        */
+        VkResult MergeWorkerCaches(const VkContext& context);
+
+        /**
+         * @brief Creates pipelines through 'cache', recording their timings. Thread safe, provided each thread uses its own cache.
+         * @param cache The cache to use. VK_NULL_HANDLE uses the main cache, which must then only be used from one thread at a time.
+        */
+        VkResult CreateGraphicsPipelines(const VkContext& context, const uint32_t numPipelines, const VkGraphicsPipelineCreateInfo* pCreateInfos, VkPipeline* pPipelines, const VkPipelineCache cache = VK_NULL_HANDLE);
+        VkResult CreateComputePipelines(const VkContext& context, const uint32_t numPipelines, const VkComputePipelineCreateInfo* pCreateInfos, VkPipeline* pPipelines, const VkPipelineCache cache = VK_NULL_HANDLE);
+
+        const VkPipelineCache& GetPipelineCache() const;
+        const std::string& GetFilePath() const;
+        Statistics GetStatistics();
+
+    private:
+        bool ValidateHeader(const VkContext& context, const std::vector<char>& blob) const;
+        void RecordTimings(const uint32_t numPipelines, const VkPipelineCreationFeedback* pFeedback, const double totalTime);
+
+    private:
+        VkPipelineCache m_Cache;
+        std::vector<VkPipelineCache> m_WorkerCaches;
+        std::string m_FilePath;
+        bool m_CreationFeedback;
+
+        Statistics m_Statistics;
+
+        std::mutex m_Mutex;
+    };
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef __VKRENDERER_VKPIPELINECOMPILER_H
+#define __VKRENDERER_VKPIPELINECOMPILER_H
+/**
+*   @file VkPipelineCompiler.h
+*   @brief Asynchronous, Multithreaded Pipeline Compilation
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/13
+*/
+#include "VkCommon.h"
+#include "VkPipelineBuilder.h"
+#include "../Jobs.h"
+#include <vector>
+#include <list>
+#include <memory>
+#include <future>
+#include <mutex>
+
+namespace VKR {
+    class VkContext;
+    class VkPipelineCacheManager;
+
+    /**
+     * @brief A Pipeline which may still be compiling.
+    */
+    class VkAsyncPipeline {
+    public:
+        VkAsyncPipeline() = default;
+        VkAsyncPipeline(const std::shared_future<VkPipeline>& future);
+
+        /**
+         * @brief Returns true once compilation has finished, whether or not it succeeded.
+        */
+        bool IsReady() const;
+
+        /**
+         * @brief Returns the Pipeline, blocking until it has compiled. VK_NULL_HANDLE if compilation failed.
+        */
+        VkPipeline Get() const;
+
+        /**
+         * @brief Returns the Pipeline if it has compiled, or 'placeholder' otherwise. Never blocks.
+        */
+        VkPipeline GetOr(const VkPipeline placeholder) const;
+
+    private:
+        std::shared_future<VkPipeline> m_Future;
+    };
+
+    /**
+     * @brief Compiles Pipelines on the Job System's worker threads, so the application can keep rendering while they complete.
+     * @remark Each thread compiles against its own worker cache from the VkPipelineCacheManager, so compilation never contends on a cache.
+     * The worker caches are merged into the main cache by Destroy(), which must therefore be called before VkPipelineCacheManager::Save().
+     * Builders are copied, but the Shader Modules they reference must stay alive until their Pipelines are ready.
+     * The caller owns every compiled Pipeline.
+    */
+    class VkPipelineCompiler {
+    public:
+        VkPipelineCompiler();
+
+        VkResult Create(const VkContext& context, VkPipelineCacheManager& cacheManager);
+
+        /**
+         * @brief Waits for outstanding compilations, then merges the worker caches into the main cache.
+        */
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Queues a Graphics Pipeline for compilation.
+        */
+        VkAsyncPipeline CompileGraphicsPipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout, const VkRenderPass renderPass, const uint32_t subpassIdx);
+
+        /**
+         * @brief Queues a Compute Pipeline for compilation.
+        */
+        VkAsyncPipeline CompileComputePipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout);
+
+        /**
+         * @brief Blocks until every queued Pipeline has compiled. The calling thread helps compile while waiting.
+        */
+        void WaitAll();
+
+        /**
+         * @brief Frees bookkeeping for completed compilations. Call periodically, e.g. once per frame.
+        */
+        void Collect();
+
+        const uint32_t GetPendingCount() const;
+
+    private:
+        struct Request {
+            VkPipelineBuilder builder;
+            VkPipelineLayout layout;
+            VkRenderPass renderPass;
+            uint32_t subpassIdx;
+            bool compute;
+            std::promise<VkPipeline> promise;
+            std::unique_ptr<Job> job;
+        };
+
+        VkAsyncPipeline Enqueue(const VkContext& context, std::unique_ptr<Request> request);
+        void Compile(const VkContext& context, Request& request, const uint32_t threadIndex);
+
+    private:
+        VkPipelineCacheManager* m_pCacheManager;
+        std::vector<VkPipelineCache> m_ThreadCaches;    //Indexed by Job System thread index.
+
+        std::list<std::unique_ptr<Request>> m_Requests;
+        mutable std::mutex m_Mutex;
+    };
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef __VKRENDERER_VKPIPELINEREGISTRY_H
+#define __VKRENDERER_VKPIPELINEREGISTRY_H
+/**
+*   @file VkPipelineRegistry.h
+*   @brief Deduplicating Pipeline Registry
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/13
+*/
+#include "VkCommon.h"
+#include "VkPipelineBuilder.h"
+#include "VkPipelineCompiler.h"
+#include <unordered_map>
+#include <mutex>
+
+namespace VKR {
+    class VkContext;
+    class VkPipelineCacheManager;
+
+    /**
+     * @brief Maps Pipeline state to Pipelines, so each unique permutation is only ever compiled once.
+     * @remark Requests are keyed with VkPipelineBuilder::BuildGraphicsPipelineKey() / BuildComputePipelineKey(). A request whose key
+     * is already registered returns the existing Pipeline, even if it's still compiling.
+     * The registry owns every Pipeline it returns, and destroys them in Destroy().
+    */
+    class VkPipelineRegistry {
+    public:
+        VkPipelineRegistry();
+
+        /**
+         * @brief Creates the registry.
+         * @param pCompiler Optional compiler. If provided, new Pipelines compile asynchronously. Otherwise they're created on the calling thread.
+        */
+        VkResult Create(const VkContext& context, VkPipelineCacheManager& cacheManager, VkPipelineCompiler* pCompiler = nullptr);
+
+        /**
+         * @brief Waits for any compiling Pipelines, then destroys every registered Pipeline.
+        */
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Returns the Pipeline matching the builder's state, creating it if it isn't registered. Thread safe.
+         * @remark If creation fails, the returned Pipeline's Get() is VK_NULL_HANDLE. Failed Pipelines aren't kept, so the next request retries them.
+        */
+        VkAsyncPipeline GetGraphicsPipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout, const VkRenderPass renderPass, const uint32_t subpassIdx);
+        VkAsyncPipeline GetComputePipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout);
+
+        /**
+         * @brief Returns true if a Pipeline with this key has been registered, and hasn't failed.
+        */
+        bool Contains(const VkPipelineKey& key);
+
+        const uint32_t GetPipelineCount();
+        const uint64_t GetHitCount() const;
+
+    private:
+        std::unordered_map<VkPipelineKey, VkAsyncPipeline, VkPipelineKey::Hasher> m_Pipelines;
+        uint64_t m_Hits;
+
+        VkPipelineCacheManager* m_pCacheManager;
+        VkPipelineCompiler* m_pCompiler;
+
+        std::mutex m_Mutex;
+    };
+}
+
+#endif
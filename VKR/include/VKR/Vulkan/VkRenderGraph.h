@@ -0,0 +1,250 @@
+#ifndef __VKRENDERER_VKRENDERGRAPH_H
+#define __VKRENDERER_VKRENDERGRAPH_H
+/**
+*   @file VkRenderGraph.h
+*   @brief Frame Graph with automatic Barriers and Transient Resource Aliasing
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/16
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <string>
+#include <functional>
+
+namespace VKR {
+    class VkContext;
+    class VkDeletionQueue;
+
+    /**
+     * @brief How a pass accesses a resource. Together with whether it's a read or a write, this determines the stages, access and layout it's used with.
+    */
+    enum class ERenderGraphUsage {
+        ColorAttachment = 0,        //Written through a Rendering Attachment, or read by loading it.
+        DepthStencilAttachment,     //Read only accesses use the read only layout.
+        SampledFragment,
+        SampledCompute,
+        StorageFragment,
+        StorageCompute,
+        Transfer,                   //Reads are transfer sources, and writes transfer destinations.
+        VertexInput,                //Vertex and Index Buffers.
+        Indirect,
+    };
+
+    /**
+     * @brief Describes a frame as a sequence of passes, and the resources each one reads and writes.
+     * @remark Passes are declared in submission order with AddPass(), followed by their attachments and accesses. Compile() then culls every pass
+     * which doesn't contribute to an imported resource (or has side effects), and creates the transient images, aliasing those with disjoint
+     * lifetimes in shared memory. Transients which are only attachments of a single pass, and are neither loaded nor stored, are created as transient
+     * attachments in lazily allocated memory where the device supports it, so tile-based GPUs never commit them. Execute() records the surviving passes, preceded by at most one vkCmdPipelineBarrier2() each, covering only the
+     * hazards and layout transitions the pass actually introduces. Passes with attachments are recorded within Dynamic Rendering.
+     * Imported resources are owned externally, and may be rebound each frame with SetImportedImage() / SetImportedBuffer().
+     * Requires Synchronization2 and Dynamic Rendering.
+    */
+    class VkRenderGraph {
+    public:
+        using ResourceHandle = uint32_t;
+        using PassHandle = uint32_t;
+        using ExecuteFunc = std::function<void(VkCommandBuffer commandBuffer)>;
+        static constexpr uint32_t INVALID_HANDLE = UINT32_MAX;
+
+        VkRenderGraph();
+
+        /**
+         * @brief Declares an externally owned image.
+         * @param initialLayout The layout the image is in at the start of each Execute(). Previous contents are discarded if VK_IMAGE_LAYOUT_UNDEFINED.
+         * @param initialStages The stages the image was last accessed in, or which a submission waits on before the image is available.
+         * @param finalLayout The layout the image is left in after Execute(), or VK_IMAGE_LAYOUT_UNDEFINED to leave it as last used.
+        */
+        ResourceHandle ImportImage(const char* name, const VkExtent2D extent, const VkFormat format, const VkImageLayout initialLayout, const VkPipelineStageFlags2 initialStages, const VkImageLayout finalLayout);
+
+        /**
+         * @brief Declares an externally owned buffer.
+        */
+        ResourceHandle ImportBuffer(const char* name, const VkPipelineStageFlags2 initialStages);
+
+        /**
+         * @brief Binds an imported resource for the following Execute() calls, e.g. to the acquired swapchain image.
+        */
+        void SetImportedImage(const ResourceHandle resource, const VkImage image, const VkImageView view);
+        void SetImportedBuffer(const ResourceHandle resource, const VkBuffer buffer);
+
+        /**
+         * @brief Declares an image owned by the graph, which only lives for the duration of a frame. Its contents are undefined at its first use each frame.
+         * @param usage Usage in addition to that implied by the image's accesses.
+        */
+        ResourceHandle CreateImage(const char* name, const VkExtent2D extent, const VkFormat format, const VkSampleCountFlagBits samples, const VkImageUsageFlags usage = 0);
+
+        /**
+         * @brief Resizes an image, e.g. after the swapchain is recreated. Transients are only resized by the next Compile().
+        */
+        void SetImageExtent(const ResourceHandle resource, const VkExtent2D extent);
+
+        /**
+         * @brief Declares a pass, recorded by 'func' after any Barriers it requires.
+         * @param renderingFlags Flags for the pass's vkCmdBeginRendering(), e.g. VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT.
+        */
+        PassHandle AddPass(const char* name, const ExecuteFunc& func, const VkRenderingFlags renderingFlags = 0);
+
+        /**
+         * @brief Adds a colour attachment to the pass, optionally resolved into 'resolveTarget'.
+         * @remark VK_ATTACHMENT_LOAD_OP_LOAD reads the attachment, so any pass writing it beforehand is retained.
+        */
+        void AddColorAttachment(const PassHandle pass, const ResourceHandle resource, const VkAttachmentLoadOp loadOp, const VkAttachmentStoreOp storeOp, const VkClearValue clearValue = {}, const ResourceHandle resolveTarget = INVALID_HANDLE);
+
+        /**
+         * @brief Sets the pass's depth attachment.
+         * @param readOnly If true, the attachment is only depth tested, and used in a read only layout.
+        */
+        void SetDepthAttachment(const PassHandle pass, const ResourceHandle resource, const VkAttachmentLoadOp loadOp, const VkAttachmentStoreOp storeOp, const VkClearValue clearValue = {}, const bool readOnly = false);
+
+        /**
+         * @brief Declares a non-attachment access to a resource.
+        */
+        void Read(const PassHandle pass, const ResourceHandle resource, const ERenderGraphUsage usage);
+        void Write(const PassHandle pass, const ResourceHandle resource, const ERenderGraphUsage usage);
+
+        /**
+         * @brief Prevents a pass from being culled, e.g. if it writes to memory the graph doesn't know about.
+        */
+        void SetSideEffects(const PassHandle pass);
+
+        /**
+         * @brief Culls unused passes, and creates and aliases the transient images.
+         * @remark When recompiling, the previous transients are retired to 'pDeletionQueue' at 'retireValue' if provided, and destroyed immediately otherwise,
+         * in which case the device must be idle.
+        */
+        VkResult Compile(const VkContext& context, VkDeletionQueue* pDeletionQueue = nullptr, const uint64_t retireValue = 0);
+
+        /**
+         * @brief Records the graph into 'commandBuffer'.
+        */
+        void Execute(const VkContext& context, const VkCommandBuffer commandBuffer);
+
+        /**
+         * @brief Destroys the transient images and their memory, and clears the graph.
+        */
+        void Destroy(const VkContext& context);
+
+        const VkImage GetImage(const ResourceHandle resource) const;
+        const VkImageView GetImageView(const ResourceHandle resource) const;
+
+        const uint32_t GetPassCount() const;
+        const uint32_t GetCulledPassCount() const;
+        const uint32_t GetBarrierCount() const;             //Barriers recorded by the last Execute().
+        const VkDeviceSize GetTransientMemorySize() const;  //Memory allocated for transients, after aliasing.
+        const VkDeviceSize GetUnaliasedMemorySize() const;  //Memory the transients would require without aliasing.
+        const VkDeviceSize GetLazyMemorySize() const;       //Of the transient memory, that which is lazily allocated.
+
+    private:
+        struct Access {
+            ResourceHandle resource;
+            VkPipelineStageFlags2 stages;
+            VkAccessFlags2 access;
+            VkImageLayout layout;
+            bool read;                  //Depends on the resource's previous contents.
+            bool write;
+        };
+
+        struct Attachment {
+            ResourceHandle resource;
+            VkAttachmentLoadOp loadOp;
+            VkAttachmentStoreOp storeOp;
+            VkClearValue clearValue;
+            ResourceHandle resolveTarget;
+        };
+
+        struct Pass {
+            std::string name;
+            ExecuteFunc func;
+            VkRenderingFlags renderingFlags;
+
+            std::vector<Access> accesses;       //One per resource.
+            std::vector<Attachment> colorAttachments;
+            Attachment depthAttachment;
+            bool hasDepthAttachment;
+            bool readOnlyDepth;
+
+            bool sideEffects;
+            bool culled;
+        };
+
+        //Synchronization state of a resource, as of the last recorded access.
+        struct State {
+            VkImageLayout layout;
+            VkPipelineStageFlags2 writeStages;  //Stages of the last write, or layout transition.
+            VkAccessFlags2 writeAccess;
+            VkPipelineStageFlags2 readStages;   //Stages which have read the resource since the last write.
+            VkPipelineStageFlags2 visibleStages;  //Stages the last write has been made visible to.
+            VkAccessFlags2 visibleAccess;
+        };
+
+        struct Resource {
+            std::string name;
+            bool imported;
+            bool isBuffer;
+
+            VkExtent2D extent;
+            VkFormat format;
+            VkImageAspectFlags aspect;
+            VkSampleCountFlagBits samples;
+            VkImageUsageFlags usage;
+
+            VkImageLayout initialLayout;
+            VkPipelineStageFlags2 initialStages;
+            VkImageLayout finalLayout;
+
+            VkImage image;
+            VkImageView view;
+            VkBuffer buffer;
+
+            //Transients only.
+            uint32_t firstPass;
+            uint32_t lastPass;
+            uint32_t memorySlot;
+            VkMemoryRequirements memoryRequirements;
+            bool lazy;                  //Never loaded or stored, so may be lazily allocated.
+
+            State state;
+            bool used;                  //Accessed yet this Execute().
+        };
+
+        //A block of memory shared by transients with disjoint lifetimes.
+        struct MemorySlot {
+            VmaAllocation allocation;
+            VkMemoryRequirements requirements;
+            std::vector<ResourceHandle> resources;
+            bool lazy;
+
+            //The slot's last access, which the first use of an aliasing resource must wait on.
+            VkPipelineStageFlags2 lastStages;
+            VkAccessFlags2 lastWriteAccess;
+        };
+
+    private:
+        void AddAccess(const PassHandle pass, const ResourceHandle resource, const ERenderGraphUsage usage, const bool read, const bool write);
+        void CullPasses();
+        bool IsLazy(const ResourceHandle resource) const;
+        VkResult CreateTransients(const VkContext& context);
+        void DestroyTransients(const VkContext& context, VkDeletionQueue* pDeletionQueue = nullptr, const uint64_t retireValue = 0);
+        void RecordBarrier(Resource& resource, const Access& access, std::vector<VkImageMemoryBarrier2>& imageBarriers, std::vector<VkBufferMemoryBarrier2>& bufferBarriers);
+        void RecordPass(const VkContext& context, const VkCommandBuffer commandBuffer, const Pass& pass);
+
+    private:
+        std::vector<Pass> m_Passes;
+        std::vector<Resource> m_Resources;
+        std::vector<MemorySlot> m_MemorySlots;
+
+        std::vector<VkImageMemoryBarrier2> m_ImageBarriers;
+        std::vector<VkBufferMemoryBarrier2> m_BufferBarriers;
+        std::vector<VkRenderingAttachmentInfo> m_ColorAttachmentInfos;
+
+        uint32_t m_NumCulledPasses;
+        uint32_t m_NumBarriers;
+        VkDeviceSize m_TransientMemorySize;
+        VkDeviceSize m_UnaliasedMemorySize;
+        VkDeviceSize m_LazyMemorySize;
+        bool m_Compiled;
+    };
+}
+
+#endif
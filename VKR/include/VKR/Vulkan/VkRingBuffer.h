@@ -0,0 +1,103 @@
+#ifndef __VKRENDERER_VKRINGBUFFER_H
+#define __VKRENDERER_VKRINGBUFFER_H
+/**
+*   @file VkRingBuffer.h
+*   @brief Per-Frame Linear Upload Ring Buffer
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/07
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <mutex>
+#include <cstring>
+
+namespace VKR {
+    class VkContext;
+
+    /**
+     * @brief A persistently mapped buffer, linearly sub-allocated each frame for uniforms and other transient data.
+     * @remark Allocations made during a frame are reclaimed the next time that frame in flight is begun,
+     * so the caller must have waited on the frame's fence (see VkFrameContext::BeginFrame()) before calling BeginFrame().
+    */
+    class VkRingBuffer {
+    public:
+        /**
+         * @brief A sub-allocation of the ring buffer.
+         * @note 'offset' may be passed directly as a dynamic offset for a VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC binding.
+        */
+        struct Allocation {
+            VkDeviceSize offset;
+            void* pData;
+        };
+
+        VkRingBuffer();
+
+        /**
+         * @brief Creates the ring buffer.
+         * @param size Capacity of the ring, shared between all frames in flight.
+         * @param usage Buffer usage. Typically VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT.
+         * @param framesInFlight The number of frames which may be in flight at once.
+        */
+        VkResult Create(const VkContext& context, const VkDeviceSize size, const VkBufferUsageFlags usage, const uint32_t framesInFlight);
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Begins allocating for a frame in flight, reclaiming everything that frame allocated previously.
+        */
+        void BeginFrame(const uint32_t frameIndex);
+
+        /**
+         * @brief Flushes the current frame's writes, making them visible to the device. Must be called before submission.
+        */
+        VkResult EndFrame(const VkContext& context);
+
+        /**
+         * @brief Sub-allocates from the current frame. Thread safe.
+         * @param size Number of bytes to allocate.
+         * @param pAllocation Receives the allocation.
+         * @param alignment Required alignment. 0 uses the device's minimum uniform buffer offset alignment.
+         * @return VK_ERROR_OUT_OF_DEVICE_MEMORY if the ring has no space remaining.
+        */
+        VkResult Allocate(const VkDeviceSize size, Allocation* pAllocation, const VkDeviceSize alignment = 0);
+
+        /**
+         * @brief Allocates and copies 'data' into the current frame.
+        */
+        template<typename T>
+        VkResult Push(const T& data, Allocation* pAllocation);
+
+        const VkBuffer& GetBuffer() const;
+        const VkDeviceSize GetAlignment() const;
+
+    private:
+        VkBufferResource m_Buffer;
+        uint8_t* m_pData;
+
+        VkDeviceSize m_Size;
+        VkDeviceSize m_Alignment;
+
+        //Offsets are tracked as ever-increasing 'virtual' offsets; the physical offset is (virtual % m_Size).
+        VkDeviceSize m_Head;
+        VkDeviceSize m_Tail;
+        VkDeviceSize m_FrameStart;
+
+        uint32_t m_FrameIndex;
+        std::vector<VkDeviceSize> m_FrameEnds;
+
+        std::mutex m_Mutex;
+    };
+
+
+    template<typename T>
+    inline VkResult VkRingBuffer::Push(const T& data, Allocation* pAllocation)
+    {
+        VkResult result = Allocate(sizeof(T), pAllocation);
+        if (result == VK_SUCCESS) {
+            memcpy(pAllocation->pData, &data, sizeof(T));
+        }
+
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef __VKRENDERER_VKSHADERHOTRELOAD_H
+#define __VKRENDERER_VKSHADERHOTRELOAD_H
+/**
+*   @file VkShaderHotReload.h
+*   @brief File-watching Shader Reloading
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/15
+*/
+#include "VkCommon.h"
+#include "VkPipelineBuilder.h"
+#include "VkPipelineCompiler.h"
+#include "../Jobs.h"
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace VKR {
+    class VkContext;
+    class VkPipelineRegistry;
+
+    /**
+     * @brief Watches shader sources and SPIR-V on disk, and rebuilds the Pipelines using them when they change.
+     * @remark Shaders are loaded with LoadShader(), and Pipelines built from their modules are registered with AddGraphicsPipeline() / AddComputePipeline().
+     * When a watched source changes, it's recompiled to SPIR-V on a worker thread with an external compiler (glslc by default), and a new module is created.
+     * Update() then rebuilds only the Pipelines using that module through the registry, and swaps each one in once it has compiled,
+     * so a Pipeline returned by GetPipeline() never changes mid-frame. Call it once per frame, before recording.
+     * Changes are detected with inotify on Linux, and by polling modification times elsewhere.
+     * The registry retains superseded Pipelines, so reverting a shader reuses its earlier Pipeline. Changes to a shader's interface
+     * (descriptors, push constants, vertex inputs) still require a restart, as Pipeline Layouts are not rebuilt.
+    */
+    class VkShaderHotReload {
+    public:
+        using ShaderHandle = uint32_t;
+        using PipelineHandle = uint32_t;
+        static constexpr uint32_t INVALID_HANDLE = UINT32_MAX;
+
+        VkShaderHotReload();
+
+        /**
+         * @brief Starts watching for changes.
+         * @param compilerCommand Invoked as "<compilerCommand> <source> -o <spirv>" to recompile a changed source.
+        */
+        VkResult Create(const VkContext& context, VkPipelineRegistry& registry, const char* compilerCommand = "glslc");
+
+        /**
+         * @brief Waits for any in-flight recompilation, then destroys every Shader Module. Pipelines remain owned by the registry.
+        */
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Loads a SPIR-V shader, and watches it for changes.
+         * @param spirvPath The SPIR-V to load.
+         * @param sourcePath Optional source the SPIR-V is compiled from. If provided, changes to the source are recompiled into 'spirvPath'.
+         * @param pHandle Receives the shader's handle.
+        */
+        VkResult LoadShader(const VkContext& context, const char* spirvPath, const char* sourcePath, ShaderHandle* pHandle);
+
+        /**
+         * @brief Returns the shader's current module, and a hash of its SPIR-V suitable for VkPipelineBuilder::AddShaderStage().
+        */
+        VkShaderModule GetShaderModule(const ShaderHandle handle) const;
+        uint64_t GetShaderID(const ShaderHandle handle) const;
+
+        /**
+         * @brief Requests a Pipeline from the registry, and rebuilds it whenever one of the builder's loaded shaders changes.
+        */
+        PipelineHandle AddGraphicsPipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout, const VkRenderPass renderPass, const uint32_t subpassIdx);
+        PipelineHandle AddComputePipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout);
+
+        /**
+         * @brief Returns the Pipeline's current handle, or 'placeholder' if it hasn't finished compiling.
+        */
+        VkPipeline GetPipeline(const PipelineHandle handle, const VkPipeline placeholder = VK_NULL_HANDLE) const;
+
+        /**
+         * @brief Processes file changes, starts recompiling changed shaders, and swaps in any rebuilt Pipelines which are ready.
+         * @remark Must be called at a frame boundary, on the thread which records commands.
+        */
+        void Update(const VkContext& context);
+
+        /**
+         * @brief Returns the number of Pipelines swapped in since creation.
+        */
+        const uint32_t GetReloadCount() const;
+
+    private:
+        struct Shader {
+            std::string spirvPath;
+            std::string sourcePath;
+            VkShaderModule module;
+            uint64_t id;
+
+            //In-flight recompilation. Written by the Job, and read once it completes.
+            std::unique_ptr<Job> job;
+            VkShaderModule pendingModule;
+            uint64_t pendingID;
+            bool recompile;             //The source changed, so the SPIR-V must be rebuilt before loading.
+            bool dirty;                 //Changed again before the Job was applied.
+        };
+
+        struct Pipeline {
+            VkPipelineBuilder builder;
+            VkPipelineLayout layout;
+            VkRenderPass renderPass;
+            uint32_t subpassIdx;
+            bool compute;
+
+            VkAsyncPipeline current;
+            VkAsyncPipeline pending;
+            bool hasPending;
+        };
+
+        //Superseded modules may still be referenced by compiling Pipelines.
+        struct RetiredModule {
+            VkShaderModule module;
+            std::vector<VkAsyncPipeline> dependents;
+        };
+
+    private:
+        void Watch(const std::string& filePath);
+        void PollChanges(std::vector<std::string>& changedFiles);
+        void Reload(const VkContext& context, Shader& shader);
+        void ApplyReload(const VkContext& context, Shader& shader);
+        VkAsyncPipeline RequestPipeline(const VkContext& context, const Pipeline& pipeline);
+
+    private:
+        std::vector<std::unique_ptr<Shader>> m_Shaders;
+        std::vector<Pipeline> m_Pipelines;
+        std::vector<RetiredModule> m_RetiredModules;
+
+        VkPipelineRegistry* m_pRegistry;
+        std::string m_CompilerCommand;
+        uint32_t m_ReloadCount;
+
+        //inotify instance and watched directories on Linux, or watched files and their modification times elsewhere.
+        int m_WatchFD;
+        std::vector<std::pair<int, std::string>> m_WatchedDirectories;
+        std::vector<std::pair<std::string, int64_t>> m_WatchedFiles;
+    };
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef __VKRENDERER_VKSHADERREFLECTION_H
+#define __VKRENDERER_VKSHADERREFLECTION_H
+/**
+*   @file VkShaderReflection.h
+*   @brief SPIR-V Reflection of Descriptor, Push Constant and Vertex Input Layouts
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/14
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <string>
+
+namespace VKR {
+    class VkContext;
+    class VkLayoutCache;
+    class VkPipelineBuilder;
+
+    /**
+     * @brief A descriptor declared by one or more shader stages.
+    */
+    struct VkReflectedBinding {
+        uint32_t set;
+        uint32_t binding;
+        VkDescriptorType type;
+        uint32_t count;                 //0 for runtime sized arrays.
+        VkShaderStageFlags stages;
+    };
+
+    /**
+     * @brief A vertex shader input.
+    */
+    struct VkReflectedVertexInput {
+        uint32_t location;
+        VkFormat format;
+        uint32_t size;                  //Bytes
+    };
+
+    /**
+     * @brief Everything reflected from a single shader stage.
+    */
+    struct VkShaderStageReflection {
+        VkShaderStageFlagBits stage;
+        std::vector<VkReflectedBinding> bindings;
+        std::vector<VkReflectedVertexInput> vertexInputs;      //Sorted by location. Only populated for vertex shaders.
+        uint32_t pushConstantOffset;
+        uint32_t pushConstantSize;      //0 if the stage has no push constants.
+    };
+
+    /**
+     * @brief Derives Pipeline Layouts and Vertex Input State from SPIR-V, so they needn't be written by hand to match the shaders.
+     * @remark Each stage is reflected with ReflectStage(), or ReflectStageCached() which stores the result on disk keyed by a hash of the SPIR-V,
+     * so warm starts skip parsing entirely. Stages are then combined with AddStage(), which merges their interfaces.
+    */
+    class VkShaderReflection {
+    public:
+        VkShaderReflection();
+
+        /**
+         * @brief Hashes a SPIR-V blob. Suitable as a stable shader identifier for VkPipelineBuilder::AddShaderStage().
+        */
+        static uint64_t HashSPIRV(const char* pBlob, const size_t byteWidth);
+
+        /**
+         * @brief Parses a SPIR-V blob, as passed to VkContext::CreateShaderModule().
+        */
+        static VkResult ReflectStage(const char* pBlob, const size_t byteWidth, VkShaderStageReflection* pReflection);
+
+        /**
+         * @brief As ReflectStage(), but loads the result from 'cacheDirectory' if this SPIR-V has been reflected before, and stores it otherwise.
+        */
+        static VkResult ReflectStageCached(const char* pBlob, const size_t byteWidth, const char* cacheDirectory, VkShaderStageReflection* pReflection);
+
+        /**
+         * @brief Merges a stage's interface into the reflection. Bindings shared between stages are combined.
+        */
+        void AddStage(const VkShaderStageReflection& stage);
+
+        /**
+         * @brief Retrieves a Set Layout per descriptor set, and a Pipeline Layout, from the cache.
+         * @param maxUnboundedDescriptors The descriptor count used for runtime sized arrays, which are created partially bound.
+         * @param pSetLayouts Optionally receives the Set Layouts, indexed by set.
+        */
+        VkResult CreatePipelineLayout(const VkContext& context, VkLayoutCache& layoutCache, VkPipelineLayout* pPipelineLayout, std::vector<VkDescriptorSetLayout>* pSetLayouts = nullptr, const uint32_t maxUnboundedDescriptors = 1024) const;
+
+        /**
+         * @brief Describes the vertex inputs as a single interleaved binding, with attributes packed in location order.
+        */
+        void GetVertexInputState(std::vector<VkVertexInputBindingDescription>& bindings, std::vector<VkVertexInputAttributeDescription>& attributes, const uint32_t binding = 0) const;
+
+        /**
+         * @brief Sets the builder's Vertex Input State to GetVertexInputState().
+        */
+        void ApplyVertexInputState(VkPipelineBuilder& builder, const uint32_t binding = 0) const;
+
+        const std::vector<VkReflectedBinding>& GetBindings() const;
+        const std::vector<VkPushConstantRange>& GetPushConstantRanges() const;
+        const std::vector<VkReflectedVertexInput>& GetVertexInputs() const;
+
+    private:
+        static bool LoadStage(const std::string& filePath, const uint64_t hash, VkShaderStageReflection* pReflection);
+        static void SaveStage(const std::string& filePath, const uint64_t hash, const VkShaderStageReflection& reflection);
+
+    private:
+        std::vector<VkReflectedBinding> m_Bindings;
+        std::vector<VkPushConstantRange> m_PushConstantRanges;
+        std::vector<VkReflectedVertexInput> m_VertexInputs;
+    };
+}
+
+#endif
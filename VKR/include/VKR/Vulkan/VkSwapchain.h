@@ -8,16 +8,51 @@
 */
 #include "VkCommon.h"
 #include <vector> 
+#include <functional>
 
 namespace VKR {
     class VkContext;
+    class VkDeletionQueue;
     class Window;
 
+    /**
+     * @brief Trades latency against throughput for a swapchain.
+    */
+    struct VkPresentConfig {
+        VkPresentModeKHR presentMode;   //IMMEDIATE, MAILBOX, FIFO or FIFO_RELAXED. Falls back to FIFO, which is always supported.
+        uint32_t imageCount;            //0 requests one more than the surface's minimum. Clamped to the surface's limits.
+        uint32_t framesInFlight;        //Frames the CPU may record ahead of the GPU. Not applied by the swapchain, but by the VkFrameContext created with it.
+    };
+
+    /**
+     * @brief Owns a window's Surface and Swapchain.
+     * @remark When the window is resized, or acquisition or presentation reports the swapchain as out of date or suboptimal, NeedsRecreation() returns true.
+     * Recreate() then builds a new swapchain from the old one, and retires the old swapchain and its views through a deletion queue, so nothing waits on the device.
+     * Anything sized to the swapchain should be rebuilt from a callback registered with AddRecreateCallback(), retiring its old resources likewise.
+     * A headless swapchain, created with CreateHeadless(), renders into a ring of offscreen images behind the same interface, and needs neither a window,
+     * a surface, nor VK_KHR_swapchain, so it runs on software drivers without a display.
+    */
     class VkSwapchain {
     public:
+        /**
+         * @brief Called after the swapchain is recreated. Resources the GPU may still be using should be pushed to 'deletionQueue' at 'retireValue'.
+        */
+        using RecreateCallback = std::function<void(const VkContext& context, const VkSwapchain& swapchain, VkDeletionQueue& deletionQueue, const uint64_t retireValue)>;
+
         VkSwapchain(); 
 
-        VkResult Create(const VkContext& context, const Window* pWindow, const uint32_t queueFamilyIndex);
+        /**
+         * @param pConfig The present configuration. If nullptr, MAILBOX is preferred, with one image above the minimum and 2 frames in flight.
+        */
+        VkResult Create(const VkContext& context, const Window* pWindow, const uint32_t queueFamilyIndex, const VkPresentConfig* pConfig = nullptr);
+
+        /**
+         * @brief Creates a ring of offscreen images, rather than a surface and swapchain.
+         * @remark Acquiring and presenting an image each submit an empty batch to 'queue', to signal and wait on their semaphores.
+         * The ring holds at least pConfig->framesInFlight images, so an image is never reacquired before the frame last rendering to it completes.
+         * @param pConfig The image count and frames in flight. The present mode is ignored.
+        */
+        VkResult CreateHeadless(const VkContext& context, const VkExtent2D extent, const VkQueue queue, const uint32_t queueFamilyIndex, const VkPresentConfig* pConfig = nullptr);
         void Destroy(const VkContext& context);
 
         const VkSwapchainKHR& GetSwapchain() const;
@@ -25,24 +60,78 @@ namespace VKR {
         const uint32_t GetImageCount() const;
         const std::vector<VkImage>& GetImages() const;
         const std::vector<VkImageView>& GetImageViews() const;
+        const VkExtent2D GetExtent() const;
+
+        /**
+         * @brief Returns the requested configuration. The present mode and image count in use may differ, if unsupported.
+        */
+        const VkPresentConfig& GetPresentConfig() const;
+        const VkPresentModeKHR GetPresentMode() const;
+        const uint32_t GetFramesInFlight() const;
+        const bool IsPresentModeSupported(const VkPresentModeKHR presentMode) const;
+
+        /**
+         * @brief Returns true if created with CreateHeadless().
+        */
+        const bool IsHeadless() const;
+
+        /**
+         * @brief Returns the layout images must be in when presented. Headless images are left ready for ReadbackImage().
+        */
+        const VkImageLayout GetPresentLayout() const;
+
+        /**
+         * @brief Copies a presented headless image into 'pixels', as tightly packed 8-bit RGBA. Blocks until the copy completes.
+         * @return VK_ERROR_FEATURE_NOT_PRESENT if the swapchain isn't headless.
+        */
+        VkResult ReadbackImage(const VkContext& context, const uint32_t index, std::vector<uint8_t>& pixels);
+
+        /**
+         * @brief Requests a different present mode, applied when the swapchain is next recreated.
+        */
+        void SetPresentMode(const VkPresentModeKHR presentMode);
 
 
         void SetClearValue(float r, float g, float b, float a, float depth, uint32_t stencil);
         VkClearValue GetColourClearValue() const;
         VkClearValue GetDepthStencilClearValue() const;
 
+        /**
+         * @brief Acquires the next image. VK_ERROR_OUT_OF_DATE_KHR and VK_SUBOPTIMAL_KHR flag the swapchain for recreation.
+         * @remark On VK_ERROR_OUT_OF_DATE_KHR, 'semaphore' is left unsignalled, so the swapchain should be recreated and the image acquired again.
+        */
+        VkResult AcquireNextImage(const VkContext& context, VkSemaphore semaphore, uint32_t* pIndex);
+
+        /**
+         * @brief Presents an image. VK_ERROR_OUT_OF_DATE_KHR and VK_SUBOPTIMAL_KHR flag the swapchain for recreation.
+        */
         VkResult Present(VkQueue queue, VkSemaphore semaphore, uint32_t* pIndex);
 
+        /**
+         * @brief Returns true if the swapchain was reported out of date, or no longer matches the window's size.
+        */
+        const bool NeedsRecreation() const;
+
+        /**
+         * @brief Recreates the swapchain at the window's current size, then invokes every recreate callback.
+         * @param retireValue The timeline value after which the GPU no longer uses the old swapchain, e.g. the last submitted frame's value.
+         * @return VK_NOT_READY if the window has no drawable area, in which case the swapchain is left unchanged.
+        */
+        VkResult Recreate(const VkContext& context, VkDeletionQueue& deletionQueue, const uint64_t retireValue);
+
+        void AddRecreateCallback(const RecreateCallback& callback);
+
     private:
         VkResult CreateSurfaceKHR(const VkInstance& device, const Window* pWindow);
         void DestroySurfaceKHR(const VkInstance& instance);
 
-        VkResult CreateSwapchainKHR(const VkDevice& device, const uint32_t imageCount, const uint32_t width, const uint32_t height, const uint32_t queueFamily);
+        VkResult CreateSwapchainKHR(const VkDevice& device, const uint32_t imageCount, const uint32_t width, const uint32_t height, const uint32_t queueFamily, const VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE);
         void DestroySwapchainKHR(const VkDevice& device);
 
         const uint32_t SelectImageCount();
+        VkExtent2D SelectExtent() const;
         VkResult AcquireSwapchainImages(const VkContext& context);
-        VkPresentModeKHR SelectPresentMode(const uint64_t numModes, const VkPresentModeKHR* pModes);
+        VkPresentModeKHR SelectPresentMode(const VkPresentModeKHR requested);
         VkSurfaceFormatKHR SelectSurfaceFormat(const uint64_t numFormats, const VkSurfaceFormatKHR* pFormats);
 
 
@@ -55,9 +144,26 @@ namespace VKR {
         VkSurfaceCapabilitiesKHR m_SurfaceCapabilities;
         VkSurfaceFormatKHR m_SurfaceFormat;
         VkPresentModeKHR m_SurfacePresentMode;
+        std::vector<VkPresentModeKHR> m_SupportedPresentModes;
+        VkPresentConfig m_PresentConfig;
 
         VkClearValue m_ColourClearValue;
         VkClearValue m_DepthStencilClearValue;
+
+        const Window* m_pWindow;
+        uint32_t m_QueueFamilyIndex;
+        VkExtent2D m_Extent;
+        bool m_OutOfDate;
+        std::vector<RecreateCallback> m_RecreateCallbacks;
+
+        //Headless only.
+        bool m_Headless;
+        VkQueue m_Queue;
+        uint32_t m_NextImage;
+        std::vector<VmaAllocation> m_ImageAllocations;
+        VkCommandPool m_ReadbackPool;
+        VkCommandBuffer m_ReadbackCommandBuffer;
+        VkBufferResource m_ReadbackBuffer;
     };
 };
 
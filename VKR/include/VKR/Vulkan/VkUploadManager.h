@@ -0,0 +1,124 @@
+#ifndef __VKRENDERER_VKUPLOADMANAGER_H
+#define __VKRENDERER_VKUPLOADMANAGER_H
+/**
+*   @file VkUploadManager.h
+*   @brief Staging Uploads to Device-Local Memory
+*   @author Ewan Burnett (EwanBurnettSK@Outlook.com)
+*   @date 2024/05/08
+*/
+#include "VkCommon.h"
+#include <vector>
+#include <mutex>
+
+namespace VKR {
+    class VkContext;
+
+    /**
+     * @brief Batches copies from host memory into device-local Buffers and Images, through a persistently mapped staging ring.
+     * @remark Batches are submitted on their own queue (ideally from a Transfer-only family), and signal a Timeline Semaphore on completion.
+     * Consumers wait on the returned token on the GPU, so uploads never stall the graphics queue.
+     * Staging space is reclaimed by Collect() once the batch using it completes. Uploads which don't fit in the ring fall back to a dedicated staging buffer.
+    */
+    class VkUploadManager {
+    public:
+        VkUploadManager();
+
+        /**
+         * @brief Creates the Upload Manager.
+         * @param queueFamilyIndex The Queue Family uploads are submitted to.
+         * @param queue The Queue uploads are submitted to.
+         * @param dstQueueFamilyIndex The Queue Family which will consume uploaded resources. If it differs from queueFamilyIndex, ownership is transferred.
+         * @param stagingSize Capacity of the staging ring, shared between all batches in flight.
+        */
+        VkResult Create(const VkContext& context, const uint32_t queueFamilyIndex, const VkQueue queue, const uint32_t dstQueueFamilyIndex, const VkDeviceSize stagingSize = 16 * 1024 * 1024);
+        void Destroy(const VkContext& context);
+
+        /**
+         * @brief Records a copy into a Buffer in the current batch.
+         * @param dst The destination Buffer. Must have been created with VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+         * @param dstStageMask The stages the consuming Queue reads the buffer in.
+         * @param dstAccessMask How the consuming Queue reads the buffer.
+        */
+        VkResult UploadBuffer(const VkContext& context, const VkBuffer dst, const VkDeviceSize dstOffset, const void* pData, const VkDeviceSize size, const VkPipelineStageFlags dstStageMask, const VkAccessFlags dstAccessMask);
+
+        /**
+         * @brief Records a copy into mip 0 of a 2D Image in the current batch, transitioning it to 'finalLayout'.
+         * @param dst The destination Image, in VK_IMAGE_LAYOUT_UNDEFINED. Must have been created with VK_IMAGE_USAGE_TRANSFER_DST_BIT.
+         * @param dstStageMask The stages the consuming Queue reads the image in.
+         * @param dstAccessMask How the consuming Queue reads the image.
+        */
+        VkResult UploadImage(const VkContext& context, const VkImage dst, const VkExtent3D extents, const VkImageAspectFlags aspect, const VkImageLayout finalLayout, const void* pData, const VkDeviceSize size, const VkPipelineStageFlags dstStageMask, const VkAccessFlags dstAccessMask);
+
+        /**
+         * @brief Submits the current batch.
+         * @param pToken Optionally receives the batch's completion token: the value GetSemaphore() reaches once it completes.
+        */
+        VkResult Submit(const VkContext& context, uint64_t* pToken = nullptr);
+
+        /**
+         * @brief Records ownership acquisition for all submitted uploads into a command buffer on the destination Queue Family.
+         * @param pWaitStageMask Receives the stages the consuming submission must wait at: those passed with each upload.
+         * @return The token the submission containing 'cmd' must wait on, or 0 if there is nothing new to wait on.
+        */
+        uint64_t AcquireUploads(VkCommandBuffer cmd, VkPipelineStageFlags* pWaitStageMask);
+
+        bool IsComplete(const VkContext& context, const uint64_t token) const;
+        VkResult Wait(const VkContext& context, const uint64_t token, const uint64_t timeout = UINT64_MAX) const;
+
+        /**
+         * @brief Releases the staging memory and command buffers of completed batches.
+        */
+        void Collect(const VkContext& context);
+
+        const VkSemaphore& GetSemaphore() const;
+        const uint32_t GetQueueFamilyIndex() const;
+
+    private:
+        struct Batch {
+            VkCommandBuffer cmd;
+            VkDeviceSize stagingEnd;                    //The staging ring's head once the batch was recorded. Reclaimed on completion.
+            std::vector<VkBufferResource> overflow;     //Dedicated staging buffers, for uploads which didn't fit in the ring.
+            uint64_t token;
+        };
+
+        VkResult BeginBatch(const VkContext& context);
+
+        /**
+         * @brief Copies 'pData' into staging memory for the current batch, returning the buffer and offset to copy from.
+        */
+        VkResult Stage(const VkContext& context, const void* pData, const VkDeviceSize size, VkBuffer* pBuffer, VkDeviceSize* pOffset);
+
+    private:
+        uint32_t m_QueueFamilyIndex;
+        uint32_t m_DstQueueFamilyIndex;
+        VkQueue m_Queue;
+        VkCommandPool m_CommandPool;
+
+        VkBufferResource m_Staging;
+        uint8_t* m_pStagingData;
+        VkDeviceSize m_StagingSize;
+
+        //Offsets are tracked as ever-increasing 'virtual' offsets; the physical offset is (virtual % m_StagingSize).
+        VkDeviceSize m_StagingHead;
+        VkDeviceSize m_StagingTail;
+
+        VkSemaphore m_Semaphore;
+        uint64_t m_NextToken;
+        uint64_t m_AcquiredToken;
+
+        Batch m_Current;
+        std::vector<Batch> m_InFlight;
+
+        //Acquire halves of queue family ownership transfers, recorded by AcquireUploads().
+        std::vector<VkBufferMemoryBarrier> m_PendingBufferBarriers;
+        std::vector<VkImageMemoryBarrier> m_PendingImageBarriers;
+        std::vector<VkBufferMemoryBarrier> m_SubmittedBufferBarriers;
+        std::vector<VkImageMemoryBarrier> m_SubmittedImageBarriers;
+        VkPipelineStageFlags m_PendingStageMask;
+        VkPipelineStageFlags m_SubmittedStageMask;
+
+        std::mutex m_Mutex;
+    };
+}
+
+#endif
@@ -18,9 +18,10 @@ namespace VKR {
          * @param title 
          * @param width 
          * @param height 
+         * @param resizable If true, the window's width and height track its framebuffer as it's resized. 
          * @return 
         */
-        Status Create(const char* title, const uint32_t width, const uint32_t height);
+        Status Create(const char* title, const uint32_t width, const uint32_t height, const bool resizable = false);
 
         /**
          * @brief Destroys a Window. 
@@ -38,6 +39,11 @@ namespace VKR {
 
         void SetTitle(const char* title);
 
+        /**
+         * @brief Returns true if the window has no drawable area, e.g. while minimized. 
+        */
+        const bool IsMinimized() const;
+
         /**
          * @brief Returns a window's internal GLFW Handle. 
          * @return 
@@ -49,6 +55,14 @@ namespace VKR {
          * @return true after polling events, false on window destruction.
         */
         const bool PollEvents() const;
+
+        /**
+         * @brief Blocks until an OS Event arrives, e.g. to idle while minimized. 
+        */
+        void WaitEvents() const;
+    private:
+        static void FramebufferSizeCallback(GLFWwindow* pWindow, int width, int height);
+
     private:
         GLFWwindow* m_Handle;
 
@@ -1,6 +1,9 @@
 #include "../include/VKR/File.h"
 #include "../include/VKR/Logger.h"
 #include <fstream>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
 #include <easy/profiler.h>
 
 const bool VKR::IO::FileExists(const char* filePath)
@@ -59,6 +62,23 @@ VKR::Status VKR::IO::WriteFile(const char* filePath, const void* pData, const si
     return Status::SUCCESS;
 }
 
+VKR::Status VKR::IO::WritePNG(const char* filePath, const uint32_t width, const uint32_t height, const void* pPixels)
+{
+    EASY_FUNCTION(profiler::colors::Blue600);
+    Log::Debug("[I/O]\tWriting PNG %s.\n", filePath);
+    if (!pPixels) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[I/O]\tWritePNG() was called, but pPixels was nullptr!\n"); 
+        return Status::FAILED; 
+    }
+
+    if (!stbi_write_png(filePath, width, height, 4, pPixels, width * 4)) {
+        Log::Warning("[I/O]\tFailed to write PNG \"%s\".\n", filePath);
+        return Status::FAILED;
+    }
+
+    return Status::SUCCESS;
+}
+
 VKR::Status VKR::IO::CreateDirectory(const char* dirPath)
 {
     EASY_FUNCTION(profiler::colors::Blue600);
@@ -0,0 +1,215 @@
+#include "../include/VKR/Jobs.h"
+#include "../include/VKR/VKR.h"
+#include "../include/VKR/Logger.h"
+#include <easy/profiler.h>
+#include <cstdio>
+#include <algorithm>
+
+enki::TaskScheduler VKR::Jobs::s_Scheduler;
+bool VKR::Jobs::s_bIsInitialized = false;
+
+//enkiTS may be built with fewer priority levels, so clamp to the lowest it supports.
+static enki::TaskPriority ToTaskPriority(const VKR::EJobPriority priority)
+{
+    return static_cast<enki::TaskPriority>(std::min(static_cast<int>(priority), static_cast<int>(enki::TASK_PRIORITY_NUM) - 1));
+}
+
+
+void VKR::IJob::DependsOn(const IJob& dependency)
+{
+    m_Dependencies.emplace_back();
+    GetCompletable()->SetDependency(m_Dependencies.back(), dependency.GetCompletable());
+}
+
+void VKR::IJob::ClearDependencies()
+{
+    m_Dependencies.clear();
+}
+
+bool VKR::IJob::IsComplete() const
+{
+    return GetCompletable()->GetIsComplete();
+}
+
+
+VKR::Job::Job(const std::function<void(uint32_t threadIndex)>& func)
+{
+    m_Task.m_SetSize = 1;
+    m_Task.m_MinRange = 1;
+    m_Task.m_Function = [func](uint32_t start, uint32_t end, uint32_t threadIndex) { func(threadIndex); };
+}
+
+VKR::Job::Job(const uint32_t count, const Function& func, const uint32_t minRange)
+{
+    m_Task.m_SetSize = count;
+    m_Task.m_MinRange = minRange > 0 ? minRange : 1;
+    m_Task.m_Function = func;
+}
+
+void VKR::Job::SetPriority(const EJobPriority priority)
+{
+    m_Task.m_Priority = ToTaskPriority(priority);
+}
+
+void VKR::Job::Submit(enki::TaskScheduler& scheduler)
+{
+    scheduler.AddTaskSetToPipe(&m_Task);
+}
+
+enki::ICompletable* VKR::Job::GetCompletable()
+{
+    return &m_Task;
+}
+
+const enki::ICompletable* VKR::Job::GetCompletable() const
+{
+    return &m_Task;
+}
+
+void VKR::Job::Task::ExecuteRange(enki::TaskSetPartition range, uint32_t threadnum)
+{
+    m_Function(range.start, range.end, threadnum);
+}
+
+
+VKR::PinnedJob::PinnedJob(const uint32_t threadIndex, const std::function<void()>& func) : m_Task(threadIndex)
+{
+    m_Task.m_Function = func;
+}
+
+void VKR::PinnedJob::Submit(enki::TaskScheduler& scheduler)
+{
+    scheduler.AddPinnedTask(&m_Task);
+}
+
+enki::ICompletable* VKR::PinnedJob::GetCompletable()
+{
+    return &m_Task;
+}
+
+const enki::ICompletable* VKR::PinnedJob::GetCompletable() const
+{
+    return &m_Task;
+}
+
+VKR::PinnedJob::Task::Task(const uint32_t threadIndex) : enki::IPinnedTask(threadIndex)
+{
+}
+
+void VKR::PinnedJob::Task::Execute()
+{
+    m_Function();
+}
+
+
+VKR::Status VKR::Jobs::Init(const uint32_t numThreads)
+{
+    EASY_FUNCTION(profiler::colors::Grey600);
+
+    if (s_bIsInitialized) {
+        Log::Warning("[Jobs]\tJob System is already Initialized!\n");
+        return Status::SUCCESS;
+    }
+
+    enki::TaskSchedulerConfig config = {};
+    if (numThreads > 0) {
+        config.numTaskThreadsToCreate = numThreads - 1; //The calling thread also executes Jobs.
+    }
+    config.profilerCallbacks.threadStart = &Jobs::OnThreadStart;
+
+    s_Scheduler.Initialize(config);
+    s_bIsInitialized = true;
+
+    Log::Debug("[Jobs]\tInitialized Job System with %d Threads.\n", s_Scheduler.GetNumTaskThreads());
+
+    return Status::SUCCESS;
+}
+
+void VKR::Jobs::Shutdown()
+{
+    EASY_FUNCTION(profiler::colors::Grey600);
+
+    if (!s_bIsInitialized) {
+        return;
+    }
+
+    s_Scheduler.WaitforAllAndShutdown();
+    s_bIsInitialized = false;
+}
+
+uint32_t VKR::Jobs::NumThreads()
+{
+    return s_bIsInitialized ? s_Scheduler.GetNumTaskThreads() : 1;
+}
+
+uint32_t VKR::Jobs::ThreadIndex()
+{
+    return s_bIsInitialized ? s_Scheduler.GetThreadNum() : 0;
+}
+
+void VKR::Jobs::Run(IJob& job)
+{
+    if (!s_bIsInitialized) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Jobs]\tAttempted to Run a Job before the Job System was Initialized!\n");
+        return;
+    }
+
+    job.Submit(s_Scheduler);
+}
+
+void VKR::Jobs::Wait(const IJob& job, const EJobPriority lowestToRun)
+{
+    EASY_FUNCTION(profiler::colors::Grey600);
+
+    if (!s_bIsInitialized) {
+        return;
+    }
+
+    s_Scheduler.WaitforTask(job.GetCompletable(), ToTaskPriority(lowestToRun));
+}
+
+void VKR::Jobs::WaitAll()
+{
+    EASY_FUNCTION(profiler::colors::Grey600);
+
+    if (!s_bIsInitialized) {
+        return;
+    }
+
+    s_Scheduler.WaitforAll();
+}
+
+void VKR::Jobs::RunPinnedJobs()
+{
+    if (!s_bIsInitialized) {
+        return;
+    }
+
+    s_Scheduler.RunPinnedTasks();
+}
+
+void VKR::Jobs::ParallelFor(const uint32_t count, const Job::Function& func, const uint32_t minRange)
+{
+    EASY_FUNCTION(profiler::colors::Grey600);
+
+    if (count == 0) {
+        return;
+    }
+
+    //Without worker threads, or for a range which cannot be split, just execute inline.
+    if (!s_bIsInitialized || count <= minRange) {
+        func(0, count, ThreadIndex());
+        return;
+    }
+
+    Job job(count, func, minRange);
+    job.Submit(s_Scheduler);
+    Wait(job, EJobPriority::Medium);
+}
+
+void VKR::Jobs::OnThreadStart(uint32_t threadIndex)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "VKR Worker %d", threadIndex);
+    EASY_THREAD(name);
+}
@@ -1,19 +1,30 @@
 #include "../include/VKR/VKR.h"
 #include "../include/VKR/Logger.h"
+#include "../include/VKR/Jobs.h"
 #include <easy/profiler.h>
 #include <GLFW/glfw3.h>
 
-VKR::Status VKR::Init()
+VKR::Status VKR::Init(const bool headless)
 {
     EASY_FUNCTION(profiler::colors::Grey600);
 
     EASY_MAIN_THREAD;
     PROFILER_START_LISTENING;
 
+    if (headless) {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
+
     //If we fail to initialize GLFW, terminate. 
     if (glfwInit() != GLFW_TRUE) {
         return Status::FAILED; 
     }
+
+    //Start the Job System worker threads. 
+    if (Jobs::Init() != Status::SUCCESS) {
+        glfwTerminate();
+        return Status::FAILED;
+    }
     
     return Status::SUCCESS; 
 }
@@ -23,6 +34,7 @@ VKR::Status VKR::Shutdown()
 {
     EASY_FUNCTION(profiler::colors::Grey600);
     
+    Jobs::Shutdown();
     glfwTerminate();
     PROFILER_STOP_LISTENING;
 
@@ -0,0 +1,251 @@
+#include "../../include/VKR/Vulkan/VkAsyncCompute.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+
+VKR::VkAsyncCompute::VkAsyncCompute()
+{
+    m_QueueFamilyIndex = 0;
+    m_DstQueueFamilyIndex = 0;
+    m_Queue = VK_NULL_HANDLE;
+
+    m_FrameIndex = 0;
+
+    m_Semaphore = VK_NULL_HANDLE;
+    m_NextToken = 1;
+
+    m_PendingStageMask = 0;
+    m_SubmittedStageMask = 0;
+    m_SubmittedToken = 0;
+}
+
+VkResult VKR::VkAsyncCompute::Create(const VkContext& context, const uint32_t queueFamilyIndex, const VkQueue queue, const uint32_t dstQueueFamilyIndex, const uint32_t framesInFlight)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_QueueFamilyIndex = queueFamilyIndex;
+    m_DstQueueFamilyIndex = dstQueueFamilyIndex;
+    m_Queue = queue;
+
+    m_Frames.resize(framesInFlight);
+    for (auto& frame : m_Frames) {
+        frame = { VK_NULL_HANDLE, VK_NULL_HANDLE, 0 };
+
+        VkResult result = context.CreateCommandPool(m_QueueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, &frame.pool);
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Async Compute Command Pool!\n");
+            return result;
+        }
+
+        result = context.AllocateCommandBuffers(frame.pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1, &frame.cmd);
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Allocate Async Compute Command Buffer!\n");
+            return result;
+        }
+    }
+
+    VkResult result = context.CreateTimelineSemaphore(0, &m_Semaphore);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Async Compute Timeline Semaphore!\n");
+        return result;
+    }
+
+    m_FrameIndex = 0;
+    m_NextToken = 1;
+
+    Log::Debug("[Vulkan]\tCreated Async Compute on Queue Family %d%s.\n", m_QueueFamilyIndex, (m_QueueFamilyIndex != m_DstQueueFamilyIndex) ? " (Dedicated)" : " (Shared with Graphics)");
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkAsyncCompute::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (m_NextToken > 1) {
+        context.WaitSemaphore(m_Semaphore, m_NextToken - 1);
+    }
+
+    for (auto& frame : m_Frames) {
+        if (frame.pool != VK_NULL_HANDLE) {
+            context.DestroyCommandPool(frame.pool);    //Frees the frame's Command Buffer
+        }
+    }
+    m_Frames.clear();
+
+    if (m_Semaphore != VK_NULL_HANDLE) {
+        context.DestroySemaphore(m_Semaphore);
+    }
+
+    m_PendingBarriers.clear();
+    m_SubmittedBarriers.clear();
+}
+
+VkResult VKR::VkAsyncCompute::Begin(const VkContext& context, const uint32_t frameIndex, VkCommandBuffer* pCommandBuffer)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_FrameIndex = frameIndex;
+    Frame& frame = m_Frames[m_FrameIndex];
+
+    //The frame's previous submission must complete before its Command Buffer can be recycled. This is usually long since finished.
+    if (frame.token > 0) {
+        EASY_BLOCK("Wait for Async Compute", profiler::colors::Red500);
+        VkResult result = context.WaitSemaphore(m_Semaphore, frame.token);
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Wait for Async Compute Frame %d!\n", m_FrameIndex);
+            return result;
+        }
+    }
+
+    VkResult result = context.ResetCommandPool(frame.pool);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Reset Async Compute Command Pool!\n");
+        return result;
+    }
+
+    const VkCommandBufferBeginInfo beginInfo = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        nullptr,
+        VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        nullptr
+    };
+
+    result = vkBeginCommandBuffer(frame.cmd, &beginInfo);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    *pCommandBuffer = frame.cmd;
+    return VK_SUCCESS;
+}
+
+void VKR::VkAsyncCompute::ReleaseBuffer(const VkBuffer buffer, const VkDeviceSize offset, const VkDeviceSize size, const VkPipelineStageFlags dstStageMask, const VkAccessFlags dstAccessMask)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_PendingStageMask |= dstStageMask;
+
+    //Within a single family, the semaphore wait alone makes the writes visible.
+    if (m_QueueFamilyIndex == m_DstQueueFamilyIndex) {
+        return;
+    }
+
+    VkBufferMemoryBarrier barrier = {
+        VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        nullptr,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        0,
+        m_QueueFamilyIndex,
+        m_DstQueueFamilyIndex,
+        buffer,
+        offset,
+        size
+    };
+    vkCmdPipelineBarrier(m_Frames[m_FrameIndex].cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = dstAccessMask;
+    m_PendingBarriers.push_back(barrier);
+}
+
+VkResult VKR::VkAsyncCompute::Submit(const VkContext& context, uint64_t* pToken, const uint32_t numWaitSemaphores, const VkSemaphore* pWaitSemaphores, const uint64_t* pWaitValues, const VkPipelineStageFlags* pWaitStageMasks)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    Frame& frame = m_Frames[m_FrameIndex];
+
+    VkResult result = vkEndCommandBuffer(frame.cmd);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to End Async Compute Command Buffer!\n");
+        return result;
+    }
+
+    const uint64_t token = m_NextToken;
+
+    const VkTimelineSemaphoreSubmitInfo timelineInfo = {
+        VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        nullptr,
+        pWaitValues != nullptr ? numWaitSemaphores : 0,
+        pWaitValues,
+        1,
+        &token
+    };
+
+    const VkSubmitInfo submitInfo = {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        &timelineInfo,
+        numWaitSemaphores,
+        pWaitSemaphores,
+        pWaitStageMasks,
+        1,
+        &frame.cmd,
+        1,
+        &m_Semaphore
+    };
+
+    result = vkQueueSubmit(m_Queue, 1, &submitInfo, VK_NULL_HANDLE);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Submit Async Compute Work!\n");
+        return result;
+    }
+
+    m_NextToken++;
+    frame.token = token;
+
+    //Releases recorded into this submission may now be acquired by the consumer.
+    if (m_PendingStageMask != 0) {
+        m_SubmittedBarriers.insert(m_SubmittedBarriers.end(), m_PendingBarriers.begin(), m_PendingBarriers.end());
+        m_SubmittedStageMask |= m_PendingStageMask;
+        m_SubmittedToken = token;
+
+        m_PendingBarriers.clear();
+        m_PendingStageMask = 0;
+    }
+
+    if (pToken != nullptr) {
+        *pToken = token;
+    }
+
+    return VK_SUCCESS;
+}
+
+uint64_t VKR::VkAsyncCompute::AcquireResources(VkCommandBuffer cmd, VkPipelineStageFlags* pWaitStageMask)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (m_SubmittedToken == 0) {
+        *pWaitStageMask = 0;
+        return 0;
+    }
+
+    if (!m_SubmittedBarriers.empty()) {
+        vkCmdPipelineBarrier(cmd, m_SubmittedStageMask, m_SubmittedStageMask, 0, 0, nullptr, static_cast<uint32_t>(m_SubmittedBarriers.size()), m_SubmittedBarriers.data(), 0, nullptr);
+        m_SubmittedBarriers.clear();
+    }
+
+    const uint64_t token = m_SubmittedToken;
+    *pWaitStageMask = m_SubmittedStageMask;
+
+    m_SubmittedToken = 0;
+    m_SubmittedStageMask = 0;
+
+    return token;
+}
+
+VkResult VKR::VkAsyncCompute::Wait(const VkContext& context, const uint64_t token, const uint64_t timeout) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    return context.WaitSemaphore(m_Semaphore, token, timeout);
+}
+
+const VkSemaphore& VKR::VkAsyncCompute::GetSemaphore() const
+{
+    return m_Semaphore;
+}
+
+const uint32_t VKR::VkAsyncCompute::GetQueueFamilyIndex() const
+{
+    return m_QueueFamilyIndex;
+}
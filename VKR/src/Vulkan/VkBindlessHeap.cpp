@@ -0,0 +1,254 @@
+#include "../../include/VKR/Vulkan/VkBindlessHeap.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Vulkan/VkInit.h"
+#include "../../include/VKR/Vulkan/VkLayoutCache.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <algorithm>
+
+//Binding indices, shared with shaders.
+constexpr uint32_t BINDING_SAMPLED_IMAGES = 0;
+constexpr uint32_t BINDING_STORAGE_BUFFERS = 1;
+constexpr uint32_t BINDING_SAMPLERS = 2;
+
+VKR::VkBindlessHeap::VkBindlessHeap()
+{
+    m_Pool = VK_NULL_HANDLE;
+    m_Layout = VK_NULL_HANDLE;
+    m_Set = VK_NULL_HANDLE;
+    m_OwnsLayout = false;
+
+    for (auto& handles : m_Handles) {
+        handles.capacity = 0;
+        handles.next = 0;
+    }
+}
+
+VkPhysicalDeviceDescriptorIndexingFeatures VKR::VkBindlessHeap::MakeRequiredFeatures(void* pNext)
+{
+    VkPhysicalDeviceDescriptorIndexingFeatures features = {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+    features.pNext = pNext;
+
+    features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    features.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+    features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+    features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+    features.descriptorBindingPartiallyBound = VK_TRUE;
+    features.runtimeDescriptorArray = VK_TRUE;
+
+    return features;
+}
+
+VkResult VKR::VkBindlessHeap::Create(const VkContext& context, const uint32_t maxSampledImages, const uint32_t maxStorageBuffers, const uint32_t maxSamplers, VkLayoutCache* pLayoutCache)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //Clamp each array to what the device can bind with update-after-bind.
+    VkPhysicalDeviceDescriptorIndexingProperties indexingProperties = {};
+    indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+    VkPhysicalDeviceProperties2 properties = {};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &indexingProperties;
+    vkGetPhysicalDeviceProperties2(context.GetPhysicalDevice(), &properties);
+
+    m_Handles[static_cast<uint32_t>(EBindlessType::SampledImage)].capacity = std::min({ maxSampledImages, indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages, indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages });
+    m_Handles[static_cast<uint32_t>(EBindlessType::StorageBuffer)].capacity = std::min({ maxStorageBuffers, indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers, indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers });
+    m_Handles[static_cast<uint32_t>(EBindlessType::Sampler)].capacity = std::min({ maxSamplers, indexingProperties.maxDescriptorSetUpdateAfterBindSamplers, indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers });
+
+    for (auto& handles : m_Handles) {
+        handles.capacity = std::max(handles.capacity, 1u);
+        handles.next = 0;
+        handles.free.clear();
+        handles.retired.clear();
+    }
+
+    const uint32_t numSampledImages = m_Handles[static_cast<uint32_t>(EBindlessType::SampledImage)].capacity;
+    const uint32_t numStorageBuffers = m_Handles[static_cast<uint32_t>(EBindlessType::StorageBuffer)].capacity;
+    const uint32_t numSamplers = m_Handles[static_cast<uint32_t>(EBindlessType::Sampler)].capacity;
+
+    const VkDescriptorSetLayoutBinding bindings[] = {
+        { BINDING_SAMPLED_IMAGES, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numSampledImages, VK_SHADER_STAGE_ALL, nullptr },
+        { BINDING_STORAGE_BUFFERS, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, numStorageBuffers, VK_SHADER_STAGE_ALL, nullptr },
+        { BINDING_SAMPLERS, VK_DESCRIPTOR_TYPE_SAMPLER, numSamplers, VK_SHADER_STAGE_ALL, nullptr },
+    };
+
+    //Descriptors may be written while the set is bound, and unused entries needn't be valid.
+    const VkDescriptorBindingFlags bindingFlag = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+    const VkDescriptorBindingFlags bindingFlags[] = { bindingFlag, bindingFlag, bindingFlag };
+
+    VkResult result = VK_SUCCESS;
+    m_OwnsLayout = (pLayoutCache == nullptr);
+    if (pLayoutCache != nullptr) {
+        result = pLayoutCache->GetDescriptorSetLayout(context, 3, bindings, &m_Layout, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT, bindingFlags);
+    }
+    else {
+        const VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+            nullptr,
+            3,
+            bindingFlags
+        };
+
+        result = context.CreateDescriptorSetLayout(3, bindings, &m_Layout, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT, &bindingFlagsInfo);
+    }
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Bindless Descriptor Set Layout!\n");
+        return result;
+    }
+
+    const VkDescriptorPoolSize poolSizes[] = {
+        { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, numSampledImages },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, numStorageBuffers },
+        { VK_DESCRIPTOR_TYPE_SAMPLER, numSamplers },
+    };
+
+    result = context.CreateDescriptorPool(1, VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT, 3, poolSizes, &m_Pool);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Bindless Descriptor Pool!\n");
+        return result;
+    }
+
+    result = context.AllocateDescriptorSets(m_Pool, 1, &m_Layout, &m_Set);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Allocate Bindless Descriptor Set!\n");
+        return result;
+    }
+
+    Log::Debug("[Vulkan]\tCreated Bindless Heap with %d Sampled Images, %d Storage Buffers and %d Samplers.\n", numSampledImages, numStorageBuffers, numSamplers);
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkBindlessHeap::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (m_Pool != VK_NULL_HANDLE) {
+        context.DestroyDescriptorPool(m_Pool);     //Frees the global set
+    }
+    if (m_Layout != VK_NULL_HANDLE && m_OwnsLayout) {
+        context.DestroyDescriptorSetlayout(m_Layout);
+    }
+
+    m_Layout = VK_NULL_HANDLE;
+    m_Set = VK_NULL_HANDLE;
+}
+
+uint32_t VKR::VkBindlessHeap::RegisterSampledImage(const VkContext& context, const VkImageView view, const VkImageLayout layout)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    const uint32_t handle = AcquireHandle(EBindlessType::SampledImage);
+    if (handle == INVALID_HANDLE) {
+        return INVALID_HANDLE;
+    }
+
+    const VkDescriptorImageInfo imageInfo = { VK_NULL_HANDLE, view, layout };
+    const VkWriteDescriptorSet write = VkInit::MakeWriteDescriptorSet(m_Set, BINDING_SAMPLED_IMAGES, handle, 1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, &imageInfo, nullptr, nullptr);
+    vkUpdateDescriptorSets(context.GetDevice(), 1, &write, 0, nullptr);
+
+    return handle;
+}
+
+uint32_t VKR::VkBindlessHeap::RegisterStorageBuffer(const VkContext& context, const VkBuffer buffer, const VkDeviceSize offset, const VkDeviceSize range)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    const uint32_t handle = AcquireHandle(EBindlessType::StorageBuffer);
+    if (handle == INVALID_HANDLE) {
+        return INVALID_HANDLE;
+    }
+
+    const VkDescriptorBufferInfo bufferInfo = { buffer, offset, range };
+    const VkWriteDescriptorSet write = VkInit::MakeWriteDescriptorSet(m_Set, BINDING_STORAGE_BUFFERS, handle, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &bufferInfo, nullptr);
+    vkUpdateDescriptorSets(context.GetDevice(), 1, &write, 0, nullptr);
+
+    return handle;
+}
+
+uint32_t VKR::VkBindlessHeap::RegisterSampler(const VkContext& context, const VkSampler sampler)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    const uint32_t handle = AcquireHandle(EBindlessType::Sampler);
+    if (handle == INVALID_HANDLE) {
+        return INVALID_HANDLE;
+    }
+
+    const VkDescriptorImageInfo imageInfo = { sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED };
+    const VkWriteDescriptorSet write = VkInit::MakeWriteDescriptorSet(m_Set, BINDING_SAMPLERS, handle, 1, VK_DESCRIPTOR_TYPE_SAMPLER, &imageInfo, nullptr, nullptr);
+    vkUpdateDescriptorSets(context.GetDevice(), 1, &write, 0, nullptr);
+
+    return handle;
+}
+
+void VKR::VkBindlessHeap::Release(const EBindlessType type, const uint32_t handle, const uint64_t retireValue)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (handle == INVALID_HANDLE) {
+        return;
+    }
+
+    //In-flight frames may still index the descriptor, so it can't be overwritten until they complete.
+    m_Handles[static_cast<uint32_t>(type)].retired.emplace_back(retireValue, handle);
+}
+
+void VKR::VkBindlessHeap::Collect(const uint64_t completedValue)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    for (auto& handles : m_Handles) {
+        auto it = std::partition(handles.retired.begin(), handles.retired.end(), [completedValue](const std::pair<uint64_t, uint32_t>& retired) { return retired.first > completedValue; });
+        for (auto recycled = it; recycled != handles.retired.end(); recycled++) {
+            handles.free.push_back(recycled->second);
+        }
+        handles.retired.erase(it, handles.retired.end());
+    }
+}
+
+void VKR::VkBindlessHeap::Bind(VkCommandBuffer cmd, const VkPipelineBindPoint bindPoint, const VkPipelineLayout pipelineLayout, const uint32_t set) const
+{
+    vkCmdBindDescriptorSets(cmd, bindPoint, pipelineLayout, set, 1, &m_Set, 0, nullptr);
+}
+
+const VkDescriptorSetLayout& VKR::VkBindlessHeap::GetLayout() const
+{
+    return m_Layout;
+}
+
+const VkDescriptorSet& VKR::VkBindlessHeap::GetSet() const
+{
+    return m_Set;
+}
+
+const uint32_t VKR::VkBindlessHeap::GetCapacity(const EBindlessType type) const
+{
+    return m_Handles[static_cast<uint32_t>(type)].capacity;
+}
+
+uint32_t VKR::VkBindlessHeap::AcquireHandle(const EBindlessType type)
+{
+    HandleList& handles = m_Handles[static_cast<uint32_t>(type)];
+
+    if (!handles.free.empty()) {
+        const uint32_t handle = handles.free.back();
+        handles.free.pop_back();
+        return handle;
+    }
+
+    if (handles.next < handles.capacity) {
+        return handles.next++;
+    }
+
+    Log::Warning("[Vulkan]\tBindless Heap is full! (%d descriptors of type %d)\n", handles.capacity, static_cast<uint32_t>(type));
+    return INVALID_HANDLE;
+}
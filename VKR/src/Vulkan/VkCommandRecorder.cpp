@@ -0,0 +1,167 @@
+#include "../../include/VKR/Vulkan/VkCommandRecorder.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Jobs.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <algorithm>
+#include <utility>
+
+VKR::VkCommandRecorder::VkCommandRecorder()
+{
+    m_NumThreads = 0;
+    m_FrameIndex = 0;
+}
+
+VkResult VKR::VkCommandRecorder::Create(const VkContext& context, const uint32_t queueFamilyIndex, const uint32_t framesInFlight)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_NumThreads = Jobs::NumThreads();
+    m_FrameIndex = 0;
+    m_ThreadPools.resize(m_NumThreads * framesInFlight);
+
+    for (auto& threadPool : m_ThreadPools) {
+        threadPool.pool = VK_NULL_HANDLE;
+        threadPool.numUsed = 0;
+
+        //Pools are reset as a whole each frame, so individual buffers never need resetting.
+        VkResult result = context.CreateCommandPool(queueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, &threadPool.pool);
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Command Pool for Command Recorder!\n");
+            return result;
+        }
+    }
+
+    Log::Debug("[Vulkan]\tCreated Command Recorder with %d Command Pools (%d Threads x %d Frames).\n", static_cast<uint32_t>(m_ThreadPools.size()), m_NumThreads, framesInFlight);
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkCommandRecorder::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    for (auto& threadPool : m_ThreadPools) {
+        if (threadPool.pool != VK_NULL_HANDLE) {
+            context.DestroyCommandPool(threadPool.pool);    //Frees all of the pool's Command Buffers
+        }
+    }
+
+    m_ThreadPools.clear();
+    m_Recorded.clear();
+}
+
+VkResult VKR::VkCommandRecorder::Reset(const VkContext& context, const uint32_t frameIndex)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_FrameIndex = frameIndex;
+    m_Recorded.clear();
+
+    for (uint32_t i = 0; i < m_NumThreads; i++) {
+        ThreadPool& threadPool = m_ThreadPools[(m_FrameIndex * m_NumThreads) + i];
+        if (threadPool.numUsed == 0) {
+            continue;
+        }
+
+        VkResult result = context.ResetCommandPool(threadPool.pool);
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Reset Command Pool!\n");
+            return result;
+        }
+
+        threadPool.numUsed = 0;
+    }
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkCommandRecorder::Record(const VkContext& context, const VkCommandBufferInheritanceInfo& inheritanceInfo, const uint32_t count, const RecordFunction& func, const uint32_t minRange)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //Partitions may complete in any order, so tag each Command Buffer with its first element and sort afterwards.
+    std::vector<std::pair<uint32_t, VkCommandBuffer>> partitions;
+    VkResult status = VK_SUCCESS;
+    std::mutex partitionMutex;
+
+    Jobs::ParallelFor(count, [&](uint32_t start, uint32_t end, uint32_t threadIndex) {
+        EASY_BLOCK("Record Secondary Command Buffer", profiler::colors::Red500);
+        ThreadPool& threadPool = m_ThreadPools[(m_FrameIndex * m_NumThreads) + threadIndex];
+
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        VkResult result = AcquireCommandBuffer(context, threadPool, &cmd);
+
+        if (result == VK_SUCCESS) {
+            const VkCommandBufferBeginInfo beginInfo = {
+                VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                nullptr,
+                VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+                &inheritanceInfo
+            };
+
+            result = vkBeginCommandBuffer(cmd, &beginInfo);
+        }
+
+        if (result == VK_SUCCESS) {
+            func(cmd, start, end);
+            result = vkEndCommandBuffer(cmd);
+        }
+
+        std::lock_guard<std::mutex> lock(partitionMutex);
+        if (result == VK_SUCCESS) {
+            partitions.emplace_back(start, cmd);
+        }
+        else {
+            status = result;
+        }
+    }, minRange);
+
+    if (status != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Record Secondary Command Buffers!\n");
+        return status;
+    }
+
+    std::sort(partitions.begin(), partitions.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::lock_guard<std::mutex> lock(m_RecordedMutex);
+    for (const auto& partition : partitions) {
+        m_Recorded.push_back(partition.second);
+    }
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkCommandRecorder::Execute(VkCommandBuffer cmd)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    std::lock_guard<std::mutex> lock(m_RecordedMutex);
+    if (!m_Recorded.empty()) {
+        vkCmdExecuteCommands(cmd, static_cast<uint32_t>(m_Recorded.size()), m_Recorded.data());
+    }
+
+    m_Recorded.clear();
+}
+
+VkResult VKR::VkCommandRecorder::AcquireCommandBuffer(const VkContext& context, ThreadPool& threadPool, VkCommandBuffer* pCommandBuffer)
+{
+    //Reuse a Command Buffer recycled by the last pool reset, if there is one.
+    if (threadPool.numUsed < threadPool.buffers.size()) {
+        *pCommandBuffer = threadPool.buffers[threadPool.numUsed++];
+        return VK_SUCCESS;
+    }
+
+    VkCommandBuffer cmd = VK_NULL_HANDLE;
+    VkResult result = context.AllocateCommandBuffers(threadPool.pool, VK_COMMAND_BUFFER_LEVEL_SECONDARY, 1, &cmd);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    threadPool.buffers.push_back(cmd);
+    threadPool.numUsed++;
+    *pCommandBuffer = cmd;
+
+    return VK_SUCCESS;
+}
@@ -4,8 +4,42 @@
 #include "../../include/VKR/Vulkan/VkHelpers.h"
 #include "../include/VKR/Logger.h"
 #include <assert.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 #include <easy/profiler.h>
 
+static std::string ToLower(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return str;
+}
+
+static bool ContainsExtension(const uint32_t numExtensions, const char* const* ppExtensions, const char* extension) {
+    for (uint32_t i = 0; i < numExtensions; i++) {
+        if (strcmp(ppExtensions[i], extension) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static const char* PhysicalDeviceTypeString(const VkPhysicalDeviceType type) {
+    switch (type) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+        return "Discrete";
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+        return "Integrated";
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+        return "Virtual";
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:
+        return "CPU";
+    default:
+        return "Other";
+    }
+}
+
 VKR::VkContext::VkContext()
 {
 #ifdef VKR_DEBUG
@@ -13,6 +47,18 @@ VKR::VkContext::VkContext()
     m_DebugReporter = VK_NULL_HANDLE;
 #endif
     m_Instance = VK_NULL_HANDLE;
+    m_APIVersion = VK_API_VERSION_1_0;
+    m_PhysicalDevice = VK_NULL_HANDLE;
+    m_Device = VK_NULL_HANDLE;
+    m_QueueFamilies = { 0, 0, 0 };
+    for (auto& queue : m_Queues) {
+        queue = VK_NULL_HANDLE;
+    }
+    m_pfnCmdBeginRendering = nullptr;
+    m_pfnCmdEndRendering = nullptr;
+    m_pfnCmdPipelineBarrier2 = nullptr;
+    m_DynamicRendering = false;
+    m_Synchronization2 = false;
 }
 
 
@@ -169,6 +215,22 @@ VkResult VKR::VkContext::CreateInstance(const uint32_t numLayers, const char* co
         return VK_ERROR_EXTENSION_NOT_PRESENT;
     }
 
+    //Default to Vulkan 1.2, for Timeline Semaphores
+    const VkApplicationInfo defaultApplicationInfo = {
+        VK_STRUCTURE_TYPE_APPLICATION_INFO,
+        nullptr,
+        "VKR",
+        VK_MAKE_VERSION(0, 0, 0),
+        "VKR",
+        VK_MAKE_VERSION(0, 0, 0),
+        VK_API_VERSION_1_2
+    };
+
+    if (pApplicationInfo == nullptr) {
+        pApplicationInfo = &defaultApplicationInfo;
+    }
+    m_APIVersion = pApplicationInfo->apiVersion != 0 ? pApplicationInfo->apiVersion : VK_API_VERSION_1_0;
+
     //Link a Debug Messenger in Debug builds
 #ifdef DEBUG
     VkDebugUtilsMessengerCreateInfoEXT messengerInfo = VkInit::MakeDebugUtilsMessengerCreateInfoEXT();
@@ -195,6 +257,11 @@ VkResult VKR::VkContext::CreateInstance(const uint32_t numLayers, const char* co
     return vkCreateInstance(&createInfo, nullptr, &m_Instance);
 }
 
+const uint32_t VKR::VkContext::GetAPIVersion() const
+{
+    return m_APIVersion;
+}
+
 void VKR::VkContext::DestroyInstance()
 {
     EASY_FUNCTION(profiler::colors::Red500);
@@ -209,21 +276,112 @@ const VkPhysicalDevice& VKR::VkContext::GetPhysicalDevice() const
     return m_PhysicalDevice;
 }
 
-VkResult VKR::VkContext::SelectPhysicalDevice()
+VkResult VKR::VkContext::EnumeratePhysicalDevices(const VkPhysicalDeviceRequirements* pRequirements, std::vector<VkPhysicalDeviceCandidate>& candidates) const
 {
     EASY_FUNCTION(profiler::colors::Red500);
+
+    const VkPhysicalDeviceRequirements defaultRequirements = {
+        0,
+        nullptr,
+        nullptr,
+        VK_QUEUE_GRAPHICS_BIT,
+        0
+    };
+    const VkPhysicalDeviceRequirements& requirements = pRequirements != nullptr ? *pRequirements : defaultRequirements;
+
     uint32_t count = 0;
-    vkEnumeratePhysicalDevices(m_Instance, &count, nullptr);
-    VkPhysicalDevice* pDevices = new VkPhysicalDevice[count];
-    vkEnumeratePhysicalDevices(m_Instance, &count, pDevices);
+    VkResult result = vkEnumeratePhysicalDevices(m_Instance, &count, nullptr);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    std::vector<VkPhysicalDevice> devices(count);
+    result = vkEnumeratePhysicalDevices(m_Instance, &count, devices.data());
+    if (result != VK_SUCCESS) {
+        return result;
+    }
 
-    if (count == 0) {
-        delete[] pDevices;
-        return VK_ERROR_DEVICE_LOST;
+    candidates.clear();
+    for (uint32_t i = 0; i < count; i++) {
+        VkPhysicalDeviceCandidate candidate = {};
+        candidate.device = devices[i];
+        candidate.index = i;
+        vkGetPhysicalDeviceProperties(devices[i], &candidate.properties);
+
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(devices[i], &memProperties);
+        for (uint32_t h = 0; h < memProperties.memoryHeapCount; h++) {
+            if (memProperties.memoryHeaps[h].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+                candidate.deviceLocalMemory += memProperties.memoryHeaps[h].size;
+            }
+        }
+
+        candidate.score = VkHelpers::ScorePhysicalDevice(devices[i], requirements);
+        candidates.push_back(candidate);
     }
 
-    m_PhysicalDevice = pDevices[0]; //TODO: Better Physical Device Selection
-    delete[] pDevices;
+    //Stable, so equally scored devices keep the driver's ordering.
+    std::stable_sort(candidates.begin(), candidates.end(), [](const VkPhysicalDeviceCandidate& a, const VkPhysicalDeviceCandidate& b) { return a.score > b.score; });
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkContext::SelectPhysicalDevice(const VkPhysicalDeviceRequirements* pRequirements)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    std::vector<VkPhysicalDeviceCandidate> candidates;
+    VkResult result = EnumeratePhysicalDevices(pRequirements, candidates);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Enumerate Physical Devices!\n");
+        return result;
+    }
+
+    if (candidates.empty() || candidates[0].score == 0) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tNo Physical Device meets the requirements!\n");
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    const VkPhysicalDeviceCandidate* pSelected = &candidates[0];
+
+    //Allow the selection to be overridden, e.g. to force the integrated GPU on a hybrid laptop.
+    const char* pOverride = std::getenv("VKR_PHYSICAL_DEVICE");
+    if (pOverride != nullptr && pOverride[0] != '\0') {
+        const std::string overrideName = ToLower(pOverride);
+        const bool isIndex = std::all_of(overrideName.begin(), overrideName.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); });
+        const unsigned long overrideIndex = isIndex ? std::strtoul(pOverride, nullptr, 10) : 0;
+
+        const VkPhysicalDeviceCandidate* pMatch = nullptr;
+        for (const auto& candidate : candidates) {
+            const bool matches = isIndex ? (candidate.index == overrideIndex) : (ToLower(candidate.properties.deviceName).find(overrideName) != std::string::npos);
+            if (matches) {
+                pMatch = &candidate;
+                break;
+            }
+        }
+
+        if (pMatch == nullptr) {
+            Log::Warning("[Vulkan]\tVKR_PHYSICAL_DEVICE=\"%s\" did not match any Physical Device. Ignoring.\n", pOverride);
+        }
+        else if (pMatch->score == 0) {
+            Log::Warning("[Vulkan]\tVKR_PHYSICAL_DEVICE=\"%s\" selects %s, which does not meet the requirements. Ignoring.\n", pOverride, pMatch->properties.deviceName);
+        }
+        else {
+            pSelected = pMatch;
+        }
+    }
+
+    Log::Message("[Vulkan]\tPhysical Devices:\n");
+    for (const auto& candidate : candidates) {
+        Log::Message("\t%s [%d] %s (%s, %llu MiB) - %s\n",
+            (&candidate == pSelected) ? "*" : " ",
+            candidate.index,
+            candidate.properties.deviceName,
+            PhysicalDeviceTypeString(candidate.properties.deviceType),
+            static_cast<unsigned long long>(candidate.deviceLocalMemory >> 20),
+            candidate.score > 0 ? std::to_string(candidate.score).c_str() : "Unsuitable");
+    }
+
+    m_PhysicalDevice = pSelected->device;
 
     return VK_SUCCESS;
 }
@@ -236,7 +394,7 @@ const VkDevice& VKR::VkContext::GetDevice() const
     return m_Device;
 }
 
-VkResult VKR::VkContext::CreateDevice(const uint32_t numExtensions, const char* const* ppExtensions, const uint32_t numQueues, const VkDeviceQueueCreateInfo* pQueueCreateInfos, const VkPhysicalDeviceFeatures* pFeatures)
+VkResult VKR::VkContext::CreateDevice(const uint32_t numExtensions, const char* const* ppExtensions, const uint32_t numQueues, const VkDeviceQueueCreateInfo* pQueueCreateInfos, const VkPhysicalDeviceFeatures* pFeatures, const void* pNext)
 {
     EASY_FUNCTION(profiler::colors::Red500);
     if (m_PhysicalDevice == VK_NULL_HANDLE) {
@@ -252,7 +410,7 @@ VkResult VKR::VkContext::CreateDevice(const uint32_t numExtensions, const char*
 
     const VkDeviceCreateInfo createInfo = {
         VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        nullptr,
+        pNext,
         0,
         numQueues,
         pQueueCreateInfos,
@@ -263,13 +421,161 @@ VkResult VKR::VkContext::CreateDevice(const uint32_t numExtensions, const char*
         pFeatures
     };
 
-    return vkCreateDevice(m_PhysicalDevice, &createInfo, nullptr, &m_Device);
+    VkResult result = vkCreateDevice(m_PhysicalDevice, &createInfo, nullptr, &m_Device);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    //Dynamic Rendering and Synchronization2 are core in 1.3, but core commands may only be used if both the instance and device are at least 1.3.
+    //Otherwise, they're provided by their KHR extensions.
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(m_PhysicalDevice, &properties);
+    const bool isCore = std::min(m_APIVersion, properties.apiVersion) >= VK_API_VERSION_1_3;
+
+    //Either way, they're only usable if their features were enabled.
+    bool dynamicRenderingFeature = false;
+    bool synchronization2Feature = false;
+    for (const VkBaseInStructure* pStruct = static_cast<const VkBaseInStructure*>(pNext); pStruct != nullptr; pStruct = pStruct->pNext) {
+        switch (pStruct->sType) {
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES:
+            dynamicRenderingFeature |= reinterpret_cast<const VkPhysicalDeviceDynamicRenderingFeatures*>(pStruct)->dynamicRendering == VK_TRUE;
+            break;
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES:
+            synchronization2Feature |= reinterpret_cast<const VkPhysicalDeviceSynchronization2Features*>(pStruct)->synchronization2 == VK_TRUE;
+            break;
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES:
+            dynamicRenderingFeature |= reinterpret_cast<const VkPhysicalDeviceVulkan13Features*>(pStruct)->dynamicRendering == VK_TRUE;
+            synchronization2Feature |= reinterpret_cast<const VkPhysicalDeviceVulkan13Features*>(pStruct)->synchronization2 == VK_TRUE;
+            break;
+        default:
+            break;
+        }
+    }
+
+    m_pfnCmdBeginRendering = nullptr;
+    m_pfnCmdEndRendering = nullptr;
+    m_pfnCmdPipelineBarrier2 = nullptr;
+
+    if (dynamicRenderingFeature && isCore) {
+        m_pfnCmdBeginRendering = reinterpret_cast<PFN_vkCmdBeginRendering>(vkGetDeviceProcAddr(m_Device, "vkCmdBeginRendering"));
+        m_pfnCmdEndRendering = reinterpret_cast<PFN_vkCmdEndRendering>(vkGetDeviceProcAddr(m_Device, "vkCmdEndRendering"));
+    }
+    else if (dynamicRenderingFeature && ContainsExtension(numExtensions, ppExtensions, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME)) {
+        m_pfnCmdBeginRendering = reinterpret_cast<PFN_vkCmdBeginRendering>(vkGetDeviceProcAddr(m_Device, "vkCmdBeginRenderingKHR"));
+        m_pfnCmdEndRendering = reinterpret_cast<PFN_vkCmdEndRendering>(vkGetDeviceProcAddr(m_Device, "vkCmdEndRenderingKHR"));
+    }
+    m_DynamicRendering = m_pfnCmdBeginRendering != nullptr && m_pfnCmdEndRendering != nullptr;
+
+    if (synchronization2Feature && isCore) {
+        m_pfnCmdPipelineBarrier2 = reinterpret_cast<PFN_vkCmdPipelineBarrier2>(vkGetDeviceProcAddr(m_Device, "vkCmdPipelineBarrier2"));
+    }
+    else if (synchronization2Feature && ContainsExtension(numExtensions, ppExtensions, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME)) {
+        m_pfnCmdPipelineBarrier2 = reinterpret_cast<PFN_vkCmdPipelineBarrier2>(vkGetDeviceProcAddr(m_Device, "vkCmdPipelineBarrier2KHR"));
+    }
+    m_Synchronization2 = m_pfnCmdPipelineBarrier2 != nullptr;
+
+    m_DeviceExtensions.assign(ppExtensions, ppExtensions + numExtensions);
+
+    Log::Debug("[Vulkan]\tDynamic Rendering: %s. Synchronization2: %s.\n",
+        m_DynamicRendering ? (isCore ? "Core" : "KHR") : "Unsupported",
+        m_Synchronization2 ? (isCore ? "Core" : "KHR") : "Unsupported");
+
+    return VK_SUCCESS;
+}
+
+VKR::VkQueueFamilies VKR::VkContext::FindQueueFamilies() const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    VkQueueFamilies families = {};
+    families.graphics = VkHelpers::FindDedicatedQueueFamilyIndex(m_PhysicalDevice, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT, 0);
+    if (families.graphics == UINT32_MAX) {
+        families.graphics = VkHelpers::FindQueueFamilyIndex(m_PhysicalDevice, VK_QUEUE_GRAPHICS_BIT);
+    }
+
+    //Prefer families without Graphics support, as these are typically backed by separate hardware queues.
+    families.compute = VkHelpers::FindDedicatedQueueFamilyIndex(m_PhysicalDevice, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+    if (families.compute == UINT32_MAX) {
+        families.compute = families.graphics;
+    }
+
+    families.transfer = VkHelpers::FindDedicatedQueueFamilyIndex(m_PhysicalDevice, VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+    if (families.transfer == UINT32_MAX) {
+        families.transfer = families.graphics;
+    }
+
+    Log::Debug("[Vulkan]\tQueue Families: Graphics %d, Compute %d%s, Transfer %d%s.\n",
+        families.graphics,
+        families.compute, families.compute != families.graphics ? " (Async)" : "",
+        families.transfer, families.transfer != families.graphics ? " (Dedicated)" : "");
+
+    return families;
+}
+
+VkResult VKR::VkContext::CreateDevice(const uint32_t numExtensions, const char* const* ppExtensions, const VkQueueFamilies& queueFamilies, const VkPhysicalDeviceFeatures* pFeatures, const void* pNext)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    const uint32_t families[] = { queueFamilies.graphics, queueFamilies.compute, queueFamilies.transfer };
+    static const float queuePriorities[] = { 1.0f };
+
+    //Families may be shared between queue types, but each may only be specified once.
+    std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
+    for (const uint32_t family : families) {
+        if (std::none_of(queueCreateInfos.begin(), queueCreateInfos.end(), [family](const VkDeviceQueueCreateInfo& qci) { return qci.queueFamilyIndex == family; })) {
+            queueCreateInfos.push_back(VkInit::MakeDeviceQueueCreateInfo(family, 1, queuePriorities));
+        }
+    }
+
+    VkResult result = CreateDevice(numExtensions, ppExtensions, static_cast<uint32_t>(queueCreateInfos.size()), queueCreateInfos.data(), pFeatures, pNext);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    m_QueueFamilies = queueFamilies;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(EQueueType::COUNT); i++) {
+        m_Queues[i] = GetDeviceQueue(families[i], 0);
+    }
+
+    return VK_SUCCESS;
+}
+
+VkQueue VKR::VkContext::GetQueue(const EQueueType type) const
+{
+    const VkQueue queue = m_Queues[static_cast<uint32_t>(type)];
+    if (queue == VK_NULL_HANDLE) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tRequested VkQueue was VK_NULL_HANDLE! Was CreateDevice() called with VkQueueFamilies?\n");
+    }
+    return queue;
+}
+
+const uint32_t VKR::VkContext::GetQueueFamilyIndex(const EQueueType type) const
+{
+    switch (type) {
+    case EQueueType::Compute:
+        return m_QueueFamilies.compute;
+    case EQueueType::Transfer:
+        return m_QueueFamilies.transfer;
+    default:
+        return m_QueueFamilies.graphics;
+    }
 }
 
 void VKR::VkContext::DestroyDevice()
 {
     EASY_FUNCTION(profiler::colors::Red500);
     vkDestroyDevice(m_Device, nullptr);
+    m_pfnCmdBeginRendering = nullptr;
+    m_pfnCmdEndRendering = nullptr;
+    m_pfnCmdPipelineBarrier2 = nullptr;
+    m_DynamicRendering = false;
+    m_Synchronization2 = false;
+    m_DeviceExtensions.clear();
+}
+
+const bool VKR::VkContext::IsDeviceExtensionEnabled(const char* extension) const
+{
+    return std::find(m_DeviceExtensions.begin(), m_DeviceExtensions.end(), extension) != m_DeviceExtensions.end();
 }
 
 VkResult VKR::VkContext::CreateAllocator()
@@ -285,7 +591,7 @@ VkResult VKR::VkContext::CreateAllocator()
         nullptr,
         nullptr,
         m_Instance,
-        VK_API_VERSION_1_0,     //NOTE: Update to current API Version!
+        m_APIVersion,
         nullptr
     };
 
@@ -309,6 +615,28 @@ void VKR::VkContext::Unmap(const VmaAllocation& allocation) const
     vmaUnmapMemory(m_Allocator, allocation);
 }
 
+VkResult VKR::VkContext::Flush(const VmaAllocation& allocation, const VkDeviceSize offset, const VkDeviceSize size) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    return vmaFlushAllocation(m_Allocator, allocation, offset, size);
+}
+
+VkResult VKR::VkContext::Flush(const VkBufferResource& buffer, const VkDeviceSize offset, const VkDeviceSize size) const
+{
+    return Flush(buffer.allocation, offset, size);
+}
+
+VkResult VKR::VkContext::Invalidate(const VmaAllocation& allocation, const VkDeviceSize offset, const VkDeviceSize size) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    return vmaInvalidateAllocation(m_Allocator, allocation, offset, size);
+}
+
+VkResult VKR::VkContext::Invalidate(const VkBufferResource& buffer, const VkDeviceSize offset, const VkDeviceSize size) const
+{
+    return Invalidate(buffer.allocation, offset, size);
+}
+
 VkQueue VKR::VkContext::GetDeviceQueue(const uint32_t queueFamilyIndex, const uint32_t queueIndex) const
 {
     VkQueue queue = VK_NULL_HANDLE;
@@ -352,6 +680,45 @@ void VKR::VkContext::DestroyFence(VkFence& fence) const
     vkDestroyFence(m_Device, fence, nullptr);
 }
 
+VkResult VKR::VkContext::CreateTimelineSemaphore(const uint64_t initialValue, VkSemaphore* pSemaphore) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    const VkSemaphoreTypeCreateInfo typeInfo = {
+        VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        nullptr,
+        VK_SEMAPHORE_TYPE_TIMELINE,
+        initialValue
+    };
+
+    const VkSemaphoreCreateInfo createInfo = {
+       VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+       &typeInfo,
+       0
+    };
+
+    return vkCreateSemaphore(m_Device, &createInfo, nullptr, pSemaphore);
+}
+
+VkResult VKR::VkContext::WaitSemaphore(const VkSemaphore semaphore, const uint64_t value, const uint64_t timeout) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    const VkSemaphoreWaitInfo waitInfo = {
+        VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+        nullptr,
+        0,
+        1,
+        &semaphore,
+        &value
+    };
+
+    return vkWaitSemaphores(m_Device, &waitInfo, timeout);
+}
+
+VkResult VKR::VkContext::GetSemaphoreCounterValue(const VkSemaphore semaphore, uint64_t* pValue) const
+{
+    return vkGetSemaphoreCounterValue(m_Device, semaphore, pValue);
+}
+
 VkResult VKR::VkContext::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, const VmaMemoryUsage memoryUsage, const uint32_t memoryFlags, VmaAllocation* pAllocation, VkBuffer* pBuffer) const
 {
     EASY_FUNCTION(profiler::colors::Red500);
@@ -370,6 +737,34 @@ void VKR::VkContext::DestroyBuffer(VkBuffer& buffer, VmaAllocation& allocation)
     vmaDestroyBuffer(m_Allocator, buffer, allocation);
 }
 
+VkResult VKR::VkContext::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, const VmaMemoryUsage memoryUsage, const uint32_t memoryFlags, VkBufferResource* pBuffer) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    const VkBufferCreateInfo createInfo = VkInit::MakeBufferCreateInfo(size, usage);
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.flags = memoryFlags;
+    allocInfo.usage = memoryUsage;
+
+    VmaAllocationInfo allocationInfo = {};
+    VkResult result = vmaCreateBuffer(m_Allocator, &createInfo, &allocInfo, &pBuffer->buffer, &pBuffer->allocation, &allocationInfo);
+
+    pBuffer->size = size;
+    pBuffer->pMappedData = (result == VK_SUCCESS) ? allocationInfo.pMappedData : nullptr;    //Null unless VMA_ALLOCATION_CREATE_MAPPED_BIT was requested
+
+    return result;
+}
+
+void VKR::VkContext::DestroyBuffer(VkBufferResource& buffer) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    vmaDestroyBuffer(m_Allocator, buffer.buffer, buffer.allocation);
+
+    buffer.buffer = VK_NULL_HANDLE;
+    buffer.allocation = VK_NULL_HANDLE;
+    buffer.pMappedData = nullptr;
+}
+
 VkResult VKR::VkContext::CreateImage(const VkImageType type, const VkExtent3D extents, const VkSampleCountFlagBits sampleCount, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, const VmaMemoryUsage memoryUsage, const uint32_t memoryFlags, VmaAllocation* pAllocation, VkImage* pImage) const
 {
     EASY_FUNCTION(profiler::colors::Red500);
@@ -379,7 +774,15 @@ VkResult VKR::VkContext::CreateImage(const VkImageType type, const VkExtent3D ex
     allocInfo.flags = memoryFlags;
     allocInfo.usage = memoryUsage;
 
-    return vmaCreateImage(m_Allocator, &createInfo, &allocInfo, pImage, pAllocation, nullptr);
+    VkResult result = vmaCreateImage(m_Allocator, &createInfo, &allocInfo, pImage, pAllocation, nullptr);
+
+    //Most desktop GPUs expose no lazily allocated memory type.
+    if (result == VK_ERROR_FEATURE_NOT_PRESENT && memoryUsage == VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED) {
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+        result = vmaCreateImage(m_Allocator, &createInfo, &allocInfo, pImage, pAllocation, nullptr);
+    }
+
+    return result;
 }
 
 void VKR::VkContext::DestroyImage(VkImage& image, VmaAllocation& allocation) const
@@ -388,6 +791,43 @@ void VKR::VkContext::DestroyImage(VkImage& image, VmaAllocation& allocation) con
     vmaDestroyImage(m_Allocator, image, allocation);
 }
 
+VkResult VKR::VkContext::CreateImage(const VkImageType type, const VkExtent3D extents, const VkSampleCountFlagBits sampleCount, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkImage* pImage) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    const VkImageCreateInfo createInfo = VkInit::MakeImageCreateInfo(extents, type, format, sampleCount, tiling, usage);
+
+    return vkCreateImage(m_Device, &createInfo, nullptr, pImage);
+}
+
+void VKR::VkContext::DestroyImage(VkImage& image) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    vkDestroyImage(m_Device, image, nullptr);
+}
+
+VkResult VKR::VkContext::AllocateMemory(const VkMemoryRequirements& requirements, const VkMemoryPropertyFlags requiredFlags, VmaAllocation* pAllocation) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.requiredFlags = requiredFlags;
+    allocInfo.memoryTypeBits = requirements.memoryTypeBits;
+
+    return vmaAllocateMemory(m_Allocator, &requirements, &allocInfo, pAllocation, nullptr);
+}
+
+void VKR::VkContext::FreeMemory(VmaAllocation& allocation) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    vmaFreeMemory(m_Allocator, allocation);
+}
+
+VkResult VKR::VkContext::BindImageMemory(const VmaAllocation allocation, const VkDeviceSize offset, const VkImage image) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    return vmaBindImageMemory2(m_Allocator, allocation, offset, image, nullptr);
+}
+
 VkResult VKR::VkContext::CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, VkImageView* pImageView) const
 {
     EASY_FUNCTION(profiler::colors::Red500);
@@ -479,6 +919,12 @@ void VKR::VkContext::DestroyCommandPool(VkCommandPool& commandPool) const
     vkDestroyCommandPool(m_Device, commandPool, nullptr);
 }
 
+VkResult VKR::VkContext::ResetCommandPool(const VkCommandPool commandPool, const uint32_t flags) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    return vkResetCommandPool(m_Device, commandPool, flags);
+}
+
 VkResult VKR::VkContext::AllocateCommandBuffers(const VkCommandPool commandPool, VkCommandBufferLevel level, const uint32_t count, VkCommandBuffer* pCommandBuffers) const
 {
     EASY_FUNCTION(profiler::colors::Red500);
@@ -493,7 +939,7 @@ VkResult VKR::VkContext::AllocateCommandBuffers(const VkCommandPool commandPool,
     return vkAllocateCommandBuffers(m_Device, &allocInfo, pCommandBuffers);
 }
 
-void VKR::VkContext::FreeCommandBuffers(const VkCommandPool commandPool, const uint32_t count, VkCommandBuffer* pCommandBuffers)
+void VKR::VkContext::FreeCommandBuffers(const VkCommandPool commandPool, const uint32_t count, VkCommandBuffer* pCommandBuffers) const
 {
     EASY_FUNCTION(profiler::colors::Red500);
     vkFreeCommandBuffers(m_Device, commandPool, count, pCommandBuffers);
@@ -520,13 +966,19 @@ void VKR::VkContext::DestroyDescriptorPool(VkDescriptorPool& descriptorPool) con
     vkDestroyDescriptorPool(m_Device, descriptorPool, nullptr);
 }
 
-VkResult VKR::VkContext::CreateDescriptorSetLayout(const uint32_t numBindings, const VkDescriptorSetLayoutBinding* pBindings, VkDescriptorSetLayout* pLayout)
+VkResult VKR::VkContext::ResetDescriptorPool(const VkDescriptorPool descriptorPool) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    return vkResetDescriptorPool(m_Device, descriptorPool, 0);
+}
+
+VkResult VKR::VkContext::CreateDescriptorSetLayout(const uint32_t numBindings, const VkDescriptorSetLayoutBinding* pBindings, VkDescriptorSetLayout* pLayout, const VkDescriptorSetLayoutCreateFlags flags, const void* pNext) const
 {
     EASY_FUNCTION(profiler::colors::Red500);
     const VkDescriptorSetLayoutCreateInfo createInfo = {
         VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-        nullptr,
-        0,
+        pNext,
+        flags,
         numBindings,
         pBindings
     };
@@ -534,13 +986,13 @@ VkResult VKR::VkContext::CreateDescriptorSetLayout(const uint32_t numBindings, c
     return vkCreateDescriptorSetLayout(m_Device, &createInfo, nullptr, pLayout);
 }
 
-void VKR::VkContext::DestroyDescriptorSetlayout(VkDescriptorSetLayout& layout)
+void VKR::VkContext::DestroyDescriptorSetlayout(VkDescriptorSetLayout& layout) const
 {
     EASY_FUNCTION(profiler::colors::Red500);
     vkDestroyDescriptorSetLayout(m_Device, layout, nullptr);
 }
 
-VkResult VKR::VkContext::AllocateDescriptorSets(const VkDescriptorPool descriptorPool, const uint32_t numSets, const VkDescriptorSetLayout* pLayouts, VkDescriptorSet* pSets)
+VkResult VKR::VkContext::AllocateDescriptorSets(const VkDescriptorPool descriptorPool, const uint32_t numSets, const VkDescriptorSetLayout* pLayouts, VkDescriptorSet* pSets) const
 {
     EASY_FUNCTION(profiler::colors::Red500);
     const VkDescriptorSetAllocateInfo allocInfo = {
@@ -642,6 +1094,31 @@ void VKR::VkContext::DestroyFrameBuffer(VkFramebuffer& frameBuffer) const
     vkDestroyFramebuffer(m_Device, frameBuffer, nullptr);
 }
 
+const bool VKR::VkContext::SupportsDynamicRendering() const
+{
+    return m_DynamicRendering;
+}
+
+void VKR::VkContext::CmdBeginRendering(const VkCommandBuffer commandBuffer, const VkRenderingInfo* pRenderingInfo) const
+{
+    m_pfnCmdBeginRendering(commandBuffer, pRenderingInfo);
+}
+
+void VKR::VkContext::CmdEndRendering(const VkCommandBuffer commandBuffer) const
+{
+    m_pfnCmdEndRendering(commandBuffer);
+}
+
+const bool VKR::VkContext::SupportsSynchronization2() const
+{
+    return m_Synchronization2;
+}
+
+void VKR::VkContext::CmdPipelineBarrier2(const VkCommandBuffer commandBuffer, const VkDependencyInfo* pDependencyInfo) const
+{
+    m_pfnCmdPipelineBarrier2(commandBuffer, pDependencyInfo);
+}
+
 VkResult VKR::VkContext::CreateQueryPool(const VkQueryType type, const uint32_t count, const VkQueryPipelineStatisticFlags pipelineStatistics, VkQueryPool* pPool)
 {
     EASY_FUNCTION(profiler::colors::Red500);
@@ -0,0 +1,49 @@
+#include "../../include/VKR/Vulkan/VkDeletionQueue.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include <easy/profiler.h>
+
+VKR::VkDeletionQueue::VkDeletionQueue()
+{
+}
+
+void VKR::VkDeletionQueue::Push(const uint64_t value, DeleteFunc&& func)
+{
+    m_Pending.push_back({ value, std::move(func) });
+}
+
+void VKR::VkDeletionQueue::Collect(const VkContext& context, const uint64_t completedValue)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //Values are pushed in roughly increasing order, but a deletion never runs early, so the whole queue is scanned.
+    size_t numPending = 0;
+    for (size_t i = 0; i < m_Pending.size(); i++) {
+        if (m_Pending[i].value <= completedValue) {
+            m_Pending[i].func(context);
+        }
+        else {
+            if (numPending != i) {
+                m_Pending[numPending] = std::move(m_Pending[i]);
+            }
+            numPending++;
+        }
+    }
+
+    m_Pending.resize(numPending);
+}
+
+void VKR::VkDeletionQueue::Flush(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    for (auto& deletion : m_Pending) {
+        deletion.func(context);
+    }
+
+    m_Pending.clear();
+}
+
+const uint32_t VKR::VkDeletionQueue::GetPendingCount() const
+{
+    return static_cast<uint32_t>(m_Pending.size());
+}
@@ -0,0 +1,179 @@
+#include "../../include/VKR/Vulkan/VkDescriptorAllocator.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <algorithm>
+
+//Pools grow geometrically, but are capped so a single pool never becomes unreasonably large.
+constexpr uint32_t MAX_SETS_PER_POOL = 4096;
+
+VKR::VkDescriptorAllocator::VkDescriptorAllocator()
+{
+    m_SetsPerPool = 0;
+    m_NumPools = 0;
+    m_FrameIndex = 0;
+}
+
+VkResult VKR::VkDescriptorAllocator::Create(const VkContext& context, const uint32_t setsPerPool, const uint32_t numRatios, const PoolSizeRatio* pRatios, const uint32_t framesInFlight)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (numRatios == 0 || pRatios == nullptr || setsPerPool == 0) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tDescriptor Allocator requires at least one Pool Size Ratio, and a non-zero pool size!\n");
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    m_Ratios.assign(pRatios, pRatios + numRatios);
+    m_SetsPerPool = setsPerPool;
+    m_NumPools = 0;
+
+    m_Frames.resize(std::max(framesInFlight, 1u));
+    m_FrameIndex = 0;
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkDescriptorAllocator::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    for (auto& frame : m_Frames) {
+        for (auto& pool : frame.readyPools) {
+            context.DestroyDescriptorPool(pool);
+        }
+        for (auto& pool : frame.fullPools) {
+            context.DestroyDescriptorPool(pool);
+        }
+    }
+
+    m_Frames.clear();
+    m_NumPools = 0;
+}
+
+VkResult VKR::VkDescriptorAllocator::BeginFrame(const VkContext& context, const uint32_t frameIndex)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    m_FrameIndex = frameIndex;
+    Frame& frame = m_Frames[m_FrameIndex];
+
+    //Resetting a pool frees all of its sets at once, so every pool becomes available again.
+    for (auto& pool : frame.readyPools) {
+        VkResult result = context.ResetDescriptorPool(pool);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+    for (auto& pool : frame.fullPools) {
+        VkResult result = context.ResetDescriptorPool(pool);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        frame.readyPools.push_back(pool);
+    }
+    frame.fullPools.clear();
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkDescriptorAllocator::Reset(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    const uint32_t currentFrame = m_FrameIndex;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_Frames.size()); i++) {
+        VkResult result = BeginFrame(context, i);
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Reset Descriptor Pools!\n");
+            return result;
+        }
+    }
+    m_FrameIndex = currentFrame;
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkDescriptorAllocator::Allocate(const VkContext& context, const VkDescriptorSetLayout layout, VkDescriptorSet* pSet, const void* pNext)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    Frame& frame = m_Frames[m_FrameIndex];
+
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VkResult result = AcquirePool(context, frame, &pool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        pNext,
+        pool,
+        1,
+        &layout
+    };
+
+    result = vkAllocateDescriptorSets(context.GetDevice(), &allocInfo, pSet);
+
+    //If the pool is exhausted, retire it and retry once from a fresh pool.
+    if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+        frame.fullPools.push_back(pool);
+        frame.readyPools.pop_back();
+
+        result = AcquirePool(context, frame, &pool);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+
+        allocInfo.descriptorPool = pool;
+        result = vkAllocateDescriptorSets(context.GetDevice(), &allocInfo, pSet);
+    }
+
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Allocate Descriptor Set!\n");
+    }
+
+    return result;
+}
+
+const uint32_t VKR::VkDescriptorAllocator::GetPoolCount() const
+{
+    return m_NumPools;
+}
+
+VkResult VKR::VkDescriptorAllocator::AcquirePool(const VkContext& context, Frame& frame, VkDescriptorPool* pPool)
+{
+    //Allocate from the most recent pool which may still have space.
+    if (!frame.readyPools.empty()) {
+        *pPool = frame.readyPools.back();
+        return VK_SUCCESS;
+    }
+
+    std::vector<VkDescriptorPoolSize> poolSizes;
+    poolSizes.reserve(m_Ratios.size());
+    for (const auto& ratio : m_Ratios) {
+        const uint32_t count = std::max(static_cast<uint32_t>(ratio.ratio * m_SetsPerPool), 1u);
+        poolSizes.push_back({ ratio.type, count });
+    }
+
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VkResult result = context.CreateDescriptorPool(m_SetsPerPool, 0, static_cast<uint32_t>(poolSizes.size()), poolSizes.data(), &pool);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Descriptor Pool!\n");
+        return result;
+    }
+
+    Log::Debug("[Vulkan]\tCreated Descriptor Pool %d with %d Sets.\n", m_NumPools, m_SetsPerPool);
+
+    //Grow the next pool, so that the number of pools stays small as demand increases.
+    m_SetsPerPool = std::min(m_SetsPerPool + std::max(m_SetsPerPool / 2, 1u), MAX_SETS_PER_POOL);
+    m_NumPools++;
+
+    frame.readyPools.push_back(pool);
+    *pPool = pool;
+
+    return VK_SUCCESS;
+}
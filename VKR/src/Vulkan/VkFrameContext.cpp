@@ -0,0 +1,246 @@
+#include "../../include/VKR/Vulkan/VkFrameContext.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <chrono>
+
+VKR::VkFrameContext::VkFrameContext()
+{
+    m_FrameIndex = 0;
+    m_Timeline = VK_NULL_HANDLE;
+    m_FrameValue = 0;
+    m_CPUWaitTime = 0.0;
+}
+
+VkResult VKR::VkFrameContext::Create(const VkContext& context, const uint32_t queueFamilyIndex, const uint32_t framesInFlight)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_FrameIndex = 0;
+    m_FrameValue = 0;
+    m_CPUWaitTime = 0.0;
+    m_Frames.resize(framesInFlight);
+
+    //The timeline starts at 0, so frames which have never been submitted are already complete.
+    VkResult result = context.CreateTimelineSemaphore(0, &m_Timeline);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Frame Timeline Semaphore!\n");
+        return result;
+    }
+
+    for (auto& frame : m_Frames) {
+        frame.commandPool = VK_NULL_HANDLE;
+        frame.imageAvailable = VK_NULL_HANDLE;
+        frame.renderFinished = VK_NULL_HANDLE;
+        frame.value = 0;
+        frame.primary.numUsed = 0;
+        frame.secondary.numUsed = 0;
+
+        //Command Buffers are only ever reset through their pool, so they needn't be individually resettable.
+        result = context.CreateCommandPool(queueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, &frame.commandPool);
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Frame Command Pool!\n");
+            return result;
+        }
+
+        result = context.CreateSemaphore(&frame.imageAvailable);
+        if (result == VK_SUCCESS) {
+            result = context.CreateSemaphore(&frame.renderFinished);
+        }
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Frame Semaphores!\n");
+            return result;
+        }
+    }
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkFrameContext::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    for (auto& frame : m_Frames) {
+        if (frame.renderFinished != VK_NULL_HANDLE) {
+            context.DestroySemaphore(frame.renderFinished);
+        }
+        if (frame.imageAvailable != VK_NULL_HANDLE) {
+            context.DestroySemaphore(frame.imageAvailable);
+        }
+        if (frame.commandPool != VK_NULL_HANDLE) {
+            context.DestroyCommandPool(frame.commandPool);  //Frees all of the pool's Command Buffers
+        }
+    }
+
+    m_Frames.clear();
+
+    if (m_Timeline != VK_NULL_HANDLE) {
+        context.DestroySemaphore(m_Timeline);
+    }
+}
+
+VkResult VKR::VkFrameContext::BeginFrame(const VkContext& context, const uint32_t frameIndex)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_FrameIndex = frameIndex;
+    m_FrameValue++;
+    Frame& frame = m_Frames[m_FrameIndex];
+
+    //Wait for the GPU to finish with this frame's resources, and record how long we were blocked for.
+    {
+        EASY_BLOCK("Wait for Frame", profiler::colors::Red500);
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        VkResult result = context.WaitSemaphore(m_Timeline, frame.value);
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to wait for Frame %d!\n", m_FrameIndex);
+            return result;
+        }
+
+        m_CPUWaitTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    //Return every Command Buffer allocated from the pool to the initial state in a single call.
+    VkResult result = context.ResetCommandPool(frame.commandPool);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Reset Frame %d Command Pool!\n", m_FrameIndex);
+        return result;
+    }
+
+    frame.primary.numUsed = 0;
+    frame.secondary.numUsed = 0;
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkFrameContext::AllocateCommandBuffer(const VkContext& context, const VkCommandBufferLevel level, VkCommandBuffer* pCommandBuffer)
+{
+    Frame& frame = m_Frames[m_FrameIndex];
+    CommandBufferList& list = (level == VK_COMMAND_BUFFER_LEVEL_PRIMARY) ? frame.primary : frame.secondary;
+
+    //Hand out a recycled Command Buffer if there is one.
+    if (list.numUsed < list.buffers.size()) {
+        *pCommandBuffer = list.buffers[list.numUsed++];
+        return VK_SUCCESS;
+    }
+
+    VkCommandBuffer cmd = VK_NULL_HANDLE;
+    VkResult result = context.AllocateCommandBuffers(frame.commandPool, level, 1, &cmd);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Allocate Command Buffer for Frame %d!\n", m_FrameIndex);
+        return result;
+    }
+
+    list.buffers.push_back(cmd);
+    list.numUsed++;
+    *pCommandBuffer = cmd;
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkFrameContext::Submit(const VkQueue queue, const uint32_t numCommandBuffers, const VkCommandBuffer* pCommandBuffers, const uint32_t numWaitSemaphores, const VkSemaphore* pWaitSemaphores, const uint64_t* pWaitValues, const VkPipelineStageFlags* pWaitStageMasks)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    Frame& frame = m_Frames[m_FrameIndex];
+
+    //The swapchain image is only needed once colour output is written.
+    std::vector<VkSemaphore> waitSemaphores = { frame.imageAvailable };
+    std::vector<VkPipelineStageFlags> waitStages = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+    std::vector<uint64_t> waitValues = { 0 };
+
+    for (uint32_t i = 0; i < numWaitSemaphores; i++) {
+        waitSemaphores.push_back(pWaitSemaphores[i]);
+        waitStages.push_back(pWaitStageMasks[i]);
+        waitValues.push_back(pWaitValues != nullptr ? pWaitValues[i] : 0);
+    }
+
+    const VkSemaphore signalSemaphores[] = { frame.renderFinished, m_Timeline };
+    const uint64_t signalValues[] = { 0, m_FrameValue };
+
+    const VkTimelineSemaphoreSubmitInfo timelineInfo = {
+        VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        nullptr,
+        static_cast<uint32_t>(waitValues.size()),
+        waitValues.data(),
+        2,
+        signalValues
+    };
+
+    const VkSubmitInfo submitInfo = {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        &timelineInfo,
+        static_cast<uint32_t>(waitSemaphores.size()),
+        waitSemaphores.data(),
+        waitStages.data(),
+        numCommandBuffers,
+        pCommandBuffers,
+        2,
+        signalSemaphores
+    };
+
+    VkResult result = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Submit Frame %d!\n", m_FrameIndex);
+        return result;
+    }
+
+    frame.value = m_FrameValue;
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkFrameContext::Wait(const VkContext& context, const uint64_t value, const uint64_t timeout) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    return context.WaitSemaphore(m_Timeline, value, timeout);
+}
+
+uint64_t VKR::VkFrameContext::GetCompletedValue(const VkContext& context) const
+{
+    uint64_t value = 0;
+    context.GetSemaphoreCounterValue(m_Timeline, &value);
+    return value;
+}
+
+bool VKR::VkFrameContext::IsComplete(const VkContext& context, const uint64_t value) const
+{
+    return GetCompletedValue(context) >= value;
+}
+
+const uint64_t VKR::VkFrameContext::GetFrameValue() const
+{
+    return m_FrameValue;
+}
+
+const VkSemaphore& VKR::VkFrameContext::GetTimelineSemaphore() const
+{
+    return m_Timeline;
+}
+
+const VkSemaphore& VKR::VkFrameContext::GetImageAvailableSemaphore() const
+{
+    return m_Frames[m_FrameIndex].imageAvailable;
+}
+
+const VkSemaphore& VKR::VkFrameContext::GetRenderFinishedSemaphore() const
+{
+    return m_Frames[m_FrameIndex].renderFinished;
+}
+
+const double VKR::VkFrameContext::GetCPUWaitTime() const
+{
+    return m_CPUWaitTime;
+}
+
+const uint32_t VKR::VkFrameContext::GetFrameIndex() const
+{
+    return m_FrameIndex;
+}
+
+const uint32_t VKR::VkFrameContext::GetFramesInFlight() const
+{
+    return static_cast<uint32_t>(m_Frames.size());
+}
@@ -0,0 +1,95 @@
+#include "../../include/VKR/Vulkan/VkFramePacer.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Vulkan/VkFrameContext.h"
+#include <easy/profiler.h>
+#include <thread>
+
+VKR::VkFramePacer::VkFramePacer()
+{
+    m_MaxFrameRate = 0.0;
+    m_NextFrameTime = Clock::now();
+    m_InputTime = m_NextFrameTime;
+    m_PresentLatency = 0.0;
+    m_CompletionLatency = 0.0;
+    m_LimiterWaitTime = 0.0;
+}
+
+void VKR::VkFramePacer::SetMaxFrameRate(const double maxFrameRate)
+{
+    m_MaxFrameRate = maxFrameRate > 0.0 ? maxFrameRate : 0.0;
+    m_NextFrameTime = Clock::now();
+}
+
+const double VKR::VkFramePacer::GetMaxFrameRate() const
+{
+    return m_MaxFrameRate;
+}
+
+void VKR::VkFramePacer::BeginFrame()
+{
+    m_InputTime = Clock::now();
+}
+
+void VKR::VkFramePacer::EndFrame(const VkContext& context, const VkFrameContext& frameContext)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    const Clock::time_point presentTime = Clock::now();
+    m_PresentLatency = std::chrono::duration<double, std::milli>(presentTime - m_InputTime).count();
+    m_PendingFrames.push_back({ frameContext.GetFrameValue(), m_InputTime });
+
+    //Frames complete in submission order, so the latest completed frame is the last one resolved.
+    const uint64_t completedValue = frameContext.GetCompletedValue(context);
+    size_t numResolved = 0;
+    while (numResolved < m_PendingFrames.size() && m_PendingFrames[numResolved].value <= completedValue) {
+        m_CompletionLatency = std::chrono::duration<double, std::milli>(presentTime - m_PendingFrames[numResolved].inputTime).count();
+        numResolved++;
+    }
+    m_PendingFrames.erase(m_PendingFrames.begin(), m_PendingFrames.begin() + numResolved);
+
+    Limit();
+}
+
+const double VKR::VkFramePacer::GetPresentLatency() const
+{
+    return m_PresentLatency;
+}
+
+const double VKR::VkFramePacer::GetCompletionLatency() const
+{
+    return m_CompletionLatency;
+}
+
+const double VKR::VkFramePacer::GetLimiterWaitTime() const
+{
+    return m_LimiterWaitTime;
+}
+
+void VKR::VkFramePacer::Limit()
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    const Clock::time_point start = Clock::now();
+    if (m_MaxFrameRate == 0.0) {
+        m_NextFrameTime = start;
+        m_LimiterWaitTime = 0.0;
+        return;
+    }
+
+    //Frames are scheduled at fixed intervals, but a frame which runs late doesn't let the following ones catch up.
+    m_NextFrameTime += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_MaxFrameRate));
+    if (m_NextFrameTime < start) {
+        m_NextFrameTime = start;
+    }
+
+    //Sleeping overshoots by up to the scheduler's granularity, so sleep short of the deadline, and yield for the remainder.
+    const auto spinTime = std::chrono::milliseconds(1);
+    if (m_NextFrameTime - start > spinTime) {
+        std::this_thread::sleep_until(m_NextFrameTime - spinTime);
+    }
+    while (Clock::now() < m_NextFrameTime) {
+        std::this_thread::yield();
+    }
+
+    m_LimiterWaitTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
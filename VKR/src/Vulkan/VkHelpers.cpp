@@ -2,6 +2,7 @@
 #include <vector>   //TODO: Remove all calls to new / delete, replace with std::vector. 
 #include "../../include/VKR/Logger.h"
 #include <cstring>
+#include <algorithm>
 
 
 uint32_t VKR::VkHelpers::FindQueueFamilyIndex(VkPhysicalDevice device, VkQueueFlags flags)
@@ -9,20 +10,35 @@ uint32_t VKR::VkHelpers::FindQueueFamilyIndex(VkPhysicalDevice device, VkQueueFl
     uint32_t familyCount;
 
     vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, nullptr);
-    VkQueueFamilyProperties* pFamilies = new VkQueueFamilyProperties[familyCount];
-    vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, pFamilies);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, families.data());
 
     for (uint32_t i = 0; i < familyCount; i++) {
-        if (pFamilies[i].queueCount && (pFamilies[i].queueFlags & flags)) {
+        if (families[i].queueCount && (families[i].queueFlags & flags)) {
             return i;
         }
     }
 
-    delete[] pFamilies;
-
     return 0;
 }
 
+uint32_t VKR::VkHelpers::FindDedicatedQueueFamilyIndex(VkPhysicalDevice device, VkQueueFlags flags, VkQueueFlags excludeFlags)
+{
+    uint32_t familyCount;
+
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, families.data());
+
+    for (uint32_t i = 0; i < familyCount; i++) {
+        if (families[i].queueCount && ((families[i].queueFlags & flags) == flags) && !(families[i].queueFlags & excludeFlags)) {
+            return i;
+        }
+    }
+
+    return UINT32_MAX;
+}
+
 uint32_t VKR::VkHelpers::FindMemoryTypeIndex(VkPhysicalDevice device, uint32_t typeFilter, VkMemoryPropertyFlags properties)
 {
     VkPhysicalDeviceMemoryProperties memProperties;
@@ -319,6 +335,86 @@ bool VKR::VkHelpers::ValidatePhysicalDeviceExtensionSupportArray(const VkPhysica
     return result;
 }
 
+uint64_t VKR::VkHelpers::ScorePhysicalDevice(const VkPhysicalDevice& device, const VkPhysicalDeviceRequirements& requirements)
+{
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(device, &properties);
+
+    //Reject devices which don't meet the requirements.
+    if (properties.apiVersion < requirements.minAPIVersion) {
+        return 0;
+    }
+
+    if (requirements.numExtensions > 0 && !ValidatePhysicalDeviceExtensionSupportArray(device, requirements.numExtensions, requirements.ppExtensions)) {
+        return 0;
+    }
+
+    if (requirements.pFeatures != nullptr && !ValidatePhysicalDeviceFeatureSupport(device, *requirements.pFeatures)) {
+        return 0;
+    }
+
+    if (requirements.queueFlags != 0 && FindDedicatedQueueFamilyIndex(device, requirements.queueFlags, 0) == UINT32_MAX) {
+        return 0;
+    }
+
+    //Device type outweighs everything else, so a discrete GPU is always preferred over an integrated or software device.
+    uint64_t score = 1;
+    switch (properties.deviceType) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+        score += 1000000;
+        break;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+        score += 100000;
+        break;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+        score += 50000;
+        break;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:
+        break;
+    default:
+        score += 10000;
+        break;
+    }
+
+    //Then by device-local memory, in MiB.
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(device, &memProperties);
+    for (uint32_t i = 0; i < memProperties.memoryHeapCount; i++) {
+        if (memProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            score += std::min<uint64_t>(memProperties.memoryHeaps[i].size >> 20, 65536) / 16;
+        }
+    }
+
+    //Then by async Compute and Transfer capability.
+    if (FindDedicatedQueueFamilyIndex(device, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT) != UINT32_MAX) {
+        score += 100;
+    }
+    if (FindDedicatedQueueFamilyIndex(device, VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT) != UINT32_MAX) {
+        score += 100;
+    }
+
+    return score;
+}
+
+bool VKR::VkHelpers::ValidatePhysicalDeviceFeatureSupport(const VkPhysicalDevice& device, const VkPhysicalDeviceFeatures& features)
+{
+    VkPhysicalDeviceFeatures supported;
+    vkGetPhysicalDeviceFeatures(device, &supported);
+
+    //VkPhysicalDeviceFeatures is a flat struct of VkBool32s, so compare it member by member.
+    const VkBool32* pRequested = reinterpret_cast<const VkBool32*>(&features);
+    const VkBool32* pSupported = reinterpret_cast<const VkBool32*>(&supported);
+    const size_t count = sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32);
+
+    for (size_t i = 0; i < count; i++) {
+        if (pRequested[i] && !pSupported[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool VKR::VkHelpers::ValidatePhysicalDevicePresentationSupport(const VkPhysicalDevice& device, const uint32_t presentQueueFamilyIndex, VkSurfaceKHR surface)
 {
     VkBool32 presentSupported = VK_FALSE;
@@ -86,6 +86,28 @@ void VKR::VkImGui::Hook(const VkContext& context, const uint32_t queueFamilyInde
     ImGui_ImplVulkan_Init(&initInfo); 
 }
 
+void VKR::VkImGui::Hook(const VkContext& context, const uint32_t queueFamilyIndex, const VkQueue queue, const VkPipelineCache pipelineCache, const uint32_t imageCount, const VkFormat colorFormat, const VkSampleCountFlagBits samples)
+{
+    ImGui_ImplVulkan_InitInfo initInfo = {}; 
+    initInfo.Instance = context.GetInstance(); 
+    initInfo.PhysicalDevice = context.GetPhysicalDevice(); 
+    initInfo.Device = context.GetDevice(); 
+    initInfo.QueueFamily = queueFamilyIndex; 
+    initInfo.Queue = queue; 
+    initInfo.PipelineCache = pipelineCache; 
+    initInfo.MinImageCount = imageCount;
+    initInfo.ImageCount = imageCount; 
+    initInfo.RenderPass = VK_NULL_HANDLE;
+    initInfo.UseDynamicRendering = true;
+    initInfo.ColorAttachmentFormat = colorFormat;
+    initInfo.DescriptorPool = m_DescriptorPool;
+    initInfo.MSAASamples = samples; 
+    initInfo.Allocator = nullptr; 
+    initInfo.CheckVkResultFn = nullptr;
+
+    ImGui_ImplVulkan_Init(&initInfo); 
+}
+
 void VKR::VkImGui::Draw(VkCommandBuffer* pCmd)
 {
     ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), *pCmd);
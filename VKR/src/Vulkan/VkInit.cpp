@@ -76,6 +76,151 @@ VkImageCreateInfo VKR::VkInit::MakeImageCreateInfo(const VkExtent3D extents, con
     };
 }
 
+VkCommandBufferInheritanceInfo VKR::VkInit::MakeCommandBufferInheritanceInfo(const VkRenderPass renderPass, const uint32_t subpass, const VkFramebuffer frameBuffer, const void* pNext)
+{
+    return {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        pNext,
+        renderPass,
+        subpass,
+        frameBuffer,
+        VK_FALSE,
+        0,
+        0
+    };
+}
+
+VkPhysicalDeviceDynamicRenderingFeatures VKR::VkInit::MakePhysicalDeviceDynamicRenderingFeatures(void* pNext)
+{
+    return {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES,
+        pNext,
+        VK_TRUE
+    };
+}
+
+VkCommandBufferInheritanceRenderingInfo VKR::VkInit::MakeCommandBufferInheritanceRenderingInfo(const uint32_t numColorFormats, const VkFormat* pColorFormats, const VkFormat depthFormat, const VkFormat stencilFormat, const VkSampleCountFlagBits samples, const VkRenderingFlags flags)
+{
+    return {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+        nullptr,
+        flags,
+        0,  //View Mask
+        numColorFormats,
+        pColorFormats,
+        depthFormat,
+        stencilFormat,
+        samples
+    };
+}
+
+VkRenderingAttachmentInfo VKR::VkInit::MakeRenderingAttachmentInfo(const VkImageView imageView, const VkImageLayout imageLayout, const VkAttachmentLoadOp loadOp, const VkAttachmentStoreOp storeOp, const VkClearValue clearValue, const VkResolveModeFlagBits resolveMode, const VkImageView resolveImageView, const VkImageLayout resolveImageLayout)
+{
+    return {
+        VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        nullptr,
+        imageView,
+        imageLayout,
+        resolveMode,
+        resolveImageView,
+        resolveImageLayout,
+        loadOp,
+        storeOp,
+        clearValue
+    };
+}
+
+VkRenderingInfo VKR::VkInit::MakeRenderingInfo(const VkRect2D renderArea, const uint32_t numColorAttachments, const VkRenderingAttachmentInfo* pColorAttachments, const VkRenderingAttachmentInfo* pDepthAttachment, const VkRenderingAttachmentInfo* pStencilAttachment, const VkRenderingFlags flags)
+{
+    return {
+        VK_STRUCTURE_TYPE_RENDERING_INFO,
+        nullptr,
+        flags,
+        renderArea,
+        1,  //Layer Count
+        0,  //View Mask
+        numColorAttachments,
+        pColorAttachments,
+        pDepthAttachment,
+        pStencilAttachment
+    };
+}
+
+VkImageMemoryBarrier VKR::VkInit::MakeImageMemoryBarrier(const VkImage image, const VkImageAspectFlags aspectFlags, const VkImageLayout oldLayout, const VkImageLayout newLayout, const VkAccessFlags srcAccessMask, const VkAccessFlags dstAccessMask)
+{
+    return {
+        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        nullptr,
+        srcAccessMask,
+        dstAccessMask,
+        oldLayout,
+        newLayout,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        image,
+        { aspectFlags, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS }
+    };
+}
+
+VkPhysicalDeviceSynchronization2Features VKR::VkInit::MakePhysicalDeviceSynchronization2Features(void* pNext)
+{
+    return {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES,
+        pNext,
+        VK_TRUE
+    };
+}
+
+VkImageMemoryBarrier2 VKR::VkInit::MakeImageMemoryBarrier2(const VkImage image, const VkImageAspectFlags aspectFlags, const VkImageLayout oldLayout, const VkImageLayout newLayout, const VkPipelineStageFlags2 srcStageMask, const VkAccessFlags2 srcAccessMask, const VkPipelineStageFlags2 dstStageMask, const VkAccessFlags2 dstAccessMask)
+{
+    return {
+        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+        nullptr,
+        srcStageMask,
+        srcAccessMask,
+        dstStageMask,
+        dstAccessMask,
+        oldLayout,
+        newLayout,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        image,
+        { aspectFlags, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS }
+    };
+}
+
+VkBufferMemoryBarrier2 VKR::VkInit::MakeBufferMemoryBarrier2(const VkBuffer buffer, const VkPipelineStageFlags2 srcStageMask, const VkAccessFlags2 srcAccessMask, const VkPipelineStageFlags2 dstStageMask, const VkAccessFlags2 dstAccessMask)
+{
+    return {
+        VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+        nullptr,
+        srcStageMask,
+        srcAccessMask,
+        dstStageMask,
+        dstAccessMask,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        buffer,
+        0,
+        VK_WHOLE_SIZE
+    };
+}
+
+VkDependencyInfo VKR::VkInit::MakeDependencyInfo(const uint32_t numImageBarriers, const VkImageMemoryBarrier2* pImageBarriers, const uint32_t numBufferBarriers, const VkBufferMemoryBarrier2* pBufferBarriers)
+{
+    return {
+        VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        nullptr,
+        0,
+        0,
+        nullptr,
+        numBufferBarriers,
+        pBufferBarriers,
+        numImageBarriers,
+        pImageBarriers
+    };
+}
+
 VkDescriptorPoolSize VKR::VkInit::MakeDescriptorPoolSize(const VkDescriptorType type, const uint32_t count)
 {
     return {
@@ -253,3 +398,16 @@ VkPipelineDynamicStateCreateInfo VKR::VkInit::MakePipelineDynamicStateCreateInfo
         nullptr,
     };
 }
+
+VkPipelineRenderingCreateInfo VKR::VkInit::MakePipelineRenderingCreateInfo()
+{
+    return {
+        VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+        nullptr,
+        0,
+        0,
+        nullptr,
+        VK_FORMAT_UNDEFINED,
+        VK_FORMAT_UNDEFINED
+    };
+}
@@ -0,0 +1,220 @@
+#include "../../include/VKR/Vulkan/VkLayoutCache.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+
+//Mixes 'value' into 'seed', as in boost::hash_combine.
+template<typename T>
+static void HashCombine(size_t& seed, const T& value)
+{
+    seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+VKR::VkLayoutCache::VkLayoutCache()
+{
+    m_Hits = 0;
+}
+
+void VKR::VkLayoutCache::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    //Pipeline Layouts reference the Set Layouts, so are destroyed first.
+    for (auto& entry : m_PipelineLayouts) {
+        context.DestroyPipelineLayout(entry.second);
+    }
+    for (auto& entry : m_DescriptorSetLayouts) {
+        context.DestroyDescriptorSetlayout(entry.second);
+    }
+
+    Log::Debug("[Vulkan]\tDestroyed Layout Cache. (%d Set Layouts, %d Pipeline Layouts, %llu hits)\n", static_cast<uint32_t>(m_DescriptorSetLayouts.size()), static_cast<uint32_t>(m_PipelineLayouts.size()), static_cast<unsigned long long>(m_Hits));
+
+    m_PipelineLayouts.clear();
+    m_DescriptorSetLayouts.clear();
+    m_Hits = 0;
+}
+
+VkResult VKR::VkLayoutCache::GetDescriptorSetLayout(const VkContext& context, const uint32_t numBindings, const VkDescriptorSetLayoutBinding* pBindings, VkDescriptorSetLayout* pLayout, const VkDescriptorSetLayoutCreateFlags flags, const VkDescriptorBindingFlags* pBindingFlags)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //Sort the bindings by index, so the same layout described in a different order produces the same key.
+    std::vector<uint32_t> order(numBindings);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [pBindings](const uint32_t a, const uint32_t b) { return pBindings[a].binding < pBindings[b].binding; });
+
+    DescriptorSetLayoutKey key = {};
+    key.flags = flags;
+    key.bindings.reserve(numBindings);
+    for (const uint32_t i : order) {
+        VkDescriptorSetLayoutBinding binding = pBindings[i];
+        if (binding.pImmutableSamplers != nullptr) {
+            key.immutableSamplers.insert(key.immutableSamplers.end(), binding.pImmutableSamplers, binding.pImmutableSamplers + binding.descriptorCount);
+        }
+        binding.pImmutableSamplers = nullptr;    //Compared through immutableSamplers instead.
+        key.bindings.push_back(binding);
+
+        if (pBindingFlags != nullptr) {
+            key.bindingFlags.push_back(pBindingFlags[i]);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_DescriptorSetLayouts.find(key);
+    if (it != m_DescriptorSetLayouts.end()) {
+        m_Hits++;
+        *pLayout = it->second;
+        return VK_SUCCESS;
+    }
+
+    //Restore the immutable sampler pointers in sorted order for creation.
+    std::vector<VkDescriptorSetLayoutBinding> bindings(key.bindings);
+    for (uint32_t i = 0; i < numBindings; i++) {
+        bindings[i].pImmutableSamplers = pBindings[order[i]].pImmutableSamplers;
+    }
+
+    const VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        nullptr,
+        static_cast<uint32_t>(key.bindingFlags.size()),
+        key.bindingFlags.data()
+    };
+
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    VkResult result = context.CreateDescriptorSetLayout(numBindings, bindings.data(), &layout, flags, pBindingFlags != nullptr ? &bindingFlagsInfo : nullptr);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Descriptor Set Layout!\n");
+        return result;
+    }
+
+    m_DescriptorSetLayouts.emplace(std::move(key), layout);
+    *pLayout = layout;
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkLayoutCache::GetPipelineLayout(const VkContext& context, const uint32_t numSetLayouts, const VkDescriptorSetLayout* pSetLayouts, const uint32_t numPushConstants, const VkPushConstantRange* pPushConstants, VkPipelineLayout* pPipelineLayout)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //Set order is significant, as it determines set indices, but Push Constant ranges are not.
+    PipelineLayoutKey key = {};
+    key.setLayouts.assign(pSetLayouts, pSetLayouts + numSetLayouts);
+    key.pushConstants.assign(pPushConstants, pPushConstants + numPushConstants);
+    std::sort(key.pushConstants.begin(), key.pushConstants.end(), [](const VkPushConstantRange& a, const VkPushConstantRange& b) {
+        return a.offset != b.offset ? a.offset < b.offset : a.stageFlags < b.stageFlags;
+    });
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_PipelineLayouts.find(key);
+    if (it != m_PipelineLayouts.end()) {
+        m_Hits++;
+        *pPipelineLayout = it->second;
+        return VK_SUCCESS;
+    }
+
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    VkResult result = context.CreatePipelineLayout(numSetLayouts, key.setLayouts.data(), numPushConstants, key.pushConstants.data(), &layout);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Pipeline Layout!\n");
+        return result;
+    }
+
+    m_PipelineLayouts.emplace(std::move(key), layout);
+    *pPipelineLayout = layout;
+
+    return VK_SUCCESS;
+}
+
+const uint32_t VKR::VkLayoutCache::GetDescriptorSetLayoutCount() const
+{
+    return static_cast<uint32_t>(m_DescriptorSetLayouts.size());
+}
+
+const uint32_t VKR::VkLayoutCache::GetPipelineLayoutCount() const
+{
+    return static_cast<uint32_t>(m_PipelineLayouts.size());
+}
+
+const uint64_t VKR::VkLayoutCache::GetHitCount() const
+{
+    return m_Hits;
+}
+
+bool VKR::VkLayoutCache::DescriptorSetLayoutKey::operator==(const DescriptorSetLayoutKey& other) const
+{
+    if (flags != other.flags || bindings.size() != other.bindings.size() || bindingFlags != other.bindingFlags || immutableSamplers != other.immutableSamplers) {
+        return false;
+    }
+
+    for (size_t i = 0; i < bindings.size(); i++) {
+        const VkDescriptorSetLayoutBinding& a = bindings[i];
+        const VkDescriptorSetLayoutBinding& b = other.bindings[i];
+        if (a.binding != b.binding || a.descriptorType != b.descriptorType || a.descriptorCount != b.descriptorCount || a.stageFlags != b.stageFlags) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool VKR::VkLayoutCache::PipelineLayoutKey::operator==(const PipelineLayoutKey& other) const
+{
+    if (setLayouts != other.setLayouts || pushConstants.size() != other.pushConstants.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < pushConstants.size(); i++) {
+        const VkPushConstantRange& a = pushConstants[i];
+        const VkPushConstantRange& b = other.pushConstants[i];
+        if (a.stageFlags != b.stageFlags || a.offset != b.offset || a.size != b.size) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t VKR::VkLayoutCache::KeyHash::operator()(const DescriptorSetLayoutKey& key) const
+{
+    size_t seed = 0;
+    HashCombine(seed, key.flags);
+
+    for (const auto& binding : key.bindings) {
+        HashCombine(seed, binding.binding);
+        HashCombine(seed, static_cast<uint32_t>(binding.descriptorType));
+        HashCombine(seed, binding.descriptorCount);
+        HashCombine(seed, binding.stageFlags);
+    }
+    for (const auto& bindingFlags : key.bindingFlags) {
+        HashCombine(seed, bindingFlags);
+    }
+    for (const auto& sampler : key.immutableSamplers) {
+        HashCombine(seed, sampler);
+    }
+
+    return seed;
+}
+
+size_t VKR::VkLayoutCache::KeyHash::operator()(const PipelineLayoutKey& key) const
+{
+    size_t seed = 0;
+
+    for (const auto& setLayout : key.setLayouts) {
+        HashCombine(seed, setLayout);
+    }
+    for (const auto& range : key.pushConstants) {
+        HashCombine(seed, range.stageFlags);
+        HashCombine(seed, range.offset);
+        HashCombine(seed, range.size);
+    }
+
+    return seed;
+}
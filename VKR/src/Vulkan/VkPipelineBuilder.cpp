@@ -3,6 +3,52 @@
 #include "../../include/VKR/Vulkan/VkInit.h"
 #include "../../include/VKR/Logger.h"
 #include <easy/profiler.h>
+#include <algorithm>
+#include <cstring>
+
+//Non-dispatchable handles are pointers on 64-bit platforms, and uint64_t elsewhere.
+template<typename T>
+static uint64_t HandleValue(const T handle)
+{
+    return (uint64_t)(handle);
+}
+
+VKR::VkPipelineKey::VkPipelineKey(const void* pData, const size_t size)
+{
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+    for (size_t i = 0; i < size; i++) {
+        Write(pBytes[i]);
+    }
+}
+
+bool VKR::VkPipelineKey::operator==(const VkPipelineKey& other) const
+{
+    return m_Hash == other.m_Hash && m_Data == other.m_Data;
+}
+
+bool VKR::VkPipelineKey::operator!=(const VkPipelineKey& other) const
+{
+    return !(*this == other);
+}
+
+const uint64_t VKR::VkPipelineKey::GetHash() const
+{
+    return m_Hash;
+}
+
+const std::vector<uint8_t>& VKR::VkPipelineKey::GetData() const
+{
+    return m_Data;
+}
+
+void VKR::VkPipelineKey::Write(const char* str)
+{
+    const uint32_t length = str != nullptr ? static_cast<uint32_t>(strlen(str)) : 0;
+    Write(length);
+    for (uint32_t i = 0; i < length; i++) {
+        Write(str[i]);
+    }
+}
 
 VKR::VkPipelineBuilder::VkPipelineBuilder() {
     //Default Initialize our Pipeline State
@@ -16,6 +62,42 @@ VKR::VkPipelineBuilder::VkPipelineBuilder() {
     m_DepthStencilState = VkInit::MakePipelineDepthStencilStateCreateInfo();
     m_BlendState = VkInit::MakePipelineColorBlendStateCreateInfo();
     m_DynamicState = VkInit::MakePipelineDynamicStateCreateInfo();
+    m_RenderingState = VkInit::MakePipelineRenderingCreateInfo();
+}
+
+VKR::VkPipelineBuilder::VkPipelineBuilder(const VkPipelineBuilder& other)
+{
+    *this = other;
+}
+
+VKR::VkPipelineBuilder& VKR::VkPipelineBuilder::operator=(const VkPipelineBuilder& other)
+{
+    m_ShaderStages = other.m_ShaderStages;
+    m_ShaderIDs = other.m_ShaderIDs;
+    m_VertexInputState = other.m_VertexInputState;
+    m_InputAssemblyState = other.m_InputAssemblyState;
+    m_TessellationState = other.m_TessellationState;
+    m_ViewportState = other.m_ViewportState;
+    m_RasterizerState = other.m_RasterizerState;
+    m_MSAAState = other.m_MSAAState;
+    m_DepthStencilState = other.m_DepthStencilState;
+    m_BlendState = other.m_BlendState;
+    m_DynamicState = other.m_DynamicState;
+    m_RenderingState = other.m_RenderingState;
+
+    m_VertexBindings = other.m_VertexBindings;
+    m_VertexAttributes = other.m_VertexAttributes;
+    m_Viewports = other.m_Viewports;
+    m_Scissors = other.m_Scissors;
+    m_SampleMask = other.m_SampleMask;
+    m_BlendAttachments = other.m_BlendAttachments;
+    m_DynamicStates = other.m_DynamicStates;
+    m_ColorFormats = other.m_ColorFormats;
+
+    //The copied create infos still point into 'other'.
+    UpdatePointers();
+
+    return *this;
 }
 
 const VkGraphicsPipelineCreateInfo VKR::VkPipelineBuilder::BuildGraphicsPipeline(const VkPipelineLayout layout, const VkRenderPass renderPass, const uint32_t subpassIdx) const
@@ -65,9 +147,10 @@ const VkGraphicsPipelineCreateInfo VKR::VkPipelineBuilder::BuildGraphicsPipeline
     }
 
 
+    //Without a Render Pass, the Pipeline is built for Dynamic Rendering against the attachment formats instead.
     return {
           VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-          nullptr,
+          renderPass == VK_NULL_HANDLE ? &m_RenderingState : nullptr,
           0,
           static_cast<uint32_t>(m_ShaderStages.size()),
           m_ShaderStages.data(),
@@ -110,7 +193,128 @@ const VkComputePipelineCreateInfo VKR::VkPipelineBuilder::BuildComputePipeline(c
     };
 }
 
-void VKR::VkPipelineBuilder::AddShaderStage(const VkShaderModule shaderModule, const VkShaderStageFlagBits stage, const char* entryPoint)
+VKR::VkPipelineKey VKR::VkPipelineBuilder::BuildGraphicsPipelineKey(const VkPipelineLayout layout, const VkRenderPass renderPass, const uint32_t subpassIdx) const
+{
+    EASY_FUNCTION(profiler::colors::Red300);
+
+    VkPipelineKey key;
+    key.Write(static_cast<uint8_t>(VK_PIPELINE_BIND_POINT_GRAPHICS));
+
+    //Every field is written individually, so padding never reaches the key.
+    key.Write(static_cast<uint32_t>(m_ShaderStages.size()));
+    for (size_t i = 0; i < m_ShaderStages.size(); i++) {
+        key.Write(m_ShaderStages[i].stage);
+        key.Write(m_ShaderIDs[i] != 0 ? m_ShaderIDs[i] : HandleValue(m_ShaderStages[i].module));
+        key.Write(m_ShaderStages[i].pName);
+    }
+
+    key.Write(static_cast<uint32_t>(m_VertexBindings.size()));
+    for (const auto& binding : m_VertexBindings) {
+        key.Write(binding);
+    }
+    key.Write(static_cast<uint32_t>(m_VertexAttributes.size()));
+    for (const auto& attribute : m_VertexAttributes) {
+        key.Write(attribute);
+    }
+
+    key.Write(m_InputAssemblyState.topology);
+    key.Write(m_InputAssemblyState.primitiveRestartEnable);
+    key.Write(m_TessellationState.patchControlPoints);
+
+    //Dynamic viewports and scissors don't affect the Pipeline, so only their counts are significant.
+    const bool dynamicViewport = std::find(m_DynamicStates.begin(), m_DynamicStates.end(), VK_DYNAMIC_STATE_VIEWPORT) != m_DynamicStates.end();
+    const bool dynamicScissor = std::find(m_DynamicStates.begin(), m_DynamicStates.end(), VK_DYNAMIC_STATE_SCISSOR) != m_DynamicStates.end();
+    key.Write(m_ViewportState.viewportCount);
+    key.Write(m_ViewportState.scissorCount);
+    if (!dynamicViewport) {
+        for (const auto& viewport : m_Viewports) {
+            key.Write(viewport);
+        }
+    }
+    if (!dynamicScissor) {
+        for (const auto& scissor : m_Scissors) {
+            key.Write(scissor);
+        }
+    }
+
+    key.Write(m_RasterizerState.depthClampEnable);
+    key.Write(m_RasterizerState.rasterizerDiscardEnable);
+    key.Write(m_RasterizerState.polygonMode);
+    key.Write(m_RasterizerState.cullMode);
+    key.Write(m_RasterizerState.frontFace);
+    key.Write(m_RasterizerState.depthBiasEnable);
+    key.Write(m_RasterizerState.depthBiasConstantFactor);
+    key.Write(m_RasterizerState.depthBiasClamp);
+    key.Write(m_RasterizerState.depthBiasSlopeFactor);
+    key.Write(m_RasterizerState.lineWidth);
+
+    key.Write(m_MSAAState.rasterizationSamples);
+    key.Write(m_MSAAState.sampleShadingEnable);
+    key.Write(m_MSAAState.minSampleShading);
+    key.Write(static_cast<uint32_t>(m_SampleMask.size()));
+    for (const auto& mask : m_SampleMask) {
+        key.Write(mask);
+    }
+    key.Write(m_MSAAState.alphaToCoverageEnable);
+    key.Write(m_MSAAState.alphaToOneEnable);
+
+    key.Write(m_DepthStencilState.depthTestEnable);
+    key.Write(m_DepthStencilState.depthWriteEnable);
+    key.Write(m_DepthStencilState.depthCompareOp);
+    key.Write(m_DepthStencilState.depthBoundsTestEnable);
+    key.Write(m_DepthStencilState.stencilTestEnable);
+    key.Write(m_DepthStencilState.front);
+    key.Write(m_DepthStencilState.back);
+    key.Write(m_DepthStencilState.minDepthBounds);
+    key.Write(m_DepthStencilState.maxDepthBounds);
+
+    key.Write(m_BlendState.logicOpEnable);
+    key.Write(m_BlendState.logicOp);
+    key.Write(static_cast<uint32_t>(m_BlendAttachments.size()));
+    for (const auto& attachment : m_BlendAttachments) {
+        key.Write(attachment);
+    }
+    key.Write(m_BlendState.blendConstants);
+
+    key.Write(static_cast<uint32_t>(m_DynamicStates.size()));
+    for (const auto& state : m_DynamicStates) {
+        key.Write(state);
+    }
+
+    key.Write(HandleValue(layout));
+    key.Write(HandleValue(renderPass));
+    key.Write(subpassIdx);
+
+    if (renderPass == VK_NULL_HANDLE) {
+        key.Write(m_RenderingState.viewMask);
+        key.Write(static_cast<uint32_t>(m_ColorFormats.size()));
+        for (const auto& format : m_ColorFormats) {
+            key.Write(format);
+        }
+        key.Write(m_RenderingState.depthAttachmentFormat);
+        key.Write(m_RenderingState.stencilAttachmentFormat);
+    }
+
+    return key;
+}
+
+VKR::VkPipelineKey VKR::VkPipelineBuilder::BuildComputePipelineKey(const VkPipelineLayout layout) const
+{
+    EASY_FUNCTION(profiler::colors::Red300);
+
+    VkPipelineKey key;
+    key.Write(static_cast<uint8_t>(VK_PIPELINE_BIND_POINT_COMPUTE));
+
+    if (!m_ShaderStages.empty()) {
+        key.Write(m_ShaderIDs[0] != 0 ? m_ShaderIDs[0] : HandleValue(m_ShaderStages[0].module));
+        key.Write(m_ShaderStages[0].pName);
+    }
+    key.Write(HandleValue(layout));
+
+    return key;
+}
+
+void VKR::VkPipelineBuilder::AddShaderStage(const VkShaderModule shaderModule, const VkShaderStageFlagBits stage, const char* entryPoint, const uint64_t shaderID)
 {
     EASY_FUNCTION(profiler::colors::Red300);
     const VkPipelineShaderStageCreateInfo createInfo = {
@@ -123,14 +327,41 @@ void VKR::VkPipelineBuilder::AddShaderStage(const VkShaderModule shaderModule, c
     };
 
     m_ShaderStages.push_back(createInfo);
+    m_ShaderIDs.push_back(shaderID);
+}
+
+bool VKR::VkPipelineBuilder::ReplaceShaderModule(const VkShaderModule oldModule, const VkShaderModule newModule, const uint64_t shaderID)
+{
+    bool replaced = false;
+    for (size_t i = 0; i < m_ShaderStages.size(); i++) {
+        if (m_ShaderStages[i].module == oldModule) {
+            m_ShaderStages[i].module = newModule;
+            m_ShaderIDs[i] = shaderID;
+            replaced = true;
+        }
+    }
+
+    return replaced;
+}
+
+bool VKR::VkPipelineBuilder::UsesShaderModule(const VkShaderModule shaderModule) const
+{
+    for (const auto& stage : m_ShaderStages) {
+        if (stage.module == shaderModule) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void VKR::VkPipelineBuilder::SetVertexInputState(const uint32_t numBindings, const VkVertexInputBindingDescription* pBindings, const uint32_t numAttributes, const VkVertexInputAttributeDescription* pAttributes)
 {
+    m_VertexBindings.assign(pBindings, pBindings + numBindings);
+    m_VertexAttributes.assign(pAttributes, pAttributes + numAttributes);
     m_VertexInputState.vertexBindingDescriptionCount = numBindings;
-    m_VertexInputState.pVertexBindingDescriptions = pBindings;
     m_VertexInputState.vertexAttributeDescriptionCount = numAttributes;
-    m_VertexInputState.pVertexAttributeDescriptions = pAttributes;
+    UpdatePointers();
 }
 
 void VKR::VkPipelineBuilder::SetInputAssemblyState(const VkPrimitiveTopology primitiveTopology, const bool primitiveRestartEnable)
@@ -146,10 +377,18 @@ void VKR::VkPipelineBuilder::SetTessellationState(const uint32_t numPatchControl
 
 void VKR::VkPipelineBuilder::SetViewportState(const uint32_t numViewports, const VkViewport* pViewports, const uint32_t numScissors, const VkRect2D* pScissors)
 {
+    //Viewports and Scissors may be nullptr when they are dynamic state.
+    m_Viewports.clear();
+    m_Scissors.clear();
+    if (pViewports != nullptr) {
+        m_Viewports.assign(pViewports, pViewports + numViewports);
+    }
+    if (pScissors != nullptr) {
+        m_Scissors.assign(pScissors, pScissors + numScissors);
+    }
     m_ViewportState.viewportCount = numViewports;
-    m_ViewportState.pViewports = pViewports;
     m_ViewportState.scissorCount = numScissors;
-    m_ViewportState.pScissors = pScissors;
+    UpdatePointers();
 }
 
 void VKR::VkPipelineBuilder::SetRasterizerState(const VkPolygonMode fillMode, const VkCullModeFlags cullMode, const VkFrontFace frontFace, const bool depthClampEnable, const bool discardEnable)
@@ -166,9 +405,13 @@ void VKR::VkPipelineBuilder::SetMSAAState(const VkSampleCountFlagBits sampleCoun
     m_MSAAState.rasterizationSamples = sampleCount;
     m_MSAAState.sampleShadingEnable = sampleShadingEnable;
     m_MSAAState.minSampleShading = minSampleShading;
-    m_MSAAState.pSampleMask = pSampleMask;
+    m_SampleMask.clear();
+    if (pSampleMask != nullptr) {
+        m_SampleMask.assign(pSampleMask, pSampleMask + ((sampleCount + 31) / 32));   //One word per 32 samples
+    }
     m_MSAAState.alphaToCoverageEnable = alphaToCoverageEnable;
     m_MSAAState.alphaToOneEnable = alphaToOneEnable;
+    UpdatePointers();
 }
 
 void VKR::VkPipelineBuilder::SetDepthStencilState(const bool depthEnable, const bool depthWriteEnable, const bool stencilEnable, const VkCompareOp compareOp)
@@ -183,13 +426,37 @@ void VKR::VkPipelineBuilder::SetBlendState(const bool logicOpEnable, const VkLog
 {
     m_BlendState.logicOpEnable = logicOpEnable;
     m_BlendState.logicOp = logicOp;
+    m_BlendAttachments.assign(pAttachments, pAttachments + numAttachments);
     m_BlendState.attachmentCount = numAttachments;
-    m_BlendState.pAttachments = pAttachments;
+    UpdatePointers();
 }
 
 void VKR::VkPipelineBuilder::SetDynamicState(const uint32_t numDynamicStates, const VkDynamicState* pDynamicStates)
 {
+    m_DynamicStates.assign(pDynamicStates, pDynamicStates + numDynamicStates);
     m_DynamicState.dynamicStateCount = numDynamicStates;
-    m_DynamicState.pDynamicStates = pDynamicStates;
+    UpdatePointers();
+}
+
+void VKR::VkPipelineBuilder::SetRenderingState(const uint32_t numColorFormats, const VkFormat* pColorFormats, const VkFormat depthFormat, const VkFormat stencilFormat, const uint32_t viewMask)
+{
+    m_ColorFormats.assign(pColorFormats, pColorFormats + numColorFormats);
+    m_RenderingState.viewMask = viewMask;
+    m_RenderingState.colorAttachmentCount = numColorFormats;
+    m_RenderingState.depthAttachmentFormat = depthFormat;
+    m_RenderingState.stencilAttachmentFormat = stencilFormat;
+    UpdatePointers();
+}
+
+void VKR::VkPipelineBuilder::UpdatePointers()
+{
+    m_VertexInputState.pVertexBindingDescriptions = m_VertexBindings.empty() ? nullptr : m_VertexBindings.data();
+    m_VertexInputState.pVertexAttributeDescriptions = m_VertexAttributes.empty() ? nullptr : m_VertexAttributes.data();
+    m_ViewportState.pViewports = m_Viewports.empty() ? nullptr : m_Viewports.data();
+    m_ViewportState.pScissors = m_Scissors.empty() ? nullptr : m_Scissors.data();
+    m_MSAAState.pSampleMask = m_SampleMask.empty() ? nullptr : m_SampleMask.data();
+    m_BlendState.pAttachments = m_BlendAttachments.empty() ? nullptr : m_BlendAttachments.data();
+    m_DynamicState.pDynamicStates = m_DynamicStates.empty() ? nullptr : m_DynamicStates.data();
+    m_RenderingState.pColorAttachmentFormats = m_ColorFormats.empty() ? nullptr : m_ColorFormats.data();
 }
 
@@ -0,0 +1,317 @@
+#include "../../include/VKR/Vulkan/VkPipelineCacheManager.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/File.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+VKR::VkPipelineCacheManager::VkPipelineCacheManager()
+{
+    m_Cache = VK_NULL_HANDLE;
+    m_CreationFeedback = false;
+    m_Statistics = {};
+}
+
+VkResult VKR::VkPipelineCacheManager::Create(const VkContext& context, const char* directory)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(context.GetPhysicalDevice(), &properties);
+
+    //Pipeline creation feedback is core in Vulkan 1.3, which both the instance and device must support, and otherwise provided by VK_EXT_pipeline_creation_feedback.
+    m_CreationFeedback = (context.GetAPIVersion() >= VK_API_VERSION_1_3 && properties.apiVersion >= VK_API_VERSION_1_3)
+        || context.IsDeviceExtensionEnabled(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+    m_Statistics = {};
+
+    //Each device gets its own file, so switching GPUs doesn't discard the other's cache.
+    char fileName[64] = {};
+    snprintf(fileName, sizeof(fileName), "PipelineCache_%04x_%04x.bin", properties.vendorID, properties.deviceID);
+    m_FilePath = std::string(directory) + "/" + fileName;
+
+    std::vector<char> blob;
+    if (IO::FileExists(m_FilePath.c_str())) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        IO::ReadFile(m_FilePath.c_str(), blob);
+
+        if (!ValidateHeader(context, blob)) {
+            Log::Warning("[Vulkan]\tPipeline Cache \"%s\" doesn't match this device or driver, and will be discarded.\n", m_FilePath.c_str());
+            blob.clear();
+        }
+        else {
+            const double loadTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            Log::Debug("[Vulkan]\tLoaded %llu byte Pipeline Cache \"%s\" in %fms.\n", static_cast<unsigned long long>(blob.size()), m_FilePath.c_str(), loadTime);
+        }
+    }
+
+    const VkPipelineCacheCreateInfo createInfo = {
+        VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        nullptr,
+        0,
+        blob.size(),
+        blob.empty() ? nullptr : blob.data()
+    };
+
+    VkResult result = vkCreatePipelineCache(context.GetDevice(), &createInfo, nullptr, &m_Cache);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Pipeline Cache!\n");
+        return result;
+    }
+
+    m_Statistics.loadedSize = blob.size();
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkPipelineCacheManager::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    for (auto& cache : m_WorkerCaches) {
+        vkDestroyPipelineCache(context.GetDevice(), cache, nullptr);
+    }
+    m_WorkerCaches.clear();
+
+    if (m_Cache != VK_NULL_HANDLE) {
+        vkDestroyPipelineCache(context.GetDevice(), m_Cache, nullptr);
+        m_Cache = VK_NULL_HANDLE;
+    }
+
+    Log::Debug("[Vulkan]\tPipeline Cache: %d hits (%fms), %d misses (%fms), %d unclassified (%fms).\n", m_Statistics.hits, m_Statistics.hitTime, m_Statistics.misses, m_Statistics.missTime, m_Statistics.unclassified, m_Statistics.unclassifiedTime);
+}
+
+VkResult VKR::VkPipelineCacheManager::Save(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    VkResult result = MergeWorkerCaches(context);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    size_t dataSize = 0;
+    result = vkGetPipelineCacheData(context.GetDevice(), m_Cache, &dataSize, nullptr);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Query Pipeline Cache size!\n");
+        return result;
+    }
+
+    std::vector<char> data(dataSize);
+    result = vkGetPipelineCacheData(context.GetDevice(), m_Cache, &dataSize, data.data());
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Retrieve Pipeline Cache data!\n");
+        return result;
+    }
+
+    //Write to a temporary file, then swap it in, so a crash mid-write can't truncate the existing cache.
+    const std::string tempPath = m_FilePath + ".tmp";
+    if (IO::WriteFile(tempPath.c_str(), data.data(), dataSize) != Status::SUCCESS) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+#ifdef _WIN32
+    //rename() won't replace an existing file on Windows, so replace it in a single call rather than removing it first.
+    const bool replaced = MoveFileExA(tempPath.c_str(), m_FilePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    const bool replaced = std::rename(tempPath.c_str(), m_FilePath.c_str()) == 0;
+#endif
+    if (!replaced) {
+        Log::Warning("[Vulkan]\tFailed to replace Pipeline Cache \"%s\".\n", m_FilePath.c_str());
+        std::remove(tempPath.c_str());
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    Log::Debug("[Vulkan]\tSaved %llu byte Pipeline Cache \"%s\".\n", static_cast<unsigned long long>(dataSize), m_FilePath.c_str());
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkPipelineCacheManager::CreateWorkerCache(const VkContext& context, VkPipelineCache* pCache)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //Seed the worker from the main cache, so pipelines compiled on workers still hit what was loaded from disk.
+    std::vector<char> data;
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(context.GetDevice(), m_Cache, &dataSize, nullptr) == VK_SUCCESS && dataSize > 0) {
+        data.resize(dataSize);
+        if (vkGetPipelineCacheData(context.GetDevice(), m_Cache, &dataSize, data.data()) != VK_SUCCESS) {
+            Log::Warning("[Vulkan]\tFailed to seed Worker Pipeline Cache, it will start empty.\n");
+            dataSize = 0;
+        }
+    }
+
+    const VkPipelineCacheCreateInfo createInfo = {
+        VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        nullptr,
+        0,
+        dataSize,
+        dataSize > 0 ? data.data() : nullptr
+    };
+
+    VkResult result = vkCreatePipelineCache(context.GetDevice(), &createInfo, nullptr, pCache);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Worker Pipeline Cache!\n");
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_WorkerCaches.push_back(*pCache);
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkPipelineCacheManager::MergeWorkerCaches(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (m_WorkerCaches.empty()) {
+        return VK_SUCCESS;
+    }
+
+    VkResult result = vkMergePipelineCaches(context.GetDevice(), m_Cache, static_cast<uint32_t>(m_WorkerCaches.size()), m_WorkerCaches.data());
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Merge Pipeline Caches!\n");
+        return result;
+    }
+
+    for (auto& cache : m_WorkerCaches) {
+        vkDestroyPipelineCache(context.GetDevice(), cache, nullptr);
+    }
+    m_WorkerCaches.clear();
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkPipelineCacheManager::CreateGraphicsPipelines(const VkContext& context, const uint32_t numPipelines, const VkGraphicsPipelineCreateInfo* pCreateInfos, VkPipeline* pPipelines, const VkPipelineCache cache)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //Chain creation feedback onto copies of the create infos, ahead of any existing extension structures.
+    std::vector<VkGraphicsPipelineCreateInfo> createInfos(pCreateInfos, pCreateInfos + numPipelines);
+    std::vector<VkPipelineCreationFeedback> feedback(numPipelines);
+    std::vector<VkPipelineCreationFeedbackCreateInfo> feedbackInfos(numPipelines);
+    if (m_CreationFeedback) {
+        for (uint32_t i = 0; i < numPipelines; i++) {
+            feedbackInfos[i] = { VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO, createInfos[i].pNext, &feedback[i], 0, nullptr };
+            createInfos[i].pNext = &feedbackInfos[i];
+        }
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    VkResult result = context.CreateGraphicsPipelines(numPipelines, createInfos.data(), cache != VK_NULL_HANDLE ? cache : m_Cache, pPipelines);
+    const double totalTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Graphics Pipelines!\n");
+        return result;
+    }
+
+    RecordTimings(numPipelines, m_CreationFeedback ? feedback.data() : nullptr, totalTime);
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkPipelineCacheManager::CreateComputePipelines(const VkContext& context, const uint32_t numPipelines, const VkComputePipelineCreateInfo* pCreateInfos, VkPipeline* pPipelines, const VkPipelineCache cache)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    std::vector<VkComputePipelineCreateInfo> createInfos(pCreateInfos, pCreateInfos + numPipelines);
+    std::vector<VkPipelineCreationFeedback> feedback(numPipelines);
+    std::vector<VkPipelineCreationFeedbackCreateInfo> feedbackInfos(numPipelines);
+    if (m_CreationFeedback) {
+        for (uint32_t i = 0; i < numPipelines; i++) {
+            feedbackInfos[i] = { VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO, createInfos[i].pNext, &feedback[i], 0, nullptr };
+            createInfos[i].pNext = &feedbackInfos[i];
+        }
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    VkResult result = context.CreateComputePipelines(numPipelines, createInfos.data(), cache != VK_NULL_HANDLE ? cache : m_Cache, pPipelines);
+    const double totalTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Compute Pipelines!\n");
+        return result;
+    }
+
+    RecordTimings(numPipelines, m_CreationFeedback ? feedback.data() : nullptr, totalTime);
+
+    return VK_SUCCESS;
+}
+
+const VkPipelineCache& VKR::VkPipelineCacheManager::GetPipelineCache() const
+{
+    return m_Cache;
+}
+
+const std::string& VKR::VkPipelineCacheManager::GetFilePath() const
+{
+    return m_FilePath;
+}
+
+VKR::VkPipelineCacheManager::Statistics VKR::VkPipelineCacheManager::GetStatistics()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Statistics;
+}
+
+bool VKR::VkPipelineCacheManager::ValidateHeader(const VkContext& context, const std::vector<char>& blob) const
+{
+    VkPipelineCacheHeaderVersionOne header = {};
+    if (blob.size() < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, blob.data(), sizeof(header));
+
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(context.GetPhysicalDevice(), &properties);
+
+    if (header.headerSize < sizeof(header) || header.headerSize > blob.size() || header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+        return false;
+    }
+
+    //The UUID changes with the driver version, so a driver update invalidates the cache too.
+    return header.vendorID == properties.vendorID
+        && header.deviceID == properties.deviceID
+        && memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+void VKR::VkPipelineCacheManager::RecordTimings(const uint32_t numPipelines, const VkPipelineCreationFeedback* pFeedback, const double totalTime)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (pFeedback == nullptr) {
+        m_Statistics.unclassified += numPipelines;
+        m_Statistics.unclassifiedTime += totalTime;
+        return;
+    }
+
+    for (uint32_t i = 0; i < numPipelines; i++) {
+        const VkPipelineCreationFeedback& feedback = pFeedback[i];
+        const double time = (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) ? feedback.duration / 1000000.0 : totalTime / numPipelines;
+
+        if (!(feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT)) {
+            m_Statistics.unclassified++;
+            m_Statistics.unclassifiedTime += time;
+        }
+        else if (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT) {
+            m_Statistics.hits++;
+            m_Statistics.hitTime += time;
+        }
+        else {
+            m_Statistics.misses++;
+            m_Statistics.missTime += time;
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#include "../../include/VKR/Vulkan/VkPipelineCompiler.h"
+#include "../../include/VKR/Vulkan/VkPipelineCacheManager.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <chrono>
+
+VKR::VkAsyncPipeline::VkAsyncPipeline(const std::shared_future<VkPipeline>& future) : m_Future(future)
+{
+}
+
+bool VKR::VkAsyncPipeline::IsReady() const
+{
+    return m_Future.valid() && m_Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+VkPipeline VKR::VkAsyncPipeline::Get() const
+{
+    return m_Future.valid() ? m_Future.get() : VK_NULL_HANDLE;
+}
+
+VkPipeline VKR::VkAsyncPipeline::GetOr(const VkPipeline placeholder) const
+{
+    if (!IsReady()) {
+        return placeholder;
+    }
+
+    const VkPipeline pipeline = m_Future.get();
+    return pipeline != VK_NULL_HANDLE ? pipeline : placeholder;
+}
+
+
+VKR::VkPipelineCompiler::VkPipelineCompiler()
+{
+    m_pCacheManager = nullptr;
+}
+
+VkResult VKR::VkPipelineCompiler::Create(const VkContext& context, VkPipelineCacheManager& cacheManager)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_pCacheManager = &cacheManager;
+
+    //A thread only compiles one Pipeline at a time, so a cache per thread needs no synchronization.
+    m_ThreadCaches.resize(Jobs::NumThreads(), VK_NULL_HANDLE);
+    for (auto& cache : m_ThreadCaches) {
+        VkResult result = cacheManager.CreateWorkerCache(context, &cache);
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Pipeline Compiler thread caches!\n");
+            return result;
+        }
+    }
+
+    Log::Debug("[Vulkan]\tCreated Pipeline Compiler with %d threads.\n", static_cast<uint32_t>(m_ThreadCaches.size()));
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkPipelineCompiler::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    WaitAll();
+    Collect();
+
+    //The manager owns the thread caches, and destroys them once merged.
+    if (m_pCacheManager != nullptr) {
+        m_pCacheManager->MergeWorkerCaches(context);
+    }
+
+    m_ThreadCaches.clear();
+    m_pCacheManager = nullptr;
+}
+
+VKR::VkAsyncPipeline VKR::VkPipelineCompiler::CompileGraphicsPipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout, const VkRenderPass renderPass, const uint32_t subpassIdx)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    std::unique_ptr<Request> request = std::make_unique<Request>();
+    request->builder = builder;
+    request->layout = layout;
+    request->renderPass = renderPass;
+    request->subpassIdx = subpassIdx;
+    request->compute = false;
+
+    return Enqueue(context, std::move(request));
+}
+
+VKR::VkAsyncPipeline VKR::VkPipelineCompiler::CompileComputePipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    std::unique_ptr<Request> request = std::make_unique<Request>();
+    request->builder = builder;
+    request->layout = layout;
+    request->renderPass = VK_NULL_HANDLE;
+    request->subpassIdx = 0;
+    request->compute = true;
+
+    return Enqueue(context, std::move(request));
+}
+
+void VKR::VkPipelineCompiler::WaitAll()
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    for (auto& request : m_Requests) {
+        if (request->job) {
+            Jobs::Wait(*request->job);
+        }
+    }
+}
+
+void VKR::VkPipelineCompiler::Collect()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    m_Requests.remove_if([](const std::unique_ptr<Request>& request) {
+        return !request->job || request->job->IsComplete();
+    });
+}
+
+const uint32_t VKR::VkPipelineCompiler::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    uint32_t count = 0;
+    for (const auto& request : m_Requests) {
+        if (request->job && !request->job->IsComplete()) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+VKR::VkAsyncPipeline VKR::VkPipelineCompiler::Enqueue(const VkContext& context, std::unique_ptr<Request> request)
+{
+    VkAsyncPipeline pipeline(request->promise.get_future().share());
+
+    //Without worker threads there's nothing to overlap with, so compile immediately.
+    if (Jobs::NumThreads() <= 1 || m_ThreadCaches.size() < Jobs::NumThreads()) {
+        Compile(context, *request, 0);
+        return pipeline;
+    }
+
+    //The Request lives in m_Requests until its Job completes, so the Job may safely reference it.
+    Request* pRequest = request.get();
+    const VkContext* pContext = &context;
+    request->job = std::make_unique<Job>([this, pContext, pRequest](uint32_t threadIndex) {
+        Compile(*pContext, *pRequest, threadIndex);
+    });
+
+    //Compiles can take milliseconds, so keep them from being picked up by threads waiting on frame-critical work.
+    request->job->SetPriority(EJobPriority::Low);
+
+    //An unsubmitted Job reports itself complete, so it's submitted under the lock, before Collect() can see it.
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Requests.push_back(std::move(request));
+        Jobs::Run(*pRequest->job);
+    }
+
+    return pipeline;
+}
+
+void VKR::VkPipelineCompiler::Compile(const VkContext& context, Request& request, const uint32_t threadIndex)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    const VkPipelineCache cache = m_ThreadCaches.empty() ? VK_NULL_HANDLE : m_ThreadCaches[threadIndex];
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkResult result = VK_SUCCESS;
+    if (request.compute) {
+        const VkComputePipelineCreateInfo createInfo = request.builder.BuildComputePipeline(request.layout);
+        result = m_pCacheManager->CreateComputePipelines(context, 1, &createInfo, &pipeline, cache);
+    }
+    else {
+        const VkGraphicsPipelineCreateInfo createInfo = request.builder.BuildGraphicsPipeline(request.layout, request.renderPass, request.subpassIdx);
+        result = m_pCacheManager->CreateGraphicsPipelines(context, 1, &createInfo, &pipeline, cache);
+    }
+
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Compile Pipeline on thread %d!\n", threadIndex);
+        pipeline = VK_NULL_HANDLE;
+    }
+
+    request.promise.set_value(pipeline);
+}
@@ -0,0 +1,147 @@
+#include "../../include/VKR/Vulkan/VkPipelineRegistry.h"
+#include "../../include/VKR/Vulkan/VkPipelineCacheManager.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <future>
+
+//Wraps an already created Pipeline, so synchronous and asynchronous entries share a type.
+static VKR::VkAsyncPipeline MakeReadyPipeline(const VkPipeline pipeline)
+{
+    std::promise<VkPipeline> promise;
+    promise.set_value(pipeline);
+    return VKR::VkAsyncPipeline(promise.get_future().share());
+}
+
+VKR::VkPipelineRegistry::VkPipelineRegistry()
+{
+    m_Hits = 0;
+    m_pCacheManager = nullptr;
+    m_pCompiler = nullptr;
+}
+
+VkResult VKR::VkPipelineRegistry::Create(const VkContext& context, VkPipelineCacheManager& cacheManager, VkPipelineCompiler* pCompiler)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_pCacheManager = &cacheManager;
+    m_pCompiler = pCompiler;
+    m_Hits = 0;
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkPipelineRegistry::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    for (auto& entry : m_Pipelines) {
+        VkPipeline pipeline = entry.second.Get();   //Blocks until compiled
+        if (pipeline != VK_NULL_HANDLE) {
+            context.DestroyPipeline(pipeline);
+        }
+    }
+
+    Log::Debug("[Vulkan]\tDestroyed Pipeline Registry. (%d Pipelines, %llu duplicate requests)\n", static_cast<uint32_t>(m_Pipelines.size()), static_cast<unsigned long long>(m_Hits));
+
+    m_Pipelines.clear();
+}
+
+VKR::VkAsyncPipeline VKR::VkPipelineRegistry::GetGraphicsPipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout, const VkRenderPass renderPass, const uint32_t subpassIdx)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    VkPipelineKey key = builder.BuildGraphicsPipelineKey(layout, renderPass, subpassIdx);
+
+    //The lock is held across creation, so concurrent requests for the same key can't both compile it.
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_Pipelines.find(key);
+    if (it != m_Pipelines.end()) {
+        //Compiles which failed asynchronously are dropped here, and retried.
+        if (!it->second.IsReady() || it->second.Get() != VK_NULL_HANDLE) {
+            m_Hits++;
+            return it->second;
+        }
+        m_Pipelines.erase(it);
+    }
+
+    VkAsyncPipeline pipeline;
+    if (m_pCompiler != nullptr) {
+        pipeline = m_pCompiler->CompileGraphicsPipeline(context, builder, layout, renderPass, subpassIdx);
+    }
+    else {
+        const VkGraphicsPipelineCreateInfo createInfo = builder.BuildGraphicsPipeline(layout, renderPass, subpassIdx);
+        VkPipeline handle = VK_NULL_HANDLE;
+        const VkResult result = m_pCacheManager->CreateGraphicsPipelines(context, 1, &createInfo, &handle);
+        if (result != VK_SUCCESS) {
+            //Nothing is registered, so a later request can retry.
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to register Graphics Pipeline! (Error %d)\n", result);
+            return {};
+        }
+        pipeline = MakeReadyPipeline(handle);
+    }
+
+    m_Pipelines.emplace(std::move(key), pipeline);
+
+    return pipeline;
+}
+
+VKR::VkAsyncPipeline VKR::VkPipelineRegistry::GetComputePipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    VkPipelineKey key = builder.BuildComputePipelineKey(layout);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_Pipelines.find(key);
+    if (it != m_Pipelines.end()) {
+        //Compiles which failed asynchronously are dropped here, and retried.
+        if (!it->second.IsReady() || it->second.Get() != VK_NULL_HANDLE) {
+            m_Hits++;
+            return it->second;
+        }
+        m_Pipelines.erase(it);
+    }
+
+    VkAsyncPipeline pipeline;
+    if (m_pCompiler != nullptr) {
+        pipeline = m_pCompiler->CompileComputePipeline(context, builder, layout);
+    }
+    else {
+        const VkComputePipelineCreateInfo createInfo = builder.BuildComputePipeline(layout);
+        VkPipeline handle = VK_NULL_HANDLE;
+        const VkResult result = m_pCacheManager->CreateComputePipelines(context, 1, &createInfo, &handle);
+        if (result != VK_SUCCESS) {
+            //Nothing is registered, so a later request can retry.
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to register Compute Pipeline! (Error %d)\n", result);
+            return {};
+        }
+        pipeline = MakeReadyPipeline(handle);
+    }
+
+    m_Pipelines.emplace(std::move(key), pipeline);
+
+    return pipeline;
+}
+
+bool VKR::VkPipelineRegistry::Contains(const VkPipelineKey& key)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Pipelines.find(key);
+    return it != m_Pipelines.end() && (!it->second.IsReady() || it->second.Get() != VK_NULL_HANDLE);
+}
+
+const uint32_t VKR::VkPipelineRegistry::GetPipelineCount()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return static_cast<uint32_t>(m_Pipelines.size());
+}
+
+const uint64_t VKR::VkPipelineRegistry::GetHitCount() const
+{
+    return m_Hits;
+}
@@ -0,0 +1,738 @@
+#include "../../include/VKR/Vulkan/VkRenderGraph.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Vulkan/VkInit.h"
+#include "../../include/VKR/Vulkan/VkDeletionQueue.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <algorithm>
+
+//Only write accesses need making available; listing reads in a source access mask does nothing.
+static constexpr VkAccessFlags2 WRITE_ACCESS_MASK = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_HOST_WRITE_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+static VkImageAspectFlags FormatAspect(const VkFormat format)
+{
+    switch (format) {
+    case VK_FORMAT_D16_UNORM:
+    case VK_FORMAT_X8_D24_UNORM_PACK32:
+    case VK_FORMAT_D32_SFLOAT:
+        return VK_IMAGE_ASPECT_DEPTH_BIT;
+    case VK_FORMAT_S8_UINT:
+        return VK_IMAGE_ASPECT_STENCIL_BIT;
+    case VK_FORMAT_D16_UNORM_S8_UINT:
+    case VK_FORMAT_D24_UNORM_S8_UINT:
+    case VK_FORMAT_D32_SFLOAT_S8_UINT:
+        return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+    default:
+        return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+//Stages, access and layout of a usage, plus the image usage it requires. Returns false if the usage can't be written.
+static bool GetUsageInfo(const VKR::ERenderGraphUsage usage, const bool write, VkPipelineStageFlags2* pStages, VkAccessFlags2* pAccess, VkImageLayout* pLayout, VkImageUsageFlags* pImageUsage)
+{
+    switch (usage) {
+    case VKR::ERenderGraphUsage::ColorAttachment:
+        //Loading and blending read the attachment, even when it's written.
+        *pStages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+        *pAccess = write ? VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT : VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT;
+        *pLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        *pImageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        return true;
+    case VKR::ERenderGraphUsage::DepthStencilAttachment:
+        //Depth testing reads the attachment, even when it's written.
+        *pStages = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+        *pAccess = write ? VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+        *pLayout = write ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        *pImageUsage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        return true;
+    case VKR::ERenderGraphUsage::SampledFragment:
+    case VKR::ERenderGraphUsage::SampledCompute:
+        *pStages = usage == VKR::ERenderGraphUsage::SampledFragment ? VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT : VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        *pAccess = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+        *pLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        *pImageUsage = VK_IMAGE_USAGE_SAMPLED_BIT;
+        return !write;
+    case VKR::ERenderGraphUsage::StorageFragment:
+    case VKR::ERenderGraphUsage::StorageCompute:
+        *pStages = usage == VKR::ERenderGraphUsage::StorageFragment ? VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT : VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        *pAccess = write ? VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT : VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+        *pLayout = VK_IMAGE_LAYOUT_GENERAL;
+        *pImageUsage = VK_IMAGE_USAGE_STORAGE_BIT;
+        return true;
+    case VKR::ERenderGraphUsage::Transfer:
+        *pStages = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT;
+        *pAccess = write ? VK_ACCESS_2_TRANSFER_WRITE_BIT : VK_ACCESS_2_TRANSFER_READ_BIT;
+        *pLayout = write ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        *pImageUsage = write ? VK_IMAGE_USAGE_TRANSFER_DST_BIT : VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        return true;
+    case VKR::ERenderGraphUsage::VertexInput:
+        *pStages = VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
+        *pAccess = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT;
+        *pLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        *pImageUsage = 0;
+        return !write;
+    case VKR::ERenderGraphUsage::Indirect:
+        *pStages = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+        *pAccess = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+        *pLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        *pImageUsage = 0;
+        return !write;
+    default:
+        return false;
+    }
+}
+
+VKR::VkRenderGraph::VkRenderGraph()
+{
+    m_NumCulledPasses = 0;
+    m_NumBarriers = 0;
+    m_TransientMemorySize = 0;
+    m_UnaliasedMemorySize = 0;
+    m_LazyMemorySize = 0;
+    m_Compiled = false;
+}
+
+VKR::VkRenderGraph::ResourceHandle VKR::VkRenderGraph::ImportImage(const char* name, const VkExtent2D extent, const VkFormat format, const VkImageLayout initialLayout, const VkPipelineStageFlags2 initialStages, const VkImageLayout finalLayout)
+{
+    Resource resource = {};
+    resource.name = name;
+    resource.imported = true;
+    resource.isBuffer = false;
+    resource.extent = extent;
+    resource.format = format;
+    resource.aspect = FormatAspect(format);
+    resource.samples = VK_SAMPLE_COUNT_1_BIT;
+    resource.initialLayout = initialLayout;
+    resource.initialStages = initialStages;
+    resource.finalLayout = finalLayout;
+    resource.memorySlot = INVALID_HANDLE;
+
+    m_Resources.push_back(resource);
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+VKR::VkRenderGraph::ResourceHandle VKR::VkRenderGraph::ImportBuffer(const char* name, const VkPipelineStageFlags2 initialStages)
+{
+    Resource resource = {};
+    resource.name = name;
+    resource.imported = true;
+    resource.isBuffer = true;
+    resource.format = VK_FORMAT_UNDEFINED;
+    resource.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    resource.initialStages = initialStages;
+    resource.finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    resource.memorySlot = INVALID_HANDLE;
+
+    m_Resources.push_back(resource);
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+void VKR::VkRenderGraph::SetImportedImage(const ResourceHandle resource, const VkImage image, const VkImageView view)
+{
+    m_Resources[resource].image = image;
+    m_Resources[resource].view = view;
+}
+
+void VKR::VkRenderGraph::SetImportedBuffer(const ResourceHandle resource, const VkBuffer buffer)
+{
+    m_Resources[resource].buffer = buffer;
+}
+
+VKR::VkRenderGraph::ResourceHandle VKR::VkRenderGraph::CreateImage(const char* name, const VkExtent2D extent, const VkFormat format, const VkSampleCountFlagBits samples, const VkImageUsageFlags usage)
+{
+    Resource resource = {};
+    resource.name = name;
+    resource.imported = false;
+    resource.isBuffer = false;
+    resource.extent = extent;
+    resource.format = format;
+    resource.aspect = FormatAspect(format);
+    resource.samples = samples;
+    resource.usage = usage;
+    resource.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    resource.finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    resource.memorySlot = INVALID_HANDLE;
+
+    m_Resources.push_back(resource);
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+void VKR::VkRenderGraph::SetImageExtent(const ResourceHandle resource, const VkExtent2D extent)
+{
+    m_Resources[resource].extent = extent;
+}
+
+VKR::VkRenderGraph::PassHandle VKR::VkRenderGraph::AddPass(const char* name, const ExecuteFunc& func, const VkRenderingFlags renderingFlags)
+{
+    Pass pass = {};
+    pass.name = name;
+    pass.func = func;
+    pass.renderingFlags = renderingFlags;
+    pass.hasDepthAttachment = false;
+    pass.readOnlyDepth = false;
+    pass.sideEffects = false;
+    pass.culled = false;
+
+    m_Passes.push_back(pass);
+    return static_cast<PassHandle>(m_Passes.size() - 1);
+}
+
+void VKR::VkRenderGraph::AddColorAttachment(const PassHandle pass, const ResourceHandle resource, const VkAttachmentLoadOp loadOp, const VkAttachmentStoreOp storeOp, const VkClearValue clearValue, const ResourceHandle resolveTarget)
+{
+    AddAccess(pass, resource, ERenderGraphUsage::ColorAttachment, loadOp == VK_ATTACHMENT_LOAD_OP_LOAD, true);
+    if (resolveTarget != INVALID_HANDLE) {
+        AddAccess(pass, resolveTarget, ERenderGraphUsage::ColorAttachment, false, true);
+    }
+
+    m_Passes[pass].colorAttachments.push_back({ resource, loadOp, storeOp, clearValue, resolveTarget });
+}
+
+void VKR::VkRenderGraph::SetDepthAttachment(const PassHandle pass, const ResourceHandle resource, const VkAttachmentLoadOp loadOp, const VkAttachmentStoreOp storeOp, const VkClearValue clearValue, const bool readOnly)
+{
+    AddAccess(pass, resource, ERenderGraphUsage::DepthStencilAttachment, readOnly || loadOp == VK_ATTACHMENT_LOAD_OP_LOAD, !readOnly);
+
+    m_Passes[pass].depthAttachment = { resource, loadOp, storeOp, clearValue, INVALID_HANDLE };
+    m_Passes[pass].hasDepthAttachment = true;
+    m_Passes[pass].readOnlyDepth = readOnly;
+}
+
+void VKR::VkRenderGraph::Read(const PassHandle pass, const ResourceHandle resource, const ERenderGraphUsage usage)
+{
+    AddAccess(pass, resource, usage, true, false);
+}
+
+void VKR::VkRenderGraph::Write(const PassHandle pass, const ResourceHandle resource, const ERenderGraphUsage usage)
+{
+    AddAccess(pass, resource, usage, false, true);
+}
+
+void VKR::VkRenderGraph::SetSideEffects(const PassHandle pass)
+{
+    m_Passes[pass].sideEffects = true;
+}
+
+void VKR::VkRenderGraph::AddAccess(const PassHandle pass, const ResourceHandle resource, const ERenderGraphUsage usage, const bool read, const bool write)
+{
+    if (pass >= m_Passes.size() || resource >= m_Resources.size()) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tInvalid Render Graph handle! (Pass %d, Resource %d)\n", pass, resource);
+        return;
+    }
+
+    Resource& res = m_Resources[resource];
+
+    VkPipelineStageFlags2 stages = 0;
+    VkAccessFlags2 access = 0;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkImageUsageFlags imageUsage = 0;
+    if (!GetUsageInfo(usage, write, &stages, &access, &layout, &imageUsage)) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tPass \"%s\" can't write to \"%s\" with usage %d!\n", m_Passes[pass].name.c_str(), res.name.c_str(), static_cast<int>(usage));
+        return;
+    }
+
+    if (res.isBuffer) {
+        layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+    else {
+        res.usage |= imageUsage;
+    }
+
+    //A pass's accesses to the same resource are merged, so it's synchronized with a single barrier. Writes take precedence over read only layouts.
+    for (auto& existing : m_Passes[pass].accesses) {
+        if (existing.resource == resource) {
+            if (write || !existing.write) {
+                existing.layout = layout;
+            }
+            existing.stages |= stages;
+            existing.access |= access;
+            existing.read |= read;
+            existing.write |= write;
+            return;
+        }
+    }
+
+    m_Passes[pass].accesses.push_back({ resource, stages, access, layout, read, write });
+}
+
+void VKR::VkRenderGraph::CullPasses()
+{
+    //Imported resources are the graph's outputs. Walking backwards, a pass is live if it writes a live resource, and the resources it reads become live.
+    std::vector<bool> live(m_Resources.size(), false);
+    for (size_t i = 0; i < m_Resources.size(); i++) {
+        live[i] = m_Resources[i].imported;
+    }
+
+    m_NumCulledPasses = 0;
+    for (size_t i = m_Passes.size(); i-- > 0;) {
+        Pass& pass = m_Passes[i];
+
+        pass.culled = !pass.sideEffects;
+        for (const auto& access : pass.accesses) {
+            if (access.write && live[access.resource]) {
+                pass.culled = false;
+                break;
+            }
+        }
+
+        if (pass.culled) {
+            m_NumCulledPasses++;
+            continue;
+        }
+
+        for (const auto& access : pass.accesses) {
+            if (access.read) {
+                live[access.resource] = true;
+            }
+        }
+    }
+}
+
+bool VKR::VkRenderGraph::IsLazy(const ResourceHandle resource) const
+{
+    //The contents must never leave a single render pass instance, so the image can live entirely in tile memory.
+    const Resource& res = m_Resources[resource];
+    if (res.imported || res.firstPass != res.lastPass) {
+        return false;
+    }
+
+    constexpr VkImageUsageFlags attachmentUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+    if ((res.usage & ~attachmentUsage) != 0) {
+        return false;
+    }
+
+    const Pass& pass = m_Passes[res.firstPass];
+    for (const auto& attachment : pass.colorAttachments) {
+        if (attachment.resolveTarget == resource) {
+            return false;
+        }
+        if (attachment.resource == resource && (attachment.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD || attachment.storeOp != VK_ATTACHMENT_STORE_OP_DONT_CARE)) {
+            return false;
+        }
+    }
+
+    if (pass.hasDepthAttachment && pass.depthAttachment.resource == resource) {
+        const Attachment& attachment = pass.depthAttachment;
+        if (attachment.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD || attachment.storeOp != VK_ATTACHMENT_STORE_OP_DONT_CARE) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+VkResult VKR::VkRenderGraph::CreateTransients(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //Each transient lives from the first to the last surviving pass which accesses it.
+    for (auto& resource : m_Resources) {
+        resource.firstPass = INVALID_HANDLE;
+        resource.lastPass = 0;
+    }
+
+    for (uint32_t i = 0; i < m_Passes.size(); i++) {
+        if (m_Passes[i].culled) {
+            continue;
+        }
+        for (const auto& access : m_Passes[i].accesses) {
+            Resource& resource = m_Resources[access.resource];
+            resource.firstPass = std::min(resource.firstPass, i);
+            resource.lastPass = std::max(resource.lastPass, i);
+        }
+    }
+
+    std::vector<ResourceHandle> transients;
+    m_UnaliasedMemorySize = 0;
+    for (uint32_t i = 0; i < m_Resources.size(); i++) {
+        Resource& resource = m_Resources[i];
+        if (resource.imported || resource.firstPass == INVALID_HANDLE) {
+            continue;
+        }
+
+        //Images are created without memory, and bound into a slot once their requirements are known.
+        resource.lazy = IsLazy(i);
+        const VkImageUsageFlags usage = resource.usage | (resource.lazy ? VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT : 0);
+        VkResult result = context.CreateImage(VK_IMAGE_TYPE_2D, { resource.extent.width, resource.extent.height, 1 }, resource.samples, resource.format, VK_IMAGE_TILING_OPTIMAL, usage, &resource.image);
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create transient Image \"%s\"!\n", resource.name.c_str());
+            return result;
+        }
+
+        vkGetImageMemoryRequirements(context.GetDevice(), resource.image, &resource.memoryRequirements);
+        m_UnaliasedMemorySize += resource.memoryRequirements.size;
+        transients.push_back(i);
+    }
+
+    //Greedily pack the largest transients first, into the first slot with compatible memory whose resources' lifetimes don't overlap.
+    std::sort(transients.begin(), transients.end(), [&](const ResourceHandle a, const ResourceHandle b) {
+        return m_Resources[a].memoryRequirements.size > m_Resources[b].memoryRequirements.size;
+    });
+
+    for (const ResourceHandle handle : transients) {
+        Resource& resource = m_Resources[handle];
+
+        uint32_t slotIdx = INVALID_HANDLE;
+        for (uint32_t s = 0; s < m_MemorySlots.size() && slotIdx == INVALID_HANDLE; s++) {
+            const MemorySlot& slot = m_MemorySlots[s];
+            if (slot.lazy != resource.lazy || (slot.requirements.memoryTypeBits & resource.memoryRequirements.memoryTypeBits) == 0) {
+                continue;
+            }
+
+            bool disjoint = true;
+            for (const ResourceHandle other : slot.resources) {
+                if (resource.firstPass <= m_Resources[other].lastPass && m_Resources[other].firstPass <= resource.lastPass) {
+                    disjoint = false;
+                    break;
+                }
+            }
+
+            if (disjoint) {
+                slotIdx = s;
+            }
+        }
+
+        if (slotIdx == INVALID_HANDLE) {
+            MemorySlot slot = {};
+            slot.requirements = resource.memoryRequirements;
+            slot.lazy = resource.lazy;
+            m_MemorySlots.push_back(slot);
+            slotIdx = static_cast<uint32_t>(m_MemorySlots.size() - 1);
+        }
+        else {
+            VkMemoryRequirements& requirements = m_MemorySlots[slotIdx].requirements;
+            requirements.size = std::max(requirements.size, resource.memoryRequirements.size);
+            requirements.alignment = std::max(requirements.alignment, resource.memoryRequirements.alignment);
+            requirements.memoryTypeBits &= resource.memoryRequirements.memoryTypeBits;
+        }
+
+        m_MemorySlots[slotIdx].resources.push_back(handle);
+        resource.memorySlot = slotIdx;
+    }
+
+    m_TransientMemorySize = 0;
+    m_LazyMemorySize = 0;
+    for (auto& slot : m_MemorySlots) {
+        VkResult result = VK_ERROR_FEATURE_NOT_PRESENT;
+        if (slot.lazy) {
+            result = context.AllocateMemory(slot.requirements, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT, &slot.allocation);
+            if (result == VK_SUCCESS) {
+                m_LazyMemorySize += slot.requirements.size;
+            }
+        }
+
+        //Devices without lazily allocated memory back transient attachments with regular device-local memory.
+        if (result != VK_SUCCESS) {
+            result = context.AllocateMemory(slot.requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &slot.allocation);
+        }
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to allocate %llu bytes for transient Images!\n", static_cast<unsigned long long>(slot.requirements.size));
+            return result;
+        }
+        m_TransientMemorySize += slot.requirements.size;
+
+        for (const ResourceHandle handle : slot.resources) {
+            Resource& resource = m_Resources[handle];
+            result = context.BindImageMemory(slot.allocation, 0, resource.image);
+            if (result == VK_SUCCESS) {
+                result = context.CreateImageView(resource.image, resource.format, resource.aspect, &resource.view);
+            }
+            if (result != VK_SUCCESS) {
+                Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to bind transient Image \"%s\"!\n", resource.name.c_str());
+                return result;
+            }
+        }
+    }
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkRenderGraph::DestroyTransients(const VkContext& context, VkDeletionQueue* pDeletionQueue, const uint64_t retireValue)
+{
+    std::vector<VkImageView> views;
+    std::vector<VkImage> images;
+    std::vector<VmaAllocation> allocations;
+
+    for (auto& resource : m_Resources) {
+        if (resource.imported) {
+            continue;
+        }
+        if (resource.view != VK_NULL_HANDLE) {
+            views.push_back(resource.view);
+            resource.view = VK_NULL_HANDLE;
+        }
+        if (resource.image != VK_NULL_HANDLE) {
+            images.push_back(resource.image);
+            resource.image = VK_NULL_HANDLE;
+        }
+        resource.memorySlot = INVALID_HANDLE;
+    }
+
+    for (auto& slot : m_MemorySlots) {
+        if (slot.allocation != VK_NULL_HANDLE) {
+            allocations.push_back(slot.allocation);
+        }
+    }
+    m_MemorySlots.clear();
+
+    m_TransientMemorySize = 0;
+    m_UnaliasedMemorySize = 0;
+    m_LazyMemorySize = 0;
+
+    auto destroy = [views, images, allocations](const VkContext& ctx) mutable {
+        for (auto& view : views) {
+            ctx.DestroyImageView(view);
+        }
+        for (auto& image : images) {
+            ctx.DestroyImage(image);
+        }
+        for (auto& allocation : allocations) {
+            ctx.FreeMemory(allocation);
+        }
+    };
+
+    //Retired transients may still be in use by frames in flight.
+    if (pDeletionQueue != nullptr) {
+        pDeletionQueue->Push(retireValue, std::move(destroy));
+    }
+    else {
+        destroy(context);
+    }
+}
+
+VkResult VKR::VkRenderGraph::Compile(const VkContext& context, VkDeletionQueue* pDeletionQueue, const uint64_t retireValue)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (m_Compiled) {
+        DestroyTransients(context, pDeletionQueue, retireValue);
+        m_Compiled = false;
+    }
+
+    CullPasses();
+
+    VkResult result = CreateTransients(context);
+    if (result != VK_SUCCESS) {
+        DestroyTransients(context);
+        return result;
+    }
+
+    for (auto& resource : m_Resources) {
+        resource.state = {};
+    }
+
+    m_Compiled = true;
+
+    Log::Debug("[Vulkan]\tCompiled Render Graph. (%d Passes, %d culled, %d Memory Slots, %llu bytes of transients, %llu unaliased, %llu lazily allocated)\n", static_cast<uint32_t>(m_Passes.size()), m_NumCulledPasses, static_cast<uint32_t>(m_MemorySlots.size()), static_cast<unsigned long long>(m_TransientMemorySize), static_cast<unsigned long long>(m_UnaliasedMemorySize), static_cast<unsigned long long>(m_LazyMemorySize));
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkRenderGraph::RecordBarrier(Resource& resource, const Access& access, std::vector<VkImageMemoryBarrier2>& imageBarriers, std::vector<VkBufferMemoryBarrier2>& bufferBarriers)
+{
+    State& state = resource.state;
+
+    //A transient's contents don't survive between frames, but its memory may have been used by another transient since, which must complete first.
+    if (!resource.imported && !resource.used) {
+        const MemorySlot& slot = m_MemorySlots[resource.memorySlot];
+        state = { VK_IMAGE_LAYOUT_UNDEFINED, slot.lastStages, slot.lastWriteAccess, 0, 0, 0 };
+    }
+    resource.used = true;
+
+    const VkImageLayout oldLayout = state.layout;
+    const bool layoutChange = !resource.isBuffer && oldLayout != access.layout;
+
+    VkPipelineStageFlags2 srcStages = 0;
+    VkAccessFlags2 srcAccess = 0;
+    bool barrier = false;
+
+    if (layoutChange || access.write) {
+        //Write-after-read and write-after-write hazards, or a layout transition, which must wait on every prior access.
+        srcStages = state.writeStages | state.readStages;
+        srcAccess = state.writeAccess;
+        barrier = layoutChange || srcStages != 0;
+
+        if (access.write) {
+            state = { access.layout, access.stages, access.access & WRITE_ACCESS_MASK, 0, 0, 0 };
+        }
+        else {
+            //Transitions are writes, made visible to this access by the barrier itself.
+            state = { access.layout, access.stages, 0, access.stages, access.stages, access.access };
+        }
+    }
+    else {
+        //Read-after-write hazards only need a barrier the first time each stage and access reads the write.
+        if (state.writeStages != 0 && ((access.stages & ~state.visibleStages) != 0 || (access.access & ~state.visibleAccess) != 0)) {
+            srcStages = state.writeStages;
+            srcAccess = state.writeAccess;
+            barrier = true;
+
+            state.visibleStages |= access.stages;
+            state.visibleAccess |= access.access;
+        }
+        state.readStages |= access.stages;
+    }
+
+    if (!resource.imported) {
+        MemorySlot& slot = m_MemorySlots[resource.memorySlot];
+        slot.lastStages = state.writeStages | state.readStages;
+        slot.lastWriteAccess = state.writeAccess;
+    }
+
+    if (!barrier) {
+        return;
+    }
+
+    if (resource.isBuffer) {
+        bufferBarriers.push_back(VkInit::MakeBufferMemoryBarrier2(resource.buffer, srcStages, srcAccess, access.stages, access.access));
+    }
+    else {
+        imageBarriers.push_back(VkInit::MakeImageMemoryBarrier2(resource.image, resource.aspect, oldLayout, access.layout, srcStages, srcAccess, access.stages, access.access));
+    }
+}
+
+void VKR::VkRenderGraph::RecordPass(const VkContext& context, const VkCommandBuffer commandBuffer, const Pass& pass)
+{
+    if (pass.colorAttachments.empty() && !pass.hasDepthAttachment) {
+        pass.func(commandBuffer);
+        return;
+    }
+
+    m_ColorAttachmentInfos.clear();
+    for (const auto& attachment : pass.colorAttachments) {
+        const VkImageView view = m_Resources[attachment.resource].view;
+        if (attachment.resolveTarget != INVALID_HANDLE) {
+            m_ColorAttachmentInfos.push_back(VkInit::MakeRenderingAttachmentInfo(view, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, attachment.loadOp, attachment.storeOp, attachment.clearValue, VK_RESOLVE_MODE_AVERAGE_BIT, m_Resources[attachment.resolveTarget].view, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL));
+        }
+        else {
+            m_ColorAttachmentInfos.push_back(VkInit::MakeRenderingAttachmentInfo(view, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, attachment.loadOp, attachment.storeOp, attachment.clearValue));
+        }
+    }
+
+    VkRenderingAttachmentInfo depthAttachment = {};
+    if (pass.hasDepthAttachment) {
+        const Attachment& attachment = pass.depthAttachment;
+        const VkImageLayout layout = pass.readOnlyDepth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment = VkInit::MakeRenderingAttachmentInfo(m_Resources[attachment.resource].view, layout, attachment.loadOp, attachment.storeOp, attachment.clearValue);
+    }
+
+    //Every attachment must be at least as large as the render area, so the first one's extent is used.
+    const ResourceHandle first = pass.colorAttachments.empty() ? pass.depthAttachment.resource : pass.colorAttachments[0].resource;
+    const VkRect2D renderArea = { { 0, 0 }, m_Resources[first].extent };
+
+    const VkRenderingInfo renderingInfo = VkInit::MakeRenderingInfo(renderArea, static_cast<uint32_t>(m_ColorAttachmentInfos.size()), m_ColorAttachmentInfos.data(), pass.hasDepthAttachment ? &depthAttachment : nullptr, nullptr, pass.renderingFlags);
+
+    context.CmdBeginRendering(commandBuffer, &renderingInfo);
+    pass.func(commandBuffer);
+    context.CmdEndRendering(commandBuffer);
+}
+
+void VKR::VkRenderGraph::Execute(const VkContext& context, const VkCommandBuffer commandBuffer)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (!m_Compiled) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tRender Graph must be compiled before it's executed!\n");
+        return;
+    }
+
+    //Imported resources start each frame in their declared state. Transients pick up from their memory slot's last use.
+    for (auto& resource : m_Resources) {
+        if (resource.imported) {
+            resource.state = { resource.initialLayout, resource.initialStages, 0, 0, 0, 0 };
+        }
+        resource.used = false;
+    }
+
+    m_NumBarriers = 0;
+    for (const auto& pass : m_Passes) {
+        if (pass.culled) {
+            continue;
+        }
+
+        //Every hazard the pass introduces is resolved in a single batch.
+        m_ImageBarriers.clear();
+        m_BufferBarriers.clear();
+        for (const auto& access : pass.accesses) {
+            RecordBarrier(m_Resources[access.resource], access, m_ImageBarriers, m_BufferBarriers);
+        }
+
+        if (!m_ImageBarriers.empty() || !m_BufferBarriers.empty()) {
+            const VkDependencyInfo dependencyInfo = VkInit::MakeDependencyInfo(static_cast<uint32_t>(m_ImageBarriers.size()), m_ImageBarriers.data(), static_cast<uint32_t>(m_BufferBarriers.size()), m_BufferBarriers.data());
+            context.CmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+            m_NumBarriers += static_cast<uint32_t>(m_ImageBarriers.size() + m_BufferBarriers.size());
+        }
+
+        RecordPass(context, commandBuffer, pass);
+    }
+
+    //Leave imported images in their final layouts, e.g. for presentation. Subsequent work is synchronized externally, so there's no destination scope.
+    m_ImageBarriers.clear();
+    for (auto& resource : m_Resources) {
+        if (!resource.imported || resource.isBuffer || resource.image == VK_NULL_HANDLE || resource.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED || resource.state.layout == resource.finalLayout) {
+            continue;
+        }
+
+        const State& state = resource.state;
+        m_ImageBarriers.push_back(VkInit::MakeImageMemoryBarrier2(resource.image, resource.aspect, state.layout, resource.finalLayout, state.writeStages | state.readStages, state.writeAccess, VK_PIPELINE_STAGE_2_NONE, 0));
+        resource.state.layout = resource.finalLayout;
+    }
+
+    if (!m_ImageBarriers.empty()) {
+        const VkDependencyInfo dependencyInfo = VkInit::MakeDependencyInfo(static_cast<uint32_t>(m_ImageBarriers.size()), m_ImageBarriers.data());
+        context.CmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+        m_NumBarriers += static_cast<uint32_t>(m_ImageBarriers.size());
+    }
+}
+
+void VKR::VkRenderGraph::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    DestroyTransients(context);
+
+    m_Passes.clear();
+    m_Resources.clear();
+    m_NumCulledPasses = 0;
+    m_NumBarriers = 0;
+    m_Compiled = false;
+}
+
+const VkImage VKR::VkRenderGraph::GetImage(const ResourceHandle resource) const
+{
+    return m_Resources[resource].image;
+}
+
+const VkImageView VKR::VkRenderGraph::GetImageView(const ResourceHandle resource) const
+{
+    return m_Resources[resource].view;
+}
+
+const uint32_t VKR::VkRenderGraph::GetPassCount() const
+{
+    return static_cast<uint32_t>(m_Passes.size());
+}
+
+const uint32_t VKR::VkRenderGraph::GetCulledPassCount() const
+{
+    return m_NumCulledPasses;
+}
+
+const uint32_t VKR::VkRenderGraph::GetBarrierCount() const
+{
+    return m_NumBarriers;
+}
+
+const VkDeviceSize VKR::VkRenderGraph::GetTransientMemorySize() const
+{
+    return m_TransientMemorySize;
+}
+
+const VkDeviceSize VKR::VkRenderGraph::GetUnaliasedMemorySize() const
+{
+    return m_UnaliasedMemorySize;
+}
+
+const VkDeviceSize VKR::VkRenderGraph::GetLazyMemorySize() const
+{
+    return m_LazyMemorySize;
+}
@@ -0,0 +1,149 @@
+#include "../../include/VKR/Vulkan/VkRingBuffer.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <algorithm>
+
+//The largest minUniformBufferOffsetAlignment permitted by the specification.
+constexpr VkDeviceSize MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT = 256;
+
+static inline VkDeviceSize AlignUp(const VkDeviceSize value, const VkDeviceSize alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+VKR::VkRingBuffer::VkRingBuffer()
+{
+    m_Buffer = {};
+    m_pData = nullptr;
+
+    m_Size = 0;
+    m_Alignment = 0;
+
+    m_Head = 0;
+    m_Tail = 0;
+    m_FrameStart = 0;
+    m_FrameIndex = 0;
+}
+
+VkResult VKR::VkRingBuffer::Create(const VkContext& context, const VkDeviceSize size, const VkBufferUsageFlags usage, const uint32_t framesInFlight)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(context.GetPhysicalDevice(), &properties);
+    m_Alignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 16);
+
+    //Round the capacity up, so that aligned virtual offsets remain aligned once wrapped.
+    m_Size = AlignUp(size, MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
+
+    //The buffer stays mapped for its entire lifetime.
+    VkResult result = context.CreateBuffer(m_Size, usage, VMA_MEMORY_USAGE_AUTO_PREFER_HOST, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT, &m_Buffer);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Ring Buffer!\n");
+        return result;
+    }
+
+    m_pData = static_cast<uint8_t*>(m_Buffer.pMappedData);
+
+    m_Head = 0;
+    m_Tail = 0;
+    m_FrameStart = 0;
+    m_FrameIndex = 0;
+    m_FrameEnds.assign(framesInFlight, 0);
+
+    Log::Debug("[Vulkan]\tCreated %llu byte Ring Buffer with %llu byte alignment.\n", static_cast<unsigned long long>(m_Size), static_cast<unsigned long long>(m_Alignment));
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkRingBuffer::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (m_Buffer.buffer != VK_NULL_HANDLE) {
+        context.DestroyBuffer(m_Buffer);
+    }
+
+    m_pData = nullptr;
+
+    m_FrameEnds.clear();
+}
+
+void VKR::VkRingBuffer::BeginFrame(const uint32_t frameIndex)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    //Close off the previous frame, then reclaim everything up to the end of this frame's last use.
+    m_FrameEnds[m_FrameIndex] = m_Head;
+    m_FrameIndex = frameIndex;
+    m_Tail = std::max(m_Tail, m_FrameEnds[m_FrameIndex]);
+
+    m_FrameStart = m_Head;
+}
+
+VkResult VKR::VkRingBuffer::EndFrame(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (m_Head == m_FrameStart) {
+        return VK_SUCCESS;
+    }
+
+    //Flush the frame's range. If the frame wrapped around the end of the ring, this requires two ranges.
+    const VkDeviceSize start = m_FrameStart % m_Size;
+    const VkDeviceSize length = std::min(m_Head - m_FrameStart, m_Size);
+
+    VkResult result = VK_SUCCESS;
+    if (start + length <= m_Size) {
+        result = context.Flush(m_Buffer, start, length);
+    }
+    else {
+        result = context.Flush(m_Buffer, start, m_Size - start);
+        if (result == VK_SUCCESS) {
+            result = context.Flush(m_Buffer, 0, (start + length) - m_Size);
+        }
+    }
+
+    return result;
+}
+
+VkResult VKR::VkRingBuffer::Allocate(const VkDeviceSize size, Allocation* pAllocation, const VkDeviceSize alignment)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    const VkDeviceSize align = alignment > 0 ? alignment : m_Alignment;
+
+    //Align the physical offset, as the capacity needn't be a multiple of larger alignments.
+    const VkDeviceSize head = m_Head % m_Size;
+    VkDeviceSize offset = m_Head + (AlignUp(head, align) - head);
+
+    //Allocations must be contiguous, so skip to the start of the ring if this one would straddle the end. Offset 0 satisfies any alignment.
+    if ((offset - (m_Head - head)) + size > m_Size) {
+        offset = (m_Head - head) + m_Size;
+    }
+
+    if (size > m_Size || (offset + size) - m_Tail > m_Size) {
+        Log::Warning("[Vulkan]\tRing Buffer is full! Failed to allocate %llu bytes.\n", static_cast<unsigned long long>(size));
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    m_Head = offset + size;
+
+    pAllocation->offset = offset % m_Size;
+    pAllocation->pData = m_pData + pAllocation->offset;
+
+    return VK_SUCCESS;
+}
+
+const VkBuffer& VKR::VkRingBuffer::GetBuffer() const
+{
+    return m_Buffer.buffer;
+}
+
+const VkDeviceSize VKR::VkRingBuffer::GetAlignment() const
+{
+    return m_Alignment;
+}
@@ -0,0 +1,443 @@
+#include "../../include/VKR/Vulkan/VkShaderHotReload.h"
+#include "../../include/VKR/Vulkan/VkPipelineRegistry.h"
+#include "../../include/VKR/Vulkan/VkShaderReflection.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/File.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <filesystem>
+#endif
+
+//Paths are compared as strings, so are stored with forward slashes and an explicit directory.
+static std::string NormalizePath(const std::string& path)
+{
+    std::string normalized = path;
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+    if (normalized.find('/') == std::string::npos) {
+        normalized = "./" + normalized;
+    }
+
+    return normalized;
+}
+
+static std::string DirectoryOf(const std::string& normalizedPath)
+{
+    return normalizedPath.substr(0, normalizedPath.find_last_of('/'));
+}
+
+VKR::VkShaderHotReload::VkShaderHotReload()
+{
+    m_pRegistry = nullptr;
+    m_ReloadCount = 0;
+    m_WatchFD = -1;
+}
+
+VkResult VKR::VkShaderHotReload::Create(const VkContext& context, VkPipelineRegistry& registry, const char* compilerCommand)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_pRegistry = &registry;
+    m_CompilerCommand = compilerCommand;
+    m_ReloadCount = 0;
+
+#if defined(__linux__)
+    m_WatchFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_WatchFD < 0) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to initialize inotify! Shaders will not be reloaded.\n");
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+#endif
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkShaderHotReload::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    for (auto& pShader : m_Shaders) {
+        if (pShader->job) {
+            Jobs::Wait(*pShader->job);
+        }
+        if (pShader->pendingModule != VK_NULL_HANDLE) {
+            context.DestroyShaderModule(pShader->pendingModule);
+        }
+        context.DestroyShaderModule(pShader->module);
+    }
+
+    //Wait for any Pipelines still compiling from retired modules.
+    for (auto& retired : m_RetiredModules) {
+        for (const auto& dependent : retired.dependents) {
+            dependent.Get();
+        }
+        context.DestroyShaderModule(retired.module);
+    }
+
+#if defined(__linux__)
+    if (m_WatchFD >= 0) {
+        close(m_WatchFD);
+    }
+#endif
+
+    Log::Debug("[Vulkan]\tDestroyed Shader Hot Reload. (%d Shaders, %d Reloads)\n", static_cast<uint32_t>(m_Shaders.size()), m_ReloadCount);
+
+    m_Shaders.clear();
+    m_Pipelines.clear();
+    m_RetiredModules.clear();
+    m_WatchedDirectories.clear();
+    m_WatchedFiles.clear();
+    m_WatchFD = -1;
+    m_pRegistry = nullptr;
+}
+
+VkResult VKR::VkShaderHotReload::LoadShader(const VkContext& context, const char* spirvPath, const char* sourcePath, ShaderHandle* pHandle)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    std::vector<char> blob;
+    if (IO::ReadFile(spirvPath, blob) != Status::SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to read shader \"%s\"!\n", spirvPath);
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    std::unique_ptr<Shader> shader = std::make_unique<Shader>();
+    shader->spirvPath = NormalizePath(spirvPath);
+    shader->sourcePath = sourcePath != nullptr ? NormalizePath(sourcePath) : "";
+    shader->module = VK_NULL_HANDLE;
+    shader->id = VkShaderReflection::HashSPIRV(blob.data(), blob.size());
+    shader->pendingModule = VK_NULL_HANDLE;
+    shader->pendingID = 0;
+    shader->recompile = false;
+    shader->dirty = false;
+
+    VkResult result = context.CreateShaderModule(blob.data(), blob.size(), &shader->module);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Shader Module for \"%s\"!\n", spirvPath);
+        return result;
+    }
+
+    Watch(shader->spirvPath);
+    if (!shader->sourcePath.empty()) {
+        Watch(shader->sourcePath);
+    }
+
+    *pHandle = static_cast<ShaderHandle>(m_Shaders.size());
+    m_Shaders.push_back(std::move(shader));
+
+    return VK_SUCCESS;
+}
+
+VkShaderModule VKR::VkShaderHotReload::GetShaderModule(const ShaderHandle handle) const
+{
+    return m_Shaders.at(handle)->module;
+}
+
+uint64_t VKR::VkShaderHotReload::GetShaderID(const ShaderHandle handle) const
+{
+    return m_Shaders.at(handle)->id;
+}
+
+VKR::VkShaderHotReload::PipelineHandle VKR::VkShaderHotReload::AddGraphicsPipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout, const VkRenderPass renderPass, const uint32_t subpassIdx)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    Pipeline pipeline = {};
+    pipeline.builder = builder;
+    pipeline.layout = layout;
+    pipeline.renderPass = renderPass;
+    pipeline.subpassIdx = subpassIdx;
+    pipeline.compute = false;
+    pipeline.current = RequestPipeline(context, pipeline);
+    pipeline.hasPending = false;
+
+    m_Pipelines.push_back(std::move(pipeline));
+
+    return static_cast<PipelineHandle>(m_Pipelines.size() - 1);
+}
+
+VKR::VkShaderHotReload::PipelineHandle VKR::VkShaderHotReload::AddComputePipeline(const VkContext& context, const VkPipelineBuilder& builder, const VkPipelineLayout layout)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    Pipeline pipeline = {};
+    pipeline.builder = builder;
+    pipeline.layout = layout;
+    pipeline.renderPass = VK_NULL_HANDLE;
+    pipeline.subpassIdx = 0;
+    pipeline.compute = true;
+    pipeline.current = RequestPipeline(context, pipeline);
+    pipeline.hasPending = false;
+
+    m_Pipelines.push_back(std::move(pipeline));
+
+    return static_cast<PipelineHandle>(m_Pipelines.size() - 1);
+}
+
+VkPipeline VKR::VkShaderHotReload::GetPipeline(const PipelineHandle handle, const VkPipeline placeholder) const
+{
+    return m_Pipelines.at(handle).current.GetOr(placeholder);
+}
+
+void VKR::VkShaderHotReload::Update(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //Start reloading any changed shaders. Shaders with a Job are revisited once it completes.
+    std::vector<std::string> changedFiles;
+    PollChanges(changedFiles);
+
+    for (const auto& file : changedFiles) {
+        for (auto& pShader : m_Shaders) {
+            const bool sourceChanged = !pShader->sourcePath.empty() && file == pShader->sourcePath;
+            if (!sourceChanged && file != pShader->spirvPath) {
+                continue;
+            }
+
+            //A finished Job's result must still be applied before reloading again, which the loop below does.
+            pShader->recompile |= sourceChanged;
+            if (pShader->job) {
+                pShader->dirty = true;
+            }
+            else {
+                Reload(context, *pShader);
+            }
+        }
+    }
+
+    //Rebuild the Pipelines using any shaders which have finished reloading.
+    for (auto& pShader : m_Shaders) {
+        if (!pShader->job || !pShader->job->IsComplete()) {
+            continue;
+        }
+
+        pShader->job.reset();
+        ApplyReload(context, *pShader);
+
+        if (pShader->dirty) {
+            pShader->dirty = false;
+            Reload(context, *pShader);
+        }
+    }
+
+    //Swap in rebuilt Pipelines. This is the only place 'current' changes, so handles are stable for the rest of the frame.
+    for (uint32_t i = 0; i < m_Pipelines.size(); i++) {
+        Pipeline& pipeline = m_Pipelines[i];
+        if (!pipeline.hasPending || !pipeline.pending.IsReady()) {
+            continue;
+        }
+
+        pipeline.hasPending = false;
+        if (pipeline.pending.Get() == VK_NULL_HANDLE) {
+            Log::Warning("[Vulkan]\tFailed to rebuild Pipeline %d. Keeping the previous Pipeline.\n", i);
+            continue;
+        }
+
+        pipeline.current = pipeline.pending;
+        m_ReloadCount++;
+        Log::Message("[Vulkan]\tReloaded Pipeline %d.\n", i);
+    }
+
+    //Shader Modules are only needed during Pipeline creation, so can be destroyed once no Pipelines are compiling from them.
+    m_RetiredModules.erase(std::remove_if(m_RetiredModules.begin(), m_RetiredModules.end(), [&context](RetiredModule& retired) {
+        for (const auto& dependent : retired.dependents) {
+            if (!dependent.IsReady()) {
+                return false;
+            }
+        }
+        context.DestroyShaderModule(retired.module);
+        return true;
+    }), m_RetiredModules.end());
+}
+
+const uint32_t VKR::VkShaderHotReload::GetReloadCount() const
+{
+    return m_ReloadCount;
+}
+
+void VKR::VkShaderHotReload::Watch(const std::string& filePath)
+{
+#if defined(__linux__)
+    //inotify watches directories, so events for every shader in a directory arrive through one watch.
+    const std::string directory = DirectoryOf(filePath);
+    for (const auto& watched : m_WatchedDirectories) {
+        if (watched.second == directory) {
+            return;
+        }
+    }
+
+    //Editors often save by writing a temporary file and renaming it over the original, so renames are watched as well as writes.
+    const int wd = inotify_add_watch(m_WatchFD, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+        Log::Warning("[Vulkan]\tFailed to watch \"%s\" for shader changes.\n", directory.c_str());
+        return;
+    }
+
+    m_WatchedDirectories.push_back({ wd, directory });
+#else
+    std::error_code error;
+    const auto time = std::filesystem::last_write_time(filePath, error);
+    m_WatchedFiles.push_back({ filePath, error ? 0 : static_cast<int64_t>(time.time_since_epoch().count()) });
+#endif
+}
+
+void VKR::VkShaderHotReload::PollChanges(std::vector<std::string>& changedFiles)
+{
+#if defined(__linux__)
+    if (m_WatchFD < 0) {
+        return;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        const ssize_t length = read(m_WatchFD, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;      //EAGAIN: No more events.
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event* pEvent = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + pEvent->len;
+
+            if (pEvent->len == 0) {
+                continue;
+            }
+
+            for (const auto& watched : m_WatchedDirectories) {
+                if (watched.first == pEvent->wd) {
+                    const std::string path = watched.second + "/" + pEvent->name;
+                    if (std::find(changedFiles.begin(), changedFiles.end(), path) == changedFiles.end()) {
+                        changedFiles.push_back(path);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+#else
+    for (auto& watched : m_WatchedFiles) {
+        std::error_code error;
+        const auto time = std::filesystem::last_write_time(watched.first, error);
+        if (error) {
+            continue;
+        }
+
+        const int64_t ticks = static_cast<int64_t>(time.time_since_epoch().count());
+        if (ticks != watched.second) {
+            watched.second = ticks;
+            changedFiles.push_back(watched.first);
+        }
+    }
+#endif
+}
+
+void VKR::VkShaderHotReload::Reload(const VkContext& context, Shader& shader)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    const bool recompile = shader.recompile;
+    shader.recompile = false;
+    shader.pendingModule = VK_NULL_HANDLE;
+    shader.pendingID = shader.id;
+
+    Shader* pShader = &shader;
+    const VkContext* pContext = &context;
+    const std::string command = m_CompilerCommand + " \"" + shader.sourcePath + "\" -o \"" + shader.spirvPath + "\"";
+    const uint64_t currentID = shader.id;
+
+    auto reload = [pShader, pContext, command, recompile, currentID](uint32_t threadIndex) {
+        EASY_BLOCK("Shader Reload", profiler::colors::Red500);
+
+        if (recompile) {
+            if (std::system(command.c_str()) != 0) {
+                Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to compile \"%s\". Keeping the previous shader.\n", pShader->sourcePath.c_str());
+                return;
+            }
+        }
+
+        std::vector<char> blob;
+        if (IO::ReadFile(pShader->spirvPath.c_str(), blob) != Status::SUCCESS || blob.empty()) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to read \"%s\". Keeping the previous shader.\n", pShader->spirvPath.c_str());
+            return;
+        }
+
+        //Recompiling writes the SPIR-V, which is itself a change. Identical SPIR-V needn't be reloaded.
+        const uint64_t id = VkShaderReflection::HashSPIRV(blob.data(), blob.size());
+        if (id == currentID) {
+            return;
+        }
+
+        VkShaderModule module = VK_NULL_HANDLE;
+        if (pContext->CreateShaderModule(blob.data(), blob.size(), &module) != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Shader Module for \"%s\". Keeping the previous shader.\n", pShader->spirvPath.c_str());
+            return;
+        }
+
+        pShader->pendingModule = module;
+        pShader->pendingID = id;
+    };
+
+    //Without worker threads the Job would only run once waited on, so reload immediately.
+    if (Jobs::NumThreads() <= 1) {
+        reload(0);
+        ApplyReload(context, shader);
+        return;
+    }
+
+    shader.job = std::make_unique<Job>(reload);
+    Jobs::Run(*shader.job);
+}
+
+void VKR::VkShaderHotReload::ApplyReload(const VkContext& context, Shader& shader)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (shader.pendingModule == VK_NULL_HANDLE) {
+        return;     //Failed, or unchanged.
+    }
+
+    RetiredModule retired = {};
+    retired.module = shader.module;
+
+    //Only Pipelines built from this shader are rebuilt.
+    uint32_t numRebuilt = 0;
+    for (auto& pipeline : m_Pipelines) {
+        if (!pipeline.builder.UsesShaderModule(shader.module)) {
+            continue;
+        }
+
+        retired.dependents.push_back(pipeline.current);
+        if (pipeline.hasPending) {
+            retired.dependents.push_back(pipeline.pending);
+        }
+
+        pipeline.builder.ReplaceShaderModule(shader.module, shader.pendingModule, shader.pendingID);
+        pipeline.pending = RequestPipeline(context, pipeline);
+        pipeline.hasPending = true;
+        numRebuilt++;
+    }
+
+    m_RetiredModules.push_back(std::move(retired));
+
+    shader.module = shader.pendingModule;
+    shader.id = shader.pendingID;
+    shader.pendingModule = VK_NULL_HANDLE;
+
+    Log::Message("[Vulkan]\tReloaded \"%s\". Rebuilding %d Pipelines.\n", shader.spirvPath.c_str(), numRebuilt);
+}
+
+VKR::VkAsyncPipeline VKR::VkShaderHotReload::RequestPipeline(const VkContext& context, const Pipeline& pipeline)
+{
+    if (pipeline.compute) {
+        return m_pRegistry->GetComputePipeline(context, pipeline.builder, pipeline.layout);
+    }
+
+    return m_pRegistry->GetGraphicsPipeline(context, pipeline.builder, pipeline.layout, pipeline.renderPass, pipeline.subpassIdx);
+}
@@ -0,0 +1,721 @@
+#include "../../include/VKR/Vulkan/VkShaderReflection.h"
+#include "../../include/VKR/Vulkan/VkLayoutCache.h"
+#include "../../include/VKR/Vulkan/VkPipelineBuilder.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/File.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+
+//The subset of the SPIR-V specification needed to reflect resource interfaces.
+namespace SPIRV {
+    constexpr uint32_t MAGIC = 0x07230203;
+    constexpr uint32_t HEADER_WORDS = 5;
+    constexpr uint32_t MAX_BOUND = 0x3fffff;    //The universal limit on IDs.
+
+    enum Op : uint32_t {
+        OpEntryPoint = 15,
+        OpTypeVoid = 19,
+        OpTypeBool = 20,
+        OpTypeInt = 21,
+        OpTypeFloat = 22,
+        OpTypeVector = 23,
+        OpTypeMatrix = 24,
+        OpTypeImage = 25,
+        OpTypeSampler = 26,
+        OpTypeSampledImage = 27,
+        OpTypeArray = 28,
+        OpTypeRuntimeArray = 29,
+        OpTypeStruct = 30,
+        OpTypePointer = 32,
+        OpConstant = 43,
+        OpVariable = 59,
+        OpDecorate = 71,
+        OpMemberDecorate = 72,
+        OpTypeAccelerationStructureKHR = 5341,
+    };
+
+    enum Decoration : uint32_t {
+        Block = 2,
+        BufferBlock = 3,
+        ArrayStride = 6,
+        MatrixStride = 7,
+        BuiltIn = 11,
+        Location = 30,
+        Binding = 33,
+        DescriptorSet = 34,
+        Offset = 35,
+    };
+
+    enum StorageClass : uint32_t {
+        UniformConstant = 0,
+        Input = 1,
+        Uniform = 2,
+        PushConstant = 9,
+        StorageBuffer = 12,
+    };
+
+    enum ExecutionModel : uint32_t {
+        Vertex = 0,
+        TessellationControl = 1,
+        TessellationEvaluation = 2,
+        Geometry = 3,
+        Fragment = 4,
+        GLCompute = 5,
+    };
+
+    enum Dim : uint32_t {
+        DimBuffer = 5,
+        DimSubpassData = 6,
+    };
+
+    /**
+     * @brief Everything known about a single result ID.
+    */
+    struct Id {
+        uint32_t opcode = 0;
+        std::vector<uint32_t> operands;     //Operands following the result ID.
+        uint32_t set = 0;
+        uint32_t binding = 0;
+        uint32_t location = 0;
+        uint32_t arrayStride = 0;
+        bool hasBinding = false;
+        bool hasLocation = false;
+        bool builtIn = false;
+        bool bufferBlock = false;
+        std::vector<uint32_t> memberOffsets;
+        std::vector<uint32_t> memberMatrixStrides;
+    };
+}
+
+constexpr uint32_t REFLECTION_CACHE_MAGIC = 0x52524b56;    //"VKRR"
+constexpr uint32_t REFLECTION_CACHE_VERSION = 1;
+
+static VkShaderStageFlagBits ExecutionModelToStage(const uint32_t model)
+{
+    switch (model) {
+    case SPIRV::Vertex: return VK_SHADER_STAGE_VERTEX_BIT;
+    case SPIRV::TessellationControl: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+    case SPIRV::TessellationEvaluation: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+    case SPIRV::Geometry: return VK_SHADER_STAGE_GEOMETRY_BIT;
+    case SPIRV::Fragment: return VK_SHADER_STAGE_FRAGMENT_BIT;
+    case SPIRV::GLCompute: return VK_SHADER_STAGE_COMPUTE_BIT;
+    default: return VK_SHADER_STAGE_ALL;
+    }
+}
+
+static void Grow(std::vector<uint32_t>& values, const uint32_t index)
+{
+    if (values.size() <= index) {
+        values.resize(index + 1, 0);
+    }
+}
+
+//Returns the number of operands, including the result ID, an instruction needs to be reflected. 0 if it isn't a type.
+static uint32_t TypeOperandCount(const uint32_t opcode)
+{
+    switch (opcode) {
+    case SPIRV::OpTypeVoid:
+    case SPIRV::OpTypeBool:
+    case SPIRV::OpTypeSampler:
+    case SPIRV::OpTypeAccelerationStructureKHR:
+    case SPIRV::OpTypeStruct:
+        return 1;
+    case SPIRV::OpTypeFloat:
+    case SPIRV::OpTypeSampledImage:
+    case SPIRV::OpTypeRuntimeArray:
+        return 2;
+    case SPIRV::OpTypeInt:
+    case SPIRV::OpTypeVector:
+    case SPIRV::OpTypeMatrix:
+    case SPIRV::OpTypeArray:
+    case SPIRV::OpTypePointer:
+        return 3;
+    case SPIRV::OpTypeImage:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+//Returns true if 'id' is within the module's bound, and has already been declared.
+static bool IsDeclared(const std::vector<SPIRV::Id>& ids, const uint32_t id)
+{
+    return id < ids.size() && ids[id].opcode != 0;
+}
+
+//Returns the size in bytes of a type, following explicit layout decorations.
+static uint32_t TypeSize(const std::vector<SPIRV::Id>& ids, const uint32_t typeId, const uint32_t matrixStride = 0)
+{
+    const SPIRV::Id& type = ids[typeId];
+    switch (type.opcode) {
+    case SPIRV::OpTypeInt:
+    case SPIRV::OpTypeFloat:
+        return type.operands[0] / 8;
+    case SPIRV::OpTypeVector:
+        return type.operands[1] * TypeSize(ids, type.operands[0]);
+    case SPIRV::OpTypeMatrix:
+        return type.operands[1] * (matrixStride != 0 ? matrixStride : TypeSize(ids, type.operands[0]));
+    case SPIRV::OpTypeArray: {
+        const uint32_t length = ids[type.operands[1]].operands.empty() ? 0 : ids[type.operands[1]].operands[0];
+        return length * (type.arrayStride != 0 ? type.arrayStride : TypeSize(ids, type.operands[0], matrixStride));
+    }
+    case SPIRV::OpTypeStruct: {
+        uint32_t size = 0;
+        for (uint32_t i = 0; i < type.operands.size(); i++) {
+            const uint32_t offset = i < type.memberOffsets.size() ? type.memberOffsets[i] : 0;
+            const uint32_t stride = i < type.memberMatrixStrides.size() ? type.memberMatrixStrides[i] : 0;
+            size = std::max(size, offset + TypeSize(ids, type.operands[i], stride));
+        }
+        return size;
+    }
+    default:
+        return 0;   //Runtime arrays and opaque types have no static size.
+    }
+}
+
+static VkFormat VertexInputFormat(const std::vector<SPIRV::Id>& ids, const uint32_t typeId)
+{
+    const SPIRV::Id& type = ids[typeId];
+    const uint32_t components = type.opcode == SPIRV::OpTypeVector ? type.operands[1] : 1;
+    if (components == 0 || components > 4) {
+        return VK_FORMAT_UNDEFINED;
+    }
+    const SPIRV::Id& scalar = type.opcode == SPIRV::OpTypeVector ? ids[type.operands[0]] : type;
+
+    if (scalar.opcode == SPIRV::OpTypeFloat && scalar.operands[0] == 32) {
+        const VkFormat formats[] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+        return formats[components - 1];
+    }
+    if (scalar.opcode == SPIRV::OpTypeFloat && scalar.operands[0] == 64) {
+        const VkFormat formats[] = { VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT, VK_FORMAT_R64G64B64_SFLOAT, VK_FORMAT_R64G64B64A64_SFLOAT };
+        return formats[components - 1];
+    }
+    if (scalar.opcode == SPIRV::OpTypeInt && scalar.operands[0] == 32) {
+        const VkFormat sint[] = { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+        const VkFormat uint[] = { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+        return scalar.operands[1] ? sint[components - 1] : uint[components - 1];
+    }
+
+    return VK_FORMAT_UNDEFINED;
+}
+
+static VkDescriptorType DescriptorType(const std::vector<SPIRV::Id>& ids, const uint32_t storageClass, const uint32_t typeId)
+{
+    const SPIRV::Id& type = ids[typeId];
+
+    if (storageClass == SPIRV::StorageBuffer) {
+        return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    }
+    if (storageClass == SPIRV::Uniform) {
+        //Older SPIR-V declares storage buffers as Uniform, decorated BufferBlock.
+        return type.bufferBlock ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    }
+
+    switch (type.opcode) {
+    case SPIRV::OpTypeSampler:
+        return VK_DESCRIPTOR_TYPE_SAMPLER;
+    case SPIRV::OpTypeSampledImage:
+        return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    case SPIRV::OpTypeAccelerationStructureKHR:
+        return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+    case SPIRV::OpTypeImage: {
+        const uint32_t dim = type.operands[1];
+        const uint32_t sampled = type.operands[5];     //1: Sampled, 2: Storage
+        if (dim == SPIRV::DimSubpassData) {
+            return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        }
+        if (dim == SPIRV::DimBuffer) {
+            return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+        }
+        return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    }
+    default:
+        return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+    }
+}
+
+VKR::VkShaderReflection::VkShaderReflection()
+{
+}
+
+uint64_t VKR::VkShaderReflection::HashSPIRV(const char* pBlob, const size_t byteWidth)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < byteWidth; i++) {
+        hash = (hash ^ static_cast<uint8_t>(pBlob[i])) * 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+VkResult VKR::VkShaderReflection::ReflectStage(const char* pBlob, const size_t byteWidth, VkShaderStageReflection* pReflection)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (byteWidth < SPIRV::HEADER_WORDS * sizeof(uint32_t) || byteWidth % sizeof(uint32_t) != 0) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tSPIR-V blob is too small, or misaligned!\n");
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    std::vector<uint32_t> words(byteWidth / sizeof(uint32_t));
+    memcpy(words.data(), pBlob, byteWidth);
+
+    if (words[0] != SPIRV::MAGIC) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tInvalid SPIR-V magic number!\n");
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    const uint32_t bound = words[3];
+    if (bound > SPIRV::MAX_BOUND) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tSPIR-V ID bound %d exceeds the limit of %d!\n", bound, SPIRV::MAX_BOUND);
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    std::vector<SPIRV::Id> ids(bound);
+
+    VkShaderStageFlagBits stage = VK_SHADER_STAGE_ALL;
+    std::vector<uint32_t> variables;
+
+    //Gather types, decorations and variables in a single pass. Types are always declared before use, so can be resolved afterwards.
+    for (size_t i = SPIRV::HEADER_WORDS; i < words.size();) {
+        const uint32_t opcode = words[i] & 0xffff;
+        const uint32_t wordCount = words[i] >> 16;
+        if (wordCount == 0 || i + wordCount > words.size()) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tMalformed SPIR-V instruction at word %llu!\n", static_cast<unsigned long long>(i));
+            return VK_ERROR_INITIALIZATION_FAILED;
+        }
+        const uint32_t* pOperands = &words[i + 1];
+        const uint32_t numOperands = wordCount - 1;
+
+        switch (opcode) {
+        case SPIRV::OpEntryPoint:
+            if (stage == VK_SHADER_STAGE_ALL) {
+                stage = ExecutionModelToStage(pOperands[0]);
+            }
+            break;
+
+        case SPIRV::OpTypeVoid:
+        case SPIRV::OpTypeBool:
+        case SPIRV::OpTypeInt:
+        case SPIRV::OpTypeFloat:
+        case SPIRV::OpTypeVector:
+        case SPIRV::OpTypeMatrix:
+        case SPIRV::OpTypeImage:
+        case SPIRV::OpTypeSampler:
+        case SPIRV::OpTypeSampledImage:
+        case SPIRV::OpTypeArray:
+        case SPIRV::OpTypeRuntimeArray:
+        case SPIRV::OpTypeStruct:
+        case SPIRV::OpTypePointer:
+        case SPIRV::OpTypeAccelerationStructureKHR: {
+            if (numOperands < TypeOperandCount(opcode) || pOperands[0] >= bound || ids[pOperands[0]].opcode != 0) {
+                Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tMalformed SPIR-V type at word %llu!\n", static_cast<unsigned long long>(i));
+                return VK_ERROR_INITIALIZATION_FAILED;
+            }
+
+            //Types reference only those declared before them, so resolving them can't index out of bounds, or recurse forever.
+            //Pointees may be forward declared, and image sampled types and array lengths aren't gathered, but neither is resolved recursively.
+            bool valid = true;
+            switch (opcode) {
+            case SPIRV::OpTypeVector:
+            case SPIRV::OpTypeMatrix:
+            case SPIRV::OpTypeSampledImage:
+            case SPIRV::OpTypeRuntimeArray:
+                valid = IsDeclared(ids, pOperands[1]);
+                break;
+            case SPIRV::OpTypeImage:
+                valid = pOperands[1] < bound;
+                break;
+            case SPIRV::OpTypeArray:
+                valid = IsDeclared(ids, pOperands[1]) && pOperands[2] < bound;
+                break;
+            case SPIRV::OpTypeStruct:
+                for (uint32_t member = 1; member < numOperands; member++) {
+                    valid = valid && IsDeclared(ids, pOperands[member]);
+                }
+                break;
+            case SPIRV::OpTypePointer:
+                valid = pOperands[2] < bound;
+                break;
+            }
+            if (!valid) {
+                Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tSPIR-V type %d at word %llu references an undeclared ID!\n", pOperands[0], static_cast<unsigned long long>(i));
+                return VK_ERROR_INITIALIZATION_FAILED;
+            }
+
+            ids[pOperands[0]].opcode = opcode;
+            ids[pOperands[0]].operands.assign(pOperands + 1, pOperands + numOperands);
+            break;
+        }
+
+        case SPIRV::OpConstant:
+        case SPIRV::OpVariable:
+            //Both begin with a result type, then the result ID.
+            if (numOperands >= 3) {
+                if (pOperands[1] >= bound || !IsDeclared(ids, pOperands[0]) || ids[pOperands[1]].opcode != 0) {
+                    Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tSPIR-V ID %d at word %llu is out of bounds, redeclared, or has an undeclared type!\n", pOperands[1], static_cast<unsigned long long>(i));
+                    return VK_ERROR_INITIALIZATION_FAILED;
+                }
+                ids[pOperands[1]].opcode = opcode;
+                ids[pOperands[1]].operands.assign({ pOperands[2], pOperands[0] });     //Constant: (value, type). Variable: (storage class, type).
+                if (opcode == SPIRV::OpVariable) {
+                    variables.push_back(pOperands[1]);
+                }
+            }
+            break;
+
+        case SPIRV::OpDecorate:
+        case SPIRV::OpMemberDecorate:
+            if (numOperands >= 1 && pOperands[0] >= bound) {
+                Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tSPIR-V decoration target %d at word %llu is out of bounds!\n", pOperands[0], static_cast<unsigned long long>(i));
+                return VK_ERROR_INITIALIZATION_FAILED;
+            }
+            if (opcode == SPIRV::OpDecorate && numOperands >= 2) {
+                SPIRV::Id& target = ids[pOperands[0]];
+                const uint32_t value = numOperands >= 3 ? pOperands[2] : 0;
+                switch (pOperands[1]) {
+                case SPIRV::DescriptorSet: target.set = value; break;
+                case SPIRV::Binding: target.binding = value; target.hasBinding = true; break;
+                case SPIRV::Location: target.location = value; target.hasLocation = true; break;
+                case SPIRV::ArrayStride: target.arrayStride = value; break;
+                case SPIRV::BuiltIn: target.builtIn = true; break;
+                case SPIRV::BufferBlock: target.bufferBlock = true; break;
+                }
+            }
+            else if (opcode == SPIRV::OpMemberDecorate && numOperands >= 4) {
+                SPIRV::Id& target = ids[pOperands[0]];
+                const uint32_t member = pOperands[1];
+                if (member >= words.size()) {   //A struct can't have more members than the module has words.
+                    Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tInvalid SPIR-V member index %d at word %llu!\n", member, static_cast<unsigned long long>(i));
+                    return VK_ERROR_INITIALIZATION_FAILED;
+                }
+                if (pOperands[2] == SPIRV::Offset) {
+                    Grow(target.memberOffsets, member);
+                    target.memberOffsets[member] = pOperands[3];
+                }
+                else if (pOperands[2] == SPIRV::MatrixStride) {
+                    Grow(target.memberMatrixStrides, member);
+                    target.memberMatrixStrides[member] = pOperands[3];
+                }
+                else if (pOperands[2] == SPIRV::BuiltIn) {
+                    target.builtIn = true;
+                }
+            }
+            break;
+        }
+
+        i += wordCount;
+    }
+
+    VkShaderStageReflection reflection = {};
+    reflection.stage = stage;
+
+    uint32_t pushConstantEnd = 0;
+    reflection.pushConstantOffset = UINT32_MAX;
+
+    for (const uint32_t variableId : variables) {
+        const SPIRV::Id& variable = ids[variableId];
+        const uint32_t storageClass = variable.operands[0];
+        const SPIRV::Id& pointer = ids[variable.operands[1]];
+        if (pointer.opcode != SPIRV::OpTypePointer || pointer.operands.size() < 2) {
+            continue;
+        }
+        uint32_t typeId = pointer.operands[1];
+
+        switch (storageClass) {
+        case SPIRV::UniformConstant:
+        case SPIRV::Uniform:
+        case SPIRV::StorageBuffer: {
+            if (!variable.hasBinding) {
+                continue;
+            }
+
+            //Peel arrays of descriptors, multiplying out their lengths.
+            uint32_t count = 1;
+            while (ids[typeId].opcode == SPIRV::OpTypeArray || ids[typeId].opcode == SPIRV::OpTypeRuntimeArray) {
+                if (ids[typeId].opcode == SPIRV::OpTypeRuntimeArray) {
+                    count = 0;
+                }
+                else {
+                    const SPIRV::Id& length = ids[ids[typeId].operands[1]];
+                    count *= length.operands.empty() ? 1 : length.operands[0];
+                }
+                typeId = ids[typeId].operands[0];
+            }
+
+            const VkDescriptorType type = DescriptorType(ids, storageClass, typeId);
+            if (type == VK_DESCRIPTOR_TYPE_MAX_ENUM) {
+                Log::Warning("[Vulkan]\tUnrecognised descriptor type at set %d, binding %d.\n", variable.set, variable.binding);
+                continue;
+            }
+
+            reflection.bindings.push_back({ variable.set, variable.binding, type, count, static_cast<VkShaderStageFlags>(stage) });
+            break;
+        }
+
+        case SPIRV::PushConstant: {
+            const SPIRV::Id& block = ids[typeId];
+            for (uint32_t offset : block.memberOffsets) {
+                reflection.pushConstantOffset = std::min(reflection.pushConstantOffset, offset);
+            }
+            pushConstantEnd = std::max(pushConstantEnd, TypeSize(ids, typeId));
+            break;
+        }
+
+        case SPIRV::Input: {
+            if (stage != VK_SHADER_STAGE_VERTEX_BIT || variable.builtIn || ids[typeId].builtIn || !variable.hasLocation) {
+                continue;
+            }
+
+            const VkFormat format = VertexInputFormat(ids, typeId);
+            if (format == VK_FORMAT_UNDEFINED) {
+                Log::Warning("[Vulkan]\tUnsupported vertex input type at location %d.\n", variable.location);
+                continue;
+            }
+
+            reflection.vertexInputs.push_back({ variable.location, format, TypeSize(ids, typeId) });
+            break;
+        }
+        }
+    }
+
+    if (pushConstantEnd == 0) {
+        reflection.pushConstantOffset = 0;
+    }
+    reflection.pushConstantSize = pushConstantEnd - reflection.pushConstantOffset;
+
+    std::sort(reflection.vertexInputs.begin(), reflection.vertexInputs.end(), [](const VkReflectedVertexInput& a, const VkReflectedVertexInput& b) { return a.location < b.location; });
+    std::sort(reflection.bindings.begin(), reflection.bindings.end(), [](const VkReflectedBinding& a, const VkReflectedBinding& b) {
+        return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+    });
+
+    *pReflection = std::move(reflection);
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkShaderReflection::ReflectStageCached(const char* pBlob, const size_t byteWidth, const char* cacheDirectory, VkShaderStageReflection* pReflection)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    const uint64_t hash = HashSPIRV(pBlob, byteWidth);
+
+    char fileName[64] = {};
+    snprintf(fileName, sizeof(fileName), "%016llx.reflect", static_cast<unsigned long long>(hash));
+    const std::string filePath = std::string(cacheDirectory) + "/" + fileName;
+
+    if (IO::FileExists(filePath.c_str()) && LoadStage(filePath, hash, pReflection)) {
+        return VK_SUCCESS;
+    }
+
+    VkResult result = ReflectStage(pBlob, byteWidth, pReflection);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    SaveStage(filePath, hash, *pReflection);
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkShaderReflection::AddStage(const VkShaderStageReflection& stage)
+{
+    for (const auto& binding : stage.bindings) {
+        auto it = std::find_if(m_Bindings.begin(), m_Bindings.end(), [&binding](const VkReflectedBinding& existing) {
+            return existing.set == binding.set && existing.binding == binding.binding;
+        });
+
+        if (it == m_Bindings.end()) {
+            m_Bindings.push_back(binding);
+            continue;
+        }
+
+        if (it->type != binding.type || it->count != binding.count) {
+            Log::Warning("[Vulkan]\tShader stages disagree on set %d, binding %d!\n", binding.set, binding.binding);
+        }
+        it->stages |= binding.stages;
+    }
+
+    std::sort(m_Bindings.begin(), m_Bindings.end(), [](const VkReflectedBinding& a, const VkReflectedBinding& b) {
+        return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+    });
+
+    //Stages sharing a push constant range share a single VkPushConstantRange.
+    if (stage.pushConstantSize > 0) {
+        auto it = std::find_if(m_PushConstantRanges.begin(), m_PushConstantRanges.end(), [&stage](const VkPushConstantRange& range) {
+            return range.offset == stage.pushConstantOffset && range.size == stage.pushConstantSize;
+        });
+
+        if (it != m_PushConstantRanges.end()) {
+            it->stageFlags |= stage.stage;
+        }
+        else {
+            m_PushConstantRanges.push_back({ static_cast<VkShaderStageFlags>(stage.stage), stage.pushConstantOffset, stage.pushConstantSize });
+        }
+    }
+
+    if (stage.stage == VK_SHADER_STAGE_VERTEX_BIT) {
+        m_VertexInputs = stage.vertexInputs;
+    }
+}
+
+VkResult VKR::VkShaderReflection::CreatePipelineLayout(const VkContext& context, VkLayoutCache& layoutCache, VkPipelineLayout* pPipelineLayout, std::vector<VkDescriptorSetLayout>* pSetLayouts, const uint32_t maxUnboundedDescriptors) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    const uint32_t numSets = m_Bindings.empty() ? 0 : m_Bindings.back().set + 1;
+    std::vector<VkDescriptorSetLayout> setLayouts(numSets, VK_NULL_HANDLE);
+
+    //Sets without any bindings still need a (empty) layout, so later set indices line up.
+    for (uint32_t set = 0; set < numSets; set++) {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        std::vector<VkDescriptorBindingFlags> bindingFlags;
+        bool unbounded = false;
+
+        for (const auto& binding : m_Bindings) {
+            if (binding.set != set) {
+                continue;
+            }
+
+            const bool runtimeArray = binding.count == 0;
+            unbounded |= runtimeArray;
+            bindings.push_back({ binding.binding, binding.type, runtimeArray ? maxUnboundedDescriptors : binding.count, binding.stages, nullptr });
+            bindingFlags.push_back(runtimeArray ? VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT : 0);
+        }
+
+        VkResult result = layoutCache.GetDescriptorSetLayout(context, static_cast<uint32_t>(bindings.size()), bindings.data(), &setLayouts[set], 0, unbounded ? bindingFlags.data() : nullptr);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    VkResult result = layoutCache.GetPipelineLayout(context, numSets, setLayouts.data(), static_cast<uint32_t>(m_PushConstantRanges.size()), m_PushConstantRanges.data(), pPipelineLayout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    if (pSetLayouts != nullptr) {
+        *pSetLayouts = std::move(setLayouts);
+    }
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkShaderReflection::GetVertexInputState(std::vector<VkVertexInputBindingDescription>& bindings, std::vector<VkVertexInputAttributeDescription>& attributes, const uint32_t binding) const
+{
+    bindings.clear();
+    attributes.clear();
+
+    if (m_VertexInputs.empty()) {
+        return;
+    }
+
+    uint32_t offset = 0;
+    for (const auto& input : m_VertexInputs) {
+        attributes.push_back({ input.location, binding, input.format, offset });
+        offset += input.size;
+    }
+
+    bindings.push_back({ binding, offset, VK_VERTEX_INPUT_RATE_VERTEX });
+}
+
+void VKR::VkShaderReflection::ApplyVertexInputState(VkPipelineBuilder& builder, const uint32_t binding) const
+{
+    std::vector<VkVertexInputBindingDescription> bindings;
+    std::vector<VkVertexInputAttributeDescription> attributes;
+    GetVertexInputState(bindings, attributes, binding);
+
+    //The builder copies the descriptions, so they needn't outlive this call.
+    builder.SetVertexInputState(static_cast<uint32_t>(bindings.size()), bindings.data(), static_cast<uint32_t>(attributes.size()), attributes.data());
+}
+
+const std::vector<VKR::VkReflectedBinding>& VKR::VkShaderReflection::GetBindings() const
+{
+    return m_Bindings;
+}
+
+const std::vector<VkPushConstantRange>& VKR::VkShaderReflection::GetPushConstantRanges() const
+{
+    return m_PushConstantRanges;
+}
+
+const std::vector<VKR::VkReflectedVertexInput>& VKR::VkShaderReflection::GetVertexInputs() const
+{
+    return m_VertexInputs;
+}
+
+bool VKR::VkShaderReflection::LoadStage(const std::string& filePath, const uint64_t hash, VkShaderStageReflection* pReflection)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    std::vector<char> blob;
+    if (IO::ReadFile(filePath.c_str(), blob) != Status::SUCCESS || blob.size() % sizeof(uint32_t) != 0) {
+        return false;
+    }
+
+    std::vector<uint32_t> words(blob.size() / sizeof(uint32_t));
+    memcpy(words.data(), blob.data(), blob.size());
+
+    //Header: magic, version, hash (2 words), stage, push constant offset and size, binding count, vertex input count.
+    constexpr size_t HEADER_WORDS = 9;
+    if (words.size() < HEADER_WORDS || words[0] != REFLECTION_CACHE_MAGIC || words[1] != REFLECTION_CACHE_VERSION) {
+        return false;
+    }
+
+    const uint64_t storedHash = static_cast<uint64_t>(words[2]) | (static_cast<uint64_t>(words[3]) << 32);
+    const uint32_t numBindings = words[7];
+    const uint32_t numInputs = words[8];
+    if (storedHash != hash || words.size() != HEADER_WORDS + (numBindings * 5) + (numInputs * 3)) {
+        Log::Warning("[Vulkan]\tDiscarding stale Reflection cache \"%s\".\n", filePath.c_str());
+        return false;
+    }
+
+    VkShaderStageReflection reflection = {};
+    reflection.stage = static_cast<VkShaderStageFlagBits>(words[4]);
+    reflection.pushConstantOffset = words[5];
+    reflection.pushConstantSize = words[6];
+
+    const uint32_t* pWord = &words[HEADER_WORDS];
+    for (uint32_t i = 0; i < numBindings; i++, pWord += 5) {
+        reflection.bindings.push_back({ pWord[0], pWord[1], static_cast<VkDescriptorType>(pWord[2]), pWord[3], pWord[4] });
+    }
+    for (uint32_t i = 0; i < numInputs; i++, pWord += 3) {
+        reflection.vertexInputs.push_back({ pWord[0], static_cast<VkFormat>(pWord[1]), pWord[2] });
+    }
+
+    *pReflection = std::move(reflection);
+
+    return true;
+}
+
+void VKR::VkShaderReflection::SaveStage(const std::string& filePath, const uint64_t hash, const VkShaderStageReflection& reflection)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    std::vector<uint32_t> words = {
+        REFLECTION_CACHE_MAGIC,
+        REFLECTION_CACHE_VERSION,
+        static_cast<uint32_t>(hash),
+        static_cast<uint32_t>(hash >> 32),
+        static_cast<uint32_t>(reflection.stage),
+        reflection.pushConstantOffset,
+        reflection.pushConstantSize,
+        static_cast<uint32_t>(reflection.bindings.size()),
+        static_cast<uint32_t>(reflection.vertexInputs.size())
+    };
+
+    for (const auto& binding : reflection.bindings) {
+        words.insert(words.end(), { binding.set, binding.binding, static_cast<uint32_t>(binding.type), binding.count, binding.stages });
+    }
+    for (const auto& input : reflection.vertexInputs) {
+        words.insert(words.end(), { input.location, static_cast<uint32_t>(input.format), input.size });
+    }
+
+    IO::WriteFile(filePath.c_str(), words.data(), words.size() * sizeof(uint32_t));
+}
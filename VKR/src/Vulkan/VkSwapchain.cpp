@@ -2,9 +2,11 @@
 #include "../../include/VKR/Vulkan/VkContext.h"
 #include "../../include/VKR/Vulkan/VkInit.h"
 #include "../../include/VKR/Vulkan/VkHelpers.h"
+#include "../../include/VKR/Vulkan/VkDeletionQueue.h"
 #include "../include/VKR/Window.h"
 #include "../include/VKR/Logger.h"
 #include <assert.h>
+#include <algorithm>
 #include <easy/profiler.h>
 
 VKR::VkSwapchain::VkSwapchain() {
@@ -16,27 +18,54 @@ VKR::VkSwapchain::VkSwapchain() {
         VK_COLORSPACE_SRGB_NONLINEAR_KHR
     }; 
     m_SurfacePresentMode = VK_PRESENT_MODE_FIFO_KHR;
+    m_PresentConfig = {
+        VK_PRESENT_MODE_MAILBOX_KHR,
+        0,
+        2
+    };
 
     m_ColourClearValue.color = { 0, 0, 0, 0 };
     m_DepthStencilClearValue.depthStencil = { 1.0, 0x00 }; 
+
+    m_pWindow = nullptr;
+    m_QueueFamilyIndex = 0;
+    m_Extent = { 0, 0 };
+    m_OutOfDate = false;
+
+    m_Headless = false;
+    m_Queue = VK_NULL_HANDLE;
+    m_NextImage = 0;
+    m_ReadbackPool = VK_NULL_HANDLE;
+    m_ReadbackCommandBuffer = VK_NULL_HANDLE;
+    m_ReadbackBuffer = {};
 }
 
-VkResult VKR::VkSwapchain::Create(const VkContext& context, const Window* pWindow, const uint32_t queueFamilyIndex)
+VkResult VKR::VkSwapchain::Create(const VkContext& context, const Window* pWindow, const uint32_t queueFamilyIndex, const VkPresentConfig* pConfig)
 {
     EASY_FUNCTION(profiler::colors::Red500);
+    if (pConfig) {
+        m_PresentConfig = *pConfig;
+    }
+    m_PresentConfig.framesInFlight = std::max(m_PresentConfig.framesInFlight, 1u);
+
+    m_pWindow = pWindow;
+    m_QueueFamilyIndex = queueFamilyIndex;
+    m_OutOfDate = false;
+
     CreateSurfaceKHR(context.GetInstance(), pWindow);
 
     //Query Physical Device Swapchain Support
     VkHelpers::QueryPhysicalDeviceSurfaceCapabilitiesKHR(context.GetPhysicalDevice(), m_Surface, m_SurfaceCapabilities);
     std::vector<VkSurfaceFormatKHR> formats = VkHelpers::QueryPhysicalDeviceSurfaceFormats(context.GetPhysicalDevice(), m_Surface);
-    std::vector<VkPresentModeKHR> modes = VkHelpers::QueryPhysicalDeviceSurfacePresentModes(context.GetPhysicalDevice(), m_Surface);
+    m_SupportedPresentModes = VkHelpers::QueryPhysicalDeviceSurfacePresentModes(context.GetPhysicalDevice(), m_Surface);
 
     m_SurfaceFormat = SelectSurfaceFormat(formats.size(), formats.data());
-    m_SurfacePresentMode = SelectPresentMode(modes.size(), modes.data());
+    m_SurfacePresentMode = SelectPresentMode(m_PresentConfig.presentMode);
 
     uint32_t imageCount = SelectImageCount();
 
-    CreateSwapchainKHR(context.GetDevice(), imageCount, pWindow->GetWidth(), pWindow->GetHeight(), queueFamilyIndex);
+    m_Extent = SelectExtent();
+    CreateSwapchainKHR(context.GetDevice(), imageCount, m_Extent.width, m_Extent.height, queueFamilyIndex);
 
     AcquireSwapchainImages(context);
 
@@ -44,14 +73,78 @@ VkResult VKR::VkSwapchain::Create(const VkContext& context, const Window* pWindo
     return VK_SUCCESS;
 }
 
+VkResult VKR::VkSwapchain::CreateHeadless(const VkContext& context, const VkExtent2D extent, const VkQueue queue, const uint32_t queueFamilyIndex, const VkPresentConfig* pConfig)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    if (pConfig) {
+        m_PresentConfig = *pConfig;
+    }
+    m_PresentConfig.framesInFlight = std::max(m_PresentConfig.framesInFlight, 1u);
+
+    m_Headless = true;
+    m_pWindow = nullptr;
+    m_Queue = queue;
+    m_QueueFamilyIndex = queueFamilyIndex;
+    m_OutOfDate = false;
+    m_NextImage = 0;
+    m_Extent = extent;
+    m_SurfaceFormat = { VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR };
+
+    //Nothing holds an image once it's presented, so reusing one only has to wait for the frame which last rendered to it.
+    //The frame context has already waited on that frame if there's an image for each frame in flight.
+    const uint32_t imageCount = std::max(m_PresentConfig.imageCount ? m_PresentConfig.imageCount : 3u, m_PresentConfig.framesInFlight);
+    m_Images.resize(imageCount, VK_NULL_HANDLE);
+    m_ImageViews.resize(imageCount, VK_NULL_HANDLE);
+    m_ImageAllocations.resize(imageCount, VK_NULL_HANDLE);
+
+    for (uint32_t i = 0; i < imageCount; i++) {
+        VkResult result = context.CreateImage(VK_IMAGE_TYPE_2D, { extent.width, extent.height, 1 }, VK_SAMPLE_COUNT_1_BIT, m_SurfaceFormat.format, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, 0, &m_ImageAllocations[i], &m_Images[i]);
+        if (result == VK_SUCCESS) {
+            result = context.CreateImageView(m_Images[i], m_SurfaceFormat.format, VK_IMAGE_ASPECT_COLOR_BIT, &m_ImageViews[i]);
+        }
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Headless Swapchain Image %d!\n", i);
+            return result;
+        }
+    }
+
+    SetClearValue(0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0x00);
+
+    Log::Debug("[Vulkan]\tCreated Headless Swapchain. (%dx%d, %d Images)\n", m_Extent.width, m_Extent.height, imageCount);
+    return VK_SUCCESS;
+}
+
 void VKR::VkSwapchain::Destroy(const VkContext& context)
 {
     for (uint32_t i = 0; i < m_ImageViews.size(); i++) {
         context.DestroyImageView(m_ImageViews[i]);
     }
 
-    DestroySwapchainKHR(context.GetDevice());
-    DestroySurfaceKHR(context.GetInstance());
+    if (m_Headless) {
+        for (uint32_t i = 0; i < m_Images.size(); i++) {
+            context.DestroyImage(m_Images[i], m_ImageAllocations[i]);
+        }
+        if (m_ReadbackPool != VK_NULL_HANDLE) {
+            context.DestroyCommandPool(m_ReadbackPool);     //Frees the readback Command Buffer
+            m_ReadbackPool = VK_NULL_HANDLE;
+            m_ReadbackCommandBuffer = VK_NULL_HANDLE;
+        }
+        if (m_ReadbackBuffer.buffer != VK_NULL_HANDLE) {
+            context.DestroyBuffer(m_ReadbackBuffer);
+        }
+
+        m_ImageAllocations.clear();
+        m_Headless = false;
+    }
+    else {
+        DestroySwapchainKHR(context.GetDevice());
+        DestroySurfaceKHR(context.GetInstance());
+    }
+
+    m_ImageViews.clear();
+    m_Images.clear();
+    m_SupportedPresentModes.clear();
+    m_RecreateCallbacks.clear();
 }
 
 const VkSwapchainKHR& VKR::VkSwapchain::GetSwapchain() const
@@ -77,6 +170,52 @@ const std::vector<VkImageView>& VKR::VkSwapchain::GetImageViews() const
     return m_ImageViews;
 }
 
+const VkExtent2D VKR::VkSwapchain::GetExtent() const
+{
+    return m_Extent;
+}
+
+const VKR::VkPresentConfig& VKR::VkSwapchain::GetPresentConfig() const
+{
+    return m_PresentConfig;
+}
+
+const VkPresentModeKHR VKR::VkSwapchain::GetPresentMode() const
+{
+    return m_SurfacePresentMode;
+}
+
+const uint32_t VKR::VkSwapchain::GetFramesInFlight() const
+{
+    return m_PresentConfig.framesInFlight;
+}
+
+const bool VKR::VkSwapchain::IsHeadless() const
+{
+    return m_Headless;
+}
+
+const VkImageLayout VKR::VkSwapchain::GetPresentLayout() const
+{
+    //VK_IMAGE_LAYOUT_PRESENT_SRC_KHR is only valid with VK_KHR_swapchain enabled.
+    return m_Headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+}
+
+const bool VKR::VkSwapchain::IsPresentModeSupported(const VkPresentModeKHR presentMode) const
+{
+    return std::find(m_SupportedPresentModes.begin(), m_SupportedPresentModes.end(), presentMode) != m_SupportedPresentModes.end();
+}
+
+void VKR::VkSwapchain::SetPresentMode(const VkPresentModeKHR presentMode)
+{
+    if (m_Headless || presentMode == m_PresentConfig.presentMode) {
+        return;
+    }
+
+    m_PresentConfig.presentMode = presentMode;
+    m_OutOfDate = true;     //The present mode is fixed at creation.
+}
+
 void VKR::VkSwapchain::SetClearValue(float r, float g, float b, float a, float depth, uint32_t stencil)
 {
     m_ColourClearValue.color = { r, g, b, a };
@@ -94,10 +233,58 @@ VkClearValue VKR::VkSwapchain::GetColourClearValue() const
     return m_ColourClearValue;
 }
 
+VkResult VKR::VkSwapchain::AcquireNextImage(const VkContext& context, VkSemaphore semaphore, uint32_t* pIndex)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (m_Headless) {
+        *pIndex = m_NextImage;
+        m_NextImage = (m_NextImage + 1) % GetImageCount();
+
+        //The image is available immediately, but the frame still waits on 'semaphore', so signal it.
+        const VkSubmitInfo submitInfo = {
+            VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            nullptr,
+            0,
+            nullptr,
+            nullptr,
+            0,
+            nullptr,
+            1,
+            &semaphore
+        };
+        return vkQueueSubmit(m_Queue, 1, &submitInfo, VK_NULL_HANDLE);
+    }
+
+    const VkResult result = vkAcquireNextImageKHR(context.GetDevice(), m_Swapchain, UINT64_MAX, semaphore, VK_NULL_HANDLE, pIndex);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+        m_OutOfDate = true;
+    }
+
+    return result;
+}
+
 VkResult VKR::VkSwapchain::Present(VkQueue queue, VkSemaphore semaphore, uint32_t* pIndex)
 {
     EASY_FUNCTION(profiler::colors::Red500);
 
+    if (m_Headless) {
+        //Nothing is displayed, but the wait unsignals 'semaphore', so it can be signalled again.
+        const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        const VkSubmitInfo submitInfo = {
+            VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            nullptr,
+            1,
+            &semaphore,
+            &waitStage,
+            0,
+            nullptr,
+            0,
+            nullptr
+        };
+        return vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+    }
+
     const VkPresentInfoKHR presentInfo = { //TODO: VkInit
         VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
         nullptr,
@@ -109,7 +296,177 @@ VkResult VKR::VkSwapchain::Present(VkQueue queue, VkSemaphore semaphore, uint32_
         nullptr
     };
 
-    return vkQueuePresentKHR(queue, &presentInfo);
+    const VkResult result = vkQueuePresentKHR(queue, &presentInfo);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+        m_OutOfDate = true;
+    }
+
+    return result;
+}
+
+const bool VKR::VkSwapchain::NeedsRecreation() const
+{
+    if (m_Headless) {
+        return false;   //Headless images are never resized.
+    }
+
+    return m_OutOfDate || m_pWindow->GetWidth() != m_Extent.width || m_pWindow->GetHeight() != m_Extent.height;
+}
+
+VkResult VKR::VkSwapchain::Recreate(const VkContext& context, VkDeletionQueue& deletionQueue, const uint64_t retireValue)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (m_Headless) {
+        return VK_SUCCESS;
+    }
+
+    VkHelpers::QueryPhysicalDeviceSurfaceCapabilitiesKHR(context.GetPhysicalDevice(), m_Surface, m_SurfaceCapabilities);
+
+    //A minimized window can't be presented to, so keep the current swapchain until it's restored.
+    const VkExtent2D extent = SelectExtent();
+    if (extent.width == 0 || extent.height == 0) {
+        return VK_NOT_READY;
+    }
+
+    //Passing the old swapchain lets the presentation engine reuse its resources, and hand over any images still queued for presentation.
+    m_SurfacePresentMode = SelectPresentMode(m_PresentConfig.presentMode);
+
+    const VkSwapchainKHR oldSwapchain = m_Swapchain;
+    VkResult result = CreateSwapchainKHR(context.GetDevice(), SelectImageCount(), extent.width, extent.height, m_QueueFamilyIndex, oldSwapchain);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to recreate Swapchain!\n");
+        m_Swapchain = oldSwapchain;
+        return result;
+    }
+
+    //Frames up to 'retireValue' may still be rendering to, or presenting, the old images.
+    std::vector<VkImageView> oldImageViews = std::move(m_ImageViews);
+    deletionQueue.Push(retireValue, [oldSwapchain, oldImageViews](const VkContext& ctx) mutable {
+        for (auto& view : oldImageViews) {
+            ctx.DestroyImageView(view);
+        }
+        vkDestroySwapchainKHR(ctx.GetDevice(), oldSwapchain, nullptr);
+    });
+
+    m_ImageViews.clear();
+    m_Extent = extent;
+    m_OutOfDate = false;
+    AcquireSwapchainImages(context);
+
+    Log::Debug("[Vulkan]\tRecreated Swapchain. (%dx%d, %d Images, Present Mode %d)\n", m_Extent.width, m_Extent.height, GetImageCount(), m_SurfacePresentMode);
+
+    for (auto& callback : m_RecreateCallbacks) {
+        callback(context, *this, deletionQueue, retireValue);
+    }
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkSwapchain::AddRecreateCallback(const RecreateCallback& callback)
+{
+    m_RecreateCallbacks.push_back(callback);
+}
+
+VkResult VKR::VkSwapchain::ReadbackImage(const VkContext& context, const uint32_t index, std::vector<uint8_t>& pixels)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    if (!m_Headless) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tReadbackImage() requires a Headless Swapchain!\n");
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    const VkDeviceSize size = static_cast<VkDeviceSize>(m_Extent.width) * m_Extent.height * 4;
+
+    //Readback resources are only created if they're used.
+    VkResult result = VK_SUCCESS;
+    if (m_ReadbackPool == VK_NULL_HANDLE) {
+        result = context.CreateCommandPool(m_QueueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, &m_ReadbackPool);
+        if (result == VK_SUCCESS) {
+            result = context.AllocateCommandBuffers(m_ReadbackPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1, &m_ReadbackCommandBuffer);
+        }
+        if (result == VK_SUCCESS) {
+            result = context.CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_HOST, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT, &m_ReadbackBuffer);
+        }
+        if (result != VK_SUCCESS) {
+            Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Readback Resources!\n");
+            return result;
+        }
+    }
+
+    context.ResetCommandPool(m_ReadbackPool);
+
+    const VkCommandBufferBeginInfo beginInfo = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        nullptr,
+        VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        nullptr
+    };
+    vkBeginCommandBuffer(m_ReadbackCommandBuffer, &beginInfo);
+
+    //The image was left in the present layout by the frame's submission, which precedes this one on the queue.
+    const VkImageMemoryBarrier imageBarrier = VkInit::MakeImageMemoryBarrier(m_Images[index], VK_IMAGE_ASPECT_COLOR_BIT, GetPresentLayout(), GetPresentLayout(), VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+    vkCmdPipelineBarrier(m_ReadbackCommandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+
+    const VkBufferImageCopy region = {
+        0,
+        0,
+        0,
+        { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 },
+        { 0, 0, 0 },
+        { m_Extent.width, m_Extent.height, 1 }
+    };
+    vkCmdCopyImageToBuffer(m_ReadbackCommandBuffer, m_Images[index], GetPresentLayout(), m_ReadbackBuffer.buffer, 1, &region);
+
+    const VkBufferMemoryBarrier bufferBarrier = {
+        VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        nullptr,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_HOST_READ_BIT,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        m_ReadbackBuffer.buffer,
+        0,
+        VK_WHOLE_SIZE
+    };
+    vkCmdPipelineBarrier(m_ReadbackCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+
+    vkEndCommandBuffer(m_ReadbackCommandBuffer);
+
+    const VkSubmitInfo submitInfo = {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        nullptr,
+        0,
+        nullptr,
+        nullptr,
+        1,
+        &m_ReadbackCommandBuffer,
+        0,
+        nullptr
+    };
+    result = vkQueueSubmit(m_Queue, 1, &submitInfo, VK_NULL_HANDLE);
+    if (result == VK_SUCCESS) {
+        result = vkQueueWaitIdle(m_Queue);
+    }
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Readback Headless Image %d!\n", index);
+        return result;
+    }
+
+    context.Invalidate(m_ReadbackBuffer);
+
+    //The images are BGRA. Presented images are opaque, so alpha is forced to 1 rather than copying whatever was cleared or blended into it.
+    const uint8_t* pData = static_cast<const uint8_t*>(m_ReadbackBuffer.pMappedData);
+    pixels.resize(size);
+    for (VkDeviceSize i = 0; i < size; i += 4) {
+        pixels[i + 0] = pData[i + 2];
+        pixels[i + 1] = pData[i + 1];
+        pixels[i + 2] = pData[i + 0];
+        pixels[i + 3] = 255;
+    }
+
+    return VK_SUCCESS;
 }
 
 VkResult VKR::VkSwapchain::CreateSurfaceKHR(const VkInstance& instance, const Window* pWindow)
@@ -125,7 +482,7 @@ void VKR::VkSwapchain::DestroySurfaceKHR(const VkInstance& instance)
     vkDestroySurfaceKHR(instance, m_Surface, nullptr);
 }
 
-VkResult VKR::VkSwapchain::CreateSwapchainKHR(const VkDevice& device, const uint32_t imageCount, const uint32_t width, const uint32_t height, const uint32_t queueFamily)
+VkResult VKR::VkSwapchain::CreateSwapchainKHR(const VkDevice& device, const uint32_t imageCount, const uint32_t width, const uint32_t height, const uint32_t queueFamily, const VkSwapchainKHR oldSwapchain)
 {
     EASY_FUNCTION(profiler::colors::Red500);
     const VkSwapchainCreateInfoKHR createInfo = {  
@@ -146,7 +503,7 @@ VkResult VKR::VkSwapchain::CreateSwapchainKHR(const VkDevice& device, const uint
         VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
         m_SurfacePresentMode,
         VK_TRUE,
-        nullptr
+        oldSwapchain
     };
 
     return vkCreateSwapchainKHR(device, &createInfo, nullptr, &m_Swapchain);
@@ -160,12 +517,26 @@ void VKR::VkSwapchain::DestroySwapchainKHR(const VkDevice& device)
 
 const uint32_t VKR::VkSwapchain::SelectImageCount()
 {
-    const uint32_t imageCount = m_SurfaceCapabilities.minImageCount + 1; //Request an additional image to the minimum to not wait on the GPU. 
+    //By default, request an additional image to the minimum to not wait on the GPU. 
+    const uint32_t imageCount = std::max(m_PresentConfig.imageCount ? m_PresentConfig.imageCount : m_SurfaceCapabilities.minImageCount + 1, m_SurfaceCapabilities.minImageCount);
 
     const bool imageCountExceeded = m_SurfaceCapabilities.maxImageCount && imageCount > m_SurfaceCapabilities.maxImageCount;
     return imageCountExceeded ? m_SurfaceCapabilities.maxImageCount : imageCount;
 }
 
+VkExtent2D VKR::VkSwapchain::SelectExtent() const
+{
+    //The surface dictates the extent, unless it's sized by the swapchain.
+    if (m_SurfaceCapabilities.currentExtent.width != UINT32_MAX) {
+        return m_SurfaceCapabilities.currentExtent;
+    }
+
+    return {
+        std::clamp(m_pWindow->GetWidth(), m_SurfaceCapabilities.minImageExtent.width, m_SurfaceCapabilities.maxImageExtent.width),
+        std::clamp(m_pWindow->GetHeight(), m_SurfaceCapabilities.minImageExtent.height, m_SurfaceCapabilities.maxImageExtent.height)
+    };
+}
+
 VkResult VKR::VkSwapchain::AcquireSwapchainImages(const VkContext& context)
 {
     uint32_t imageCount = 0; 
@@ -181,15 +552,14 @@ VkResult VKR::VkSwapchain::AcquireSwapchainImages(const VkContext& context)
     return VK_SUCCESS;
 }
 
-VkPresentModeKHR VKR::VkSwapchain::SelectPresentMode(const uint64_t numModes, const VkPresentModeKHR* pModes)
+VkPresentModeKHR VKR::VkSwapchain::SelectPresentMode(const VkPresentModeKHR requested)
 {
-    for (uint64_t i = 0; i < numModes; i++) {
-        if (pModes[i] == VK_PRESENT_MODE_MAILBOX_KHR) {
-            return pModes[i];
-        }
+    if (IsPresentModeSupported(requested)) {
+        return requested;
     }
 
-    //Fall back to FIFO
+    //Fall back to FIFO, which every surface supports.
+    Log::Warning("[Vulkan]\tPresent Mode %d is unsupported, falling back to FIFO.\n", requested);
     return VK_PRESENT_MODE_FIFO_KHR;
 }
 
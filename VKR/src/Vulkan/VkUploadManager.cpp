@@ -0,0 +1,422 @@
+#include "../../include/VKR/Vulkan/VkUploadManager.h"
+#include "../../include/VKR/Vulkan/VkContext.h"
+#include "../../include/VKR/Logger.h"
+#include "../../include/VKR/VKR.h"
+#include <easy/profiler.h>
+#include <cstring>
+
+//Satisfies vkCmdCopyBufferToImage's offset requirements for power-of-two sized texels and compressed blocks of up to 16 bytes.
+constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+static inline VkDeviceSize AlignUp(const VkDeviceSize value, const VkDeviceSize alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+VKR::VkUploadManager::VkUploadManager()
+{
+    m_QueueFamilyIndex = 0;
+    m_DstQueueFamilyIndex = 0;
+    m_Queue = VK_NULL_HANDLE;
+    m_CommandPool = VK_NULL_HANDLE;
+
+    m_Staging = {};
+    m_pStagingData = nullptr;
+    m_StagingSize = 0;
+    m_StagingHead = 0;
+    m_StagingTail = 0;
+
+    m_Semaphore = VK_NULL_HANDLE;
+    m_NextToken = 1;
+    m_AcquiredToken = 0;
+
+    m_Current = { VK_NULL_HANDLE, 0, {}, 0 };
+
+    m_PendingStageMask = 0;
+    m_SubmittedStageMask = 0;
+}
+
+VkResult VKR::VkUploadManager::Create(const VkContext& context, const uint32_t queueFamilyIndex, const VkQueue queue, const uint32_t dstQueueFamilyIndex, const VkDeviceSize stagingSize)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    m_QueueFamilyIndex = queueFamilyIndex;
+    m_DstQueueFamilyIndex = dstQueueFamilyIndex;
+    m_Queue = queue;
+
+    VkResult result = context.CreateCommandPool(m_QueueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, &m_CommandPool);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Upload Command Pool!\n");
+        return result;
+    }
+
+    result = context.CreateTimelineSemaphore(0, &m_Semaphore);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Upload Timeline Semaphore!\n");
+        return result;
+    }
+
+    //Round the capacity up, so that aligned virtual offsets remain aligned once wrapped.
+    m_StagingSize = AlignUp(stagingSize, STAGING_ALIGNMENT);
+    result = context.CreateBuffer(m_StagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_HOST, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT, &m_Staging);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Upload Staging Ring!\n");
+        return result;
+    }
+    m_pStagingData = static_cast<uint8_t*>(m_Staging.pMappedData);
+    m_StagingHead = 0;
+    m_StagingTail = 0;
+
+    m_NextToken = 1;
+    m_AcquiredToken = 0;
+
+    Log::Debug("[Vulkan]\tCreated Upload Manager on Queue Family %d%s, with a %llu byte Staging Ring.\n", m_QueueFamilyIndex, (m_QueueFamilyIndex != m_DstQueueFamilyIndex) ? " (Dedicated)" : "", static_cast<unsigned long long>(m_StagingSize));
+
+    return VK_SUCCESS;
+}
+
+void VKR::VkUploadManager::Destroy(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+
+    //Wait for everything in flight to complete before releasing it.
+    if (m_NextToken > 1) {
+        context.WaitSemaphore(m_Semaphore, m_NextToken - 1);
+    }
+    Collect(context);
+
+    for (auto& staging : m_Current.overflow) {
+        context.DestroyBuffer(staging);
+    }
+    m_Current = { VK_NULL_HANDLE, 0, {}, 0 };
+
+    if (m_Staging.buffer != VK_NULL_HANDLE) {
+        context.DestroyBuffer(m_Staging);
+    }
+    m_pStagingData = nullptr;
+
+    if (m_Semaphore != VK_NULL_HANDLE) {
+        context.DestroySemaphore(m_Semaphore);
+    }
+    if (m_CommandPool != VK_NULL_HANDLE) {
+        context.DestroyCommandPool(m_CommandPool);
+    }
+}
+
+VkResult VKR::VkUploadManager::UploadBuffer(const VkContext& context, const VkBuffer dst, const VkDeviceSize dstOffset, const void* pData, const VkDeviceSize size, const VkPipelineStageFlags dstStageMask, const VkAccessFlags dstAccessMask)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    VkResult result = BeginBatch(context);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceSize stagingOffset = 0;
+    result = Stage(context, pData, size, &staging, &stagingOffset);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    const VkBufferCopy region = {
+        stagingOffset,
+        dstOffset,
+        size
+    };
+    vkCmdCopyBuffer(m_Current.cmd, staging, dst, 1, &region);
+
+    m_PendingStageMask |= dstStageMask;
+
+    //Release ownership to the consuming Queue Family.
+    if (m_QueueFamilyIndex != m_DstQueueFamilyIndex) {
+        VkBufferMemoryBarrier barrier = {
+            VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            nullptr,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            0,
+            m_QueueFamilyIndex,
+            m_DstQueueFamilyIndex,
+            dst,
+            dstOffset,
+            size
+        };
+        vkCmdPipelineBarrier(m_Current.cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = dstAccessMask;
+        m_PendingBufferBarriers.push_back(barrier);
+    }
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkUploadManager::UploadImage(const VkContext& context, const VkImage dst, const VkExtent3D extents, const VkImageAspectFlags aspect, const VkImageLayout finalLayout, const void* pData, const VkDeviceSize size, const VkPipelineStageFlags dstStageMask, const VkAccessFlags dstAccessMask)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    VkResult result = BeginBatch(context);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkBuffer staging = VK_NULL_HANDLE;
+    VkDeviceSize stagingOffset = 0;
+    result = Stage(context, pData, size, &staging, &stagingOffset);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    const VkImageSubresourceRange subresourceRange = { aspect, 0, 1, 0, 1 };
+
+    //Transition the image for the copy.
+    VkImageMemoryBarrier barrier = {
+        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        nullptr,
+        0,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        dst,
+        subresourceRange
+    };
+    vkCmdPipelineBarrier(m_Current.cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    const VkBufferImageCopy region = {
+        stagingOffset,
+        0,
+        0,
+        { aspect, 0, 0, 1 },
+        { 0, 0, 0 },
+        extents
+    };
+    vkCmdCopyBufferToImage(m_Current.cmd, staging, dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    m_PendingStageMask |= dstStageMask;
+
+    //Transition to the final layout. If ownership is transferred, this is the release half of the transfer.
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = finalLayout;
+
+    if (m_QueueFamilyIndex != m_DstQueueFamilyIndex) {
+        barrier.dstAccessMask = 0;
+        barrier.srcQueueFamilyIndex = m_QueueFamilyIndex;
+        barrier.dstQueueFamilyIndex = m_DstQueueFamilyIndex;
+        vkCmdPipelineBarrier(m_Current.cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = dstAccessMask;
+        m_PendingImageBarriers.push_back(barrier);
+    }
+    else {
+        //Visibility to consumers is provided by the semaphore wait.
+        barrier.dstAccessMask = 0;
+        vkCmdPipelineBarrier(m_Current.cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    return VK_SUCCESS;
+}
+
+VkResult VKR::VkUploadManager::Submit(const VkContext& context, uint64_t* pToken)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (m_Current.cmd == VK_NULL_HANDLE) {
+        //Nothing was recorded; the most recent batch's token covers everything submitted so far.
+        if (pToken != nullptr) {
+            *pToken = m_NextToken - 1;
+        }
+        return VK_SUCCESS;
+    }
+
+    VkResult result = vkEndCommandBuffer(m_Current.cmd);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to End Upload Command Buffer!\n");
+        return result;
+    }
+
+    m_Current.token = m_NextToken;
+    m_Current.stagingEnd = m_StagingHead;
+
+    const VkTimelineSemaphoreSubmitInfo timelineInfo = {
+        VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        nullptr,
+        0,
+        nullptr,
+        1,
+        &m_Current.token
+    };
+
+    const VkSubmitInfo submitInfo = {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        &timelineInfo,
+        0,
+        nullptr,
+        nullptr,
+        1,
+        &m_Current.cmd,
+        1,
+        &m_Semaphore
+    };
+
+    result = vkQueueSubmit(m_Queue, 1, &submitInfo, VK_NULL_HANDLE);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Submit Upload Batch!\n");
+        return result;
+    }
+
+    m_NextToken++;
+    m_InFlight.push_back(std::move(m_Current));
+    m_Current = { VK_NULL_HANDLE, 0, {}, 0 };
+
+    //The acquire halves may now be recorded by the consumer.
+    m_SubmittedBufferBarriers.insert(m_SubmittedBufferBarriers.end(), m_PendingBufferBarriers.begin(), m_PendingBufferBarriers.end());
+    m_SubmittedImageBarriers.insert(m_SubmittedImageBarriers.end(), m_PendingImageBarriers.begin(), m_PendingImageBarriers.end());
+    m_SubmittedStageMask |= m_PendingStageMask;
+    m_PendingBufferBarriers.clear();
+    m_PendingImageBarriers.clear();
+    m_PendingStageMask = 0;
+
+    if (pToken != nullptr) {
+        *pToken = m_InFlight.back().token;
+    }
+
+    return VK_SUCCESS;
+}
+
+uint64_t VKR::VkUploadManager::AcquireUploads(VkCommandBuffer cmd, VkPipelineStageFlags* pWaitStageMask)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    const uint64_t latest = m_NextToken - 1;
+    if (latest == m_AcquiredToken) {
+        *pWaitStageMask = 0;
+        return 0;
+    }
+
+    //A stage mask can't be empty, so uploads with no consumer stages are waited on before anything runs.
+    const VkPipelineStageFlags waitStageMask = m_SubmittedStageMask != 0 ? m_SubmittedStageMask : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+    if (!m_SubmittedBufferBarriers.empty() || !m_SubmittedImageBarriers.empty()) {
+        vkCmdPipelineBarrier(cmd, waitStageMask, waitStageMask, 0, 0, nullptr,
+            static_cast<uint32_t>(m_SubmittedBufferBarriers.size()), m_SubmittedBufferBarriers.data(),
+            static_cast<uint32_t>(m_SubmittedImageBarriers.size()), m_SubmittedImageBarriers.data());
+
+        m_SubmittedBufferBarriers.clear();
+        m_SubmittedImageBarriers.clear();
+    }
+
+    *pWaitStageMask = waitStageMask;
+    m_SubmittedStageMask = 0;
+
+    m_AcquiredToken = latest;
+    return latest;
+}
+
+bool VKR::VkUploadManager::IsComplete(const VkContext& context, const uint64_t token) const
+{
+    uint64_t value = 0;
+    context.GetSemaphoreCounterValue(m_Semaphore, &value);
+    return value >= token;
+}
+
+VkResult VKR::VkUploadManager::Wait(const VkContext& context, const uint64_t token, const uint64_t timeout) const
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    return context.WaitSemaphore(m_Semaphore, token, timeout);
+}
+
+void VKR::VkUploadManager::Collect(const VkContext& context)
+{
+    EASY_FUNCTION(profiler::colors::Red500);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    uint64_t value = 0;
+    context.GetSemaphoreCounterValue(m_Semaphore, &value);
+
+    //Batches complete in submission order.
+    size_t numComplete = 0;
+    for (; numComplete < m_InFlight.size() && m_InFlight[numComplete].token <= value; numComplete++) {
+        Batch& batch = m_InFlight[numComplete];
+        for (auto& staging : batch.overflow) {
+            context.DestroyBuffer(staging);
+        }
+        m_StagingTail = batch.stagingEnd;
+        context.FreeCommandBuffers(m_CommandPool, 1, &batch.cmd);
+    }
+
+    m_InFlight.erase(m_InFlight.begin(), m_InFlight.begin() + numComplete);
+}
+
+const VkSemaphore& VKR::VkUploadManager::GetSemaphore() const
+{
+    return m_Semaphore;
+}
+
+const uint32_t VKR::VkUploadManager::GetQueueFamilyIndex() const
+{
+    return m_QueueFamilyIndex;
+}
+
+VkResult VKR::VkUploadManager::BeginBatch(const VkContext& context)
+{
+    if (m_Current.cmd != VK_NULL_HANDLE) {
+        return VK_SUCCESS;
+    }
+
+    VkResult result = context.AllocateCommandBuffers(m_CommandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1, &m_Current.cmd);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Allocate Upload Command Buffer!\n");
+        return result;
+    }
+
+    const VkCommandBufferBeginInfo beginInfo = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        nullptr,
+        VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        nullptr
+    };
+
+    return vkBeginCommandBuffer(m_Current.cmd, &beginInfo);
+}
+
+VkResult VKR::VkUploadManager::Stage(const VkContext& context, const void* pData, const VkDeviceSize size, VkBuffer* pBuffer, VkDeviceSize* pOffset)
+{
+    VkDeviceSize offset = AlignUp(m_StagingHead, STAGING_ALIGNMENT);
+
+    //Copies must be contiguous, so skip to the start of the ring if this one would straddle the end.
+    if ((offset % m_StagingSize) + size > m_StagingSize) {
+        offset = ((offset / m_StagingSize) + 1) * m_StagingSize;
+    }
+
+    if (size <= m_StagingSize && (offset + size) - m_StagingTail <= m_StagingSize) {
+        m_StagingHead = offset + size;
+
+        *pBuffer = m_Staging.buffer;
+        *pOffset = offset % m_StagingSize;
+        memcpy(m_pStagingData + *pOffset, pData, size);
+        return context.Flush(m_Staging, *pOffset, size);
+    }
+
+    //The ring is too small, or still in use by batches in flight, so stage through a dedicated buffer instead.
+    Log::Debug("[Vulkan]\tUpload Staging Ring is full. Staging %llu bytes through a dedicated buffer.\n", static_cast<unsigned long long>(size));
+
+    VkBufferResource staging = {};
+    VkResult result = context.CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_AUTO_PREFER_HOST, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT, &staging);
+    if (result != VK_SUCCESS) {
+        Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[Vulkan]\tFailed to Create Staging Buffer!\n");
+        return result;
+    }
+    m_Current.overflow.push_back(staging);
+
+    *pBuffer = staging.buffer;
+    *pOffset = 0;
+    memcpy(staging.pMappedData, pData, size);
+    return context.Flush(staging);
+}
@@ -2,7 +2,7 @@
 #include "../include/VKR/Logger.h"
 #include <easy/profiler.h>
 
-VKR::Status VKR::Window::Create(const char* title, const uint32_t width, const uint32_t height)
+VKR::Status VKR::Window::Create(const char* title, const uint32_t width, const uint32_t height, const bool resizable)
 {
     EASY_FUNCTION(profiler::colors::Green500);
 
@@ -12,13 +12,25 @@ VKR::Status VKR::Window::Create(const char* title, const uint32_t width, const u
     m_Title = title;
 
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-    glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_RESIZABLE, resizable ? GLFW_TRUE : GLFW_FALSE);
     m_Handle = glfwCreateWindow(width, height, title, nullptr, nullptr);
 
     if (m_Handle == nullptr) {
         Log::Error(__FILE__, __LINE__, __PRETTY_FUNCTION__, "[VKR]\tFailed to create GLFW Window! Was glfwInit() called?\n");
         return FAILED;
     }
+
+    //Track the framebuffer's size, which the swapchain's extent must match. 
+    //The framebuffer may be larger than the requested size on high DPI displays. 
+    {
+        int framebufferWidth = 0;
+        int framebufferHeight = 0;
+        glfwGetFramebufferSize(m_Handle, &framebufferWidth, &framebufferHeight);
+        m_Width = static_cast<uint32_t>(framebufferWidth);
+        m_Height = static_cast<uint32_t>(framebufferHeight);
+    }
+    glfwSetWindowUserPointer(m_Handle, this);
+    glfwSetFramebufferSizeCallback(m_Handle, FramebufferSizeCallback);
     Log::Debug("[VKR]\tInternal Window Handle: %08x\n", m_Handle);
 
     return SUCCESS; 
@@ -68,6 +80,11 @@ void VKR::Window::SetTitle(const char* title)
     glfwSetWindowTitle(m_Handle, title); 
 }
 
+const bool VKR::Window::IsMinimized() const
+{
+    return m_Width == 0 || m_Height == 0;
+}
+
 GLFWwindow* VKR::Window::GLFWHandle() const
 {
     return m_Handle;
@@ -82,4 +99,17 @@ const bool VKR::Window::PollEvents() const
     }
 
     return false;
-}
\ No newline at end of file
+}
+
+void VKR::Window::WaitEvents() const
+{
+    EASY_FUNCTION(profiler::colors::Green500);
+    glfwWaitEvents();
+}
+
+void VKR::Window::FramebufferSizeCallback(GLFWwindow* pWindow, int width, int height)
+{
+    Window* pThis = static_cast<Window*>(glfwGetWindowUserPointer(pWindow));
+    pThis->m_Width = static_cast<uint32_t>(width);
+    pThis->m_Height = static_cast<uint32_t>(height);
+}